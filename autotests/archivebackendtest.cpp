@@ -0,0 +1,174 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "loadoptions.h"
+#include "loadstatistics.h"
+#include "pass.h"
+#include "testpasses.h"
+
+#include <QFile>
+#include <QImage>
+#include <QTest>
+#include <QtEndian>
+
+using namespace Qt::Literals;
+
+class ArchiveBackendTest : public QObject
+{
+    Q_OBJECT
+private:
+    static KPkPass::LoadOptions loadOptions(bool builtin)
+    {
+        KPkPass::LoadOptions opts;
+        opts.setArchiveBackend(builtin ? KPkPass::LoadOptions::BuiltinBackend : KPkPass::LoadOptions::KArchiveBackend);
+        return opts;
+    }
+
+    static QByteArray readFile(const QString &fileName)
+    {
+        QFile f(fileName);
+        return f.open(QFile::ReadOnly) ? f.readAll() : QByteArray();
+    }
+
+    static void accessPass(KPkPass::Pass *pass)
+    {
+        pass->setLanguage(u"de"_s);
+        (void)pass->description();
+        (void)pass->fields();
+        (void)pass->logo();
+    }
+
+private Q_SLOTS:
+    void testDefaults()
+    {
+        QCOMPARE(KPkPass::LoadOptions().archiveBackend(), KPkPass::LoadOptions::BuiltinBackend);
+    }
+
+    void testEquivalence_data()
+    {
+        QTest::addColumn<QString>("fileName");
+        QTest::newRow("boardingpass-v1") << u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s;
+        QTest::newRow("boardingpass-v2") << u"" SOURCE_DIR "/data/boardingpass-v2.pkpass"_s;
+        QTest::newRow("apple-store") << u"" SOURCE_DIR "/data/apple-store-UA-sample-unsigned-scrubbed.pkpass"_s;
+    }
+
+    void testEquivalence()
+    {
+        QFETCH(QString, fileName);
+
+        auto error = KPkPass::LoadOptions::InvalidArchive;
+        std::unique_ptr<KPkPass::Pass> builtin(KPkPass::Pass::fromFile(fileName, loadOptions(true), &error));
+        QVERIFY(builtin);
+        QCOMPARE(error, KPkPass::LoadOptions::NoError);
+        std::unique_ptr<KPkPass::Pass> karchive(KPkPass::Pass::fromFile(fileName, loadOptions(false), &error));
+        QVERIFY(karchive);
+        QCOMPARE(error, KPkPass::LoadOptions::NoError);
+
+        QCOMPARE(builtin->type(), karchive->type());
+        QCOMPARE(builtin->serialNumber(), karchive->serialNumber());
+        QCOMPARE(builtin->languages(), karchive->languages());
+        for (const auto &lang : builtin->languages()) {
+            builtin->setLanguage(lang);
+            karchive->setLanguage(lang);
+            QCOMPARE(builtin->description(), karchive->description());
+            QCOMPARE(builtin->fields().size(), karchive->fields().size());
+        }
+        QCOMPARE(builtin->hasLogo(), karchive->hasLogo());
+        QCOMPARE(builtin->hasIcon(), karchive->hasIcon());
+        QCOMPARE(builtin->logo(2), karchive->logo(2));
+        QCOMPARE(builtin->icon(), karchive->icon());
+        QCOMPARE(builtin->rawData(), karchive->rawData());
+
+        const auto builtinStats = builtin->loadStatistics();
+        const auto karchiveStats = karchive->loadStatistics();
+        QCOMPARE(builtinStats.inflatedSize(), karchiveStats.inflatedSize());
+        QCOMPARE(builtinStats.catalogEntryCount(), karchiveStats.catalogEntryCount());
+    }
+
+    void testLimits_data()
+    {
+        QTest::addColumn<bool>("builtin");
+        QTest::newRow("builtin") << true;
+        QTest::newRow("karchive") << false;
+    }
+
+    void testLimits()
+    {
+        QFETCH(bool, builtin);
+
+        auto obj = TestPasses::genericPass(u"123"_s);
+        obj.insert("description"_L1, QString(2 * 1024 * 1024, u' '));
+        const auto data = TestPasses::makePass(obj);
+
+        auto opts = loadOptions(builtin);
+        opts.setMaximumEntrySize(1024 * 1024);
+        auto error = KPkPass::LoadOptions::NoError;
+        QVERIFY(!KPkPass::Pass::fromData(data, opts, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::ResourceLimitExceeded);
+
+        opts.setMaximumEntrySize(0);
+        opts.setMaximumTotalSize(1024 * 1024);
+        QVERIFY(!KPkPass::Pass::fromData(data, opts, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::ResourceLimitExceeded);
+
+        QVERIFY(!KPkPass::Pass::fromData("not a zip file", opts, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::InvalidArchive);
+    }
+
+    void testCorruptEntry()
+    {
+        auto data = TestPasses::makePass(TestPasses::genericPass(u"123"_s));
+        QVERIFY(data.startsWith("PK\x03\x04"));
+        // damage the compressed data of the first entry, which is pass.json
+        const auto offset = 30 + qFromLittleEndian<quint16>(data.constData() + 26) + qFromLittleEndian<quint16>(data.constData() + 28);
+        QVERIFY(offset + 8 < data.size());
+        data[offset + 4] ^= 0x55;
+        data[offset + 5] ^= 0x55;
+
+        auto error = KPkPass::LoadOptions::NoError;
+        QVERIFY(!KPkPass::Pass::fromData(data, loadOptions(true), &error));
+        QCOMPARE(error, KPkPass::LoadOptions::InvalidArchive);
+    }
+
+    void testImplausibleSize()
+    {
+        auto data = TestPasses::makePass(TestPasses::genericPass(u"123"_s));
+        // claim a huge decompressed size for pass.json in the central directory
+        const auto idx = data.indexOf("PK\x01\x02");
+        QVERIFY(idx > 0);
+        qToLittleEndian<quint32>(0x7fffffff, data.data() + idx + 24);
+
+        KPkPass::LoadOptions opts = loadOptions(true);
+        opts.setMaximumEntrySize(0);
+        opts.setMaximumTotalSize(0);
+        auto error = KPkPass::LoadOptions::NoError;
+        QVERIFY(!KPkPass::Pass::fromData(data, opts, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::InvalidArchive);
+    }
+
+    void benchmarkLoad_data()
+    {
+        QTest::addColumn<bool>("builtin");
+        QTest::newRow("builtin") << true;
+        QTest::newRow("karchive") << false;
+    }
+
+    void benchmarkLoad()
+    {
+        QFETCH(bool, builtin);
+        const auto data = readFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s);
+        QVERIFY(!data.isEmpty());
+        const auto opts = loadOptions(builtin);
+        QBENCHMARK {
+            std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data, opts));
+            accessPass(pass.get());
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(ArchiveBackendTest)
+
+#include "archivebackendtest.moc"
@@ -0,0 +1,95 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "fieldmodel.h"
+
+#include <QAbstractItemModelTester>
+#include <QLocale>
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace Qt::Literals;
+
+class FieldModelTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QVariant data(const FieldModel &model, int row, int role)
+    {
+        return model.data(model.index(row, 0), role);
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QLocale::setDefault(QLocale(u"en_US"_s));
+    }
+
+    void testModel()
+    {
+        auto pass = KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s);
+        QVERIFY(pass);
+
+        FieldModel model;
+        QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+        QCOMPARE(model.rowCount(), 0);
+        QSignalSpy resetSpy(&model, &QAbstractItemModel::modelReset);
+        QSignalSpy passSpy(&model, &FieldModel::passChanged);
+
+        model.setSection(FieldModel::HeaderFields);
+        model.setPass(pass);
+        QCOMPARE(passSpy.size(), 1);
+        QCOMPARE(model.rowCount(), 2);
+
+        // rows are materialized independently, in any order
+        QCOMPARE(data(model, 1, FieldModel::LabelRole).toString(), "Gate"_L1);
+        QCOMPARE(data(model, 0, FieldModel::KeyRole).toString(), "seat"_L1);
+        QCOMPARE(data(model, 0, FieldModel::LabelRole).toString(), "Seat"_L1);
+        QCOMPARE(data(model, 0, FieldModel::ValueDisplayStringRole).toString(), "10E"_L1);
+        QCOMPARE(data(model, 0, Qt::DisplayRole).toString(), "10E"_L1);
+        QCOMPARE(data(model, 0, FieldModel::RowRole).toInt(), pass->headerFields().at(0).row());
+        QCOMPARE(data(model, 0, FieldModel::TextAlignmentRole).value<Qt::Alignment>(), pass->headerFields().at(0).textAlignment());
+        QCOMPARE(data(model, 0, FieldModel::FieldRole).value<KPkPass::Field>().key(), "seat"_L1);
+        QVERIFY(model.roleNames().values().contains("valueDisplayString"));
+
+        // section switching
+        resetSpy.clear();
+        model.setSection(FieldModel::AuxiliaryFields);
+        QCOMPARE(resetSpy.size(), 1);
+        QCOMPARE(model.rowCount(), 4);
+        QCOMPARE(data(model, 3, FieldModel::KeyRole).toString(), "bookingClass"_L1);
+        model.setSection(FieldModel::AllFields);
+        QCOMPARE(model.rowCount(), pass->fields().size());
+        model.setSection(FieldModel::HeaderFields);
+        QCOMPARE(data(model, 0, FieldModel::LabelRole).toString(), "Seat"_L1);
+
+        // language changes of the pass invalidate cached display data
+        resetSpy.clear();
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(resetSpy.size(), 1);
+        QCOMPARE(data(model, 0, FieldModel::LabelRole).toString(), "Sitzplatz"_L1);
+
+        // default language changes need an explicit reset
+        pass->setLanguage({});
+        QCOMPARE(data(model, 0, FieldModel::LabelRole).toString(), "Seat"_L1);
+        KPkPass::Pass::setDefaultLanguage(u"de"_s);
+        QCOMPARE(data(model, 0, FieldModel::LabelRole).toString(), "Seat"_L1);
+        model.reset();
+        QCOMPARE(data(model, 0, FieldModel::LabelRole).toString(), "Sitzplatz"_L1);
+        KPkPass::Pass::setDefaultLanguage({});
+
+        // deleting the pass empties the model
+        passSpy.clear();
+        delete pass;
+        QCOMPARE(passSpy.size(), 1);
+        QCOMPARE(model.rowCount(), 0);
+        QVERIFY(!model.pass());
+    }
+};
+
+QTEST_GUILESS_MAIN(FieldModelTest)
+
+#include "fieldmodeltest.moc"
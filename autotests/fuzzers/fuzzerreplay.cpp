@@ -0,0 +1,76 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+// Minimal replacement for the libFuzzer driver, feeding the given files
+// (or all files in the given directories) to the fuzz target once.
+// This allows to run stored inputs as a regular test without Clang/libFuzzer.
+// Supports libFuzzer's -timeout=<seconds> option, other options are ignored.
+
+#include <QByteArray>
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+extern "C" int LLVMFuzzerInitialize(int *argc, char ***argv);
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+int main(int argc, char **argv)
+{
+    qint64 timeout = 0;
+    QStringList inputs;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strncmp(argv[i], "-timeout=", 9) == 0) {
+            timeout = QByteArray(argv[i] + 9).toLongLong() * 1000;
+        } else if (argv[i][0] != '-') {
+            inputs.push_back(QFile::decodeName(argv[i]));
+        }
+    }
+
+    QStringList files;
+    for (const auto &input : inputs) {
+        if (QFileInfo(input).isDir()) {
+            QDirIterator it(input, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) {
+                files.push_back(it.next());
+            }
+        } else {
+            files.push_back(input);
+        }
+    }
+
+    LLVMFuzzerInitialize(&argc, &argv);
+
+    int failures = 0;
+    for (const auto &fileName : files) {
+        QFile f(fileName);
+        if (!f.open(QFile::ReadOnly)) {
+            std::fprintf(stderr, "Failed to open %s: %s\n", qPrintable(fileName), qPrintable(f.errorString()));
+            ++failures;
+            continue;
+        }
+        const auto data = f.readAll();
+
+        QElapsedTimer timer;
+        timer.start();
+        LLVMFuzzerTestOneInput(reinterpret_cast<const uint8_t *>(data.constData()), static_cast<size_t>(data.size()));
+        const auto elapsed = timer.elapsed();
+        if (timeout > 0 && elapsed > timeout) {
+            std::fprintf(stderr, "Timeout for %s: %lldms\n", qPrintable(fileName), elapsed);
+            ++failures;
+        }
+    }
+
+    std::printf("Replayed %lld inputs, %d failed\n", static_cast<long long>(files.size()), failures);
+    return failures ? 1 : 0;
+}
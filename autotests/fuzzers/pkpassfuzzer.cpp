@@ -0,0 +1,84 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "barcode.h"
+#include "location.h"
+#include "pass.h"
+#include "passes.h"
+#include "passstyle.h"
+#include "seat.h"
+
+#include <QByteArray>
+#include <QLoggingCategory>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// exercise everything computed from pass.json and the translation catalogs,
+// but not image decoding, that's out of our hands
+static void processPass(KPkPass::Pass *pass)
+{
+    if (!pass) {
+        return;
+    }
+
+    const auto languages = pass->languages();
+    for (const auto &lang : languages) {
+        pass->setLanguage(lang);
+        (void)pass->description();
+        (void)pass->logoText();
+    }
+
+    for (const auto &field : pass->fields()) {
+        (void)field.label();
+        (void)field.value();
+        (void)field.valueDisplayString();
+        (void)field.changeMessage();
+    }
+    for (const auto &barcode : pass->barcodes()) {
+        (void)barcode.message();
+        (void)barcode.alternativeText();
+    }
+    for (const auto &location : pass->locations()) {
+        (void)location.relevantText();
+    }
+    for (const auto &seat : pass->seats()) {
+        (void)seat.asAirplaneSeat();
+    }
+
+    const auto style = pass->style();
+    (void)style.labelColor();
+    (void)pass->relevantDate();
+    (void)pass->expirationDate();
+    (void)pass->semanticTags();
+}
+
+extern "C" int LLVMFuzzerInitialize(int *, char ***)
+{
+    // warnings about broken input are expected and would only slow us down
+    QLoggingCategory::setFilterRules(QStringLiteral("org.kde.pkpass=false"));
+    return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    const auto input = QByteArray::fromRawData(reinterpret_cast<const char *>(data), static_cast<qsizetype>(size));
+
+    std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(input));
+    processPass(pass.get());
+
+    std::unique_ptr<KPkPass::Passes> passes(KPkPass::Passes::fromData(input));
+    if (passes) {
+        const auto entries = passes->entries();
+        for (const auto &entry : entries) {
+            std::unique_ptr<KPkPass::Pass> p(KPkPass::Pass::fromData(passes->passData(entry)));
+            processPass(p.get());
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "loadoptions.h"
+#include "pass.h"
+#include "testpasses.h"
+
+#include <QBuffer>
+#include <QImage>
+#include <QTest>
+
+using namespace Qt::Literals;
+
+class LoadOptionsTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QByteArray png(int width, int height)
+    {
+        QImage img(width, height, QImage::Format_RGB32);
+        img.fill(Qt::red);
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        img.save(&buffer, "PNG");
+        return data;
+    }
+
+private Q_SLOTS:
+    void testDefaults()
+    {
+        KPkPass::LoadOptions opts;
+        QVERIFY(opts.maximumEntrySize() > 0);
+        QVERIFY(opts.maximumTotalSize() >= opts.maximumEntrySize());
+        QVERIFY(opts.maximumEntryCount() > 0);
+        QVERIFY(opts.maximumCatalogSize() > 0);
+        QVERIFY(opts.maximumImagePixels() > 0);
+
+        auto error = KPkPass::LoadOptions::InvalidArchive;
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s, opts, &error));
+        QVERIFY(pass);
+        QCOMPARE(error, KPkPass::LoadOptions::NoError);
+        QVERIFY(!pass->logo().isNull());
+    }
+
+    void testErrors()
+    {
+        KPkPass::LoadOptions::Error error = KPkPass::LoadOptions::NoError;
+        QVERIFY(!KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/does-not-exist.pkpass"_s, {}, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::FileError);
+        QVERIFY(!KPkPass::Pass::fromData("not a zip file", {}, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::InvalidArchive);
+
+        auto obj = TestPasses::genericPass(u"123"_s);
+        obj.insert("formatVersion"_L1, 2);
+        QVERIFY(!KPkPass::Pass::fromData(TestPasses::makePass(obj), {}, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::UnsupportedPass);
+    }
+
+    void testEntrySize()
+    {
+        // highly compressible, like a zip bomb
+        auto obj = TestPasses::genericPass(u"123"_s);
+        obj.insert("description"_L1, QString(2 * 1024 * 1024, u' '));
+        const auto data = TestPasses::makePass(obj);
+        QVERIFY(data.size() < 100 * 1024);
+
+        KPkPass::LoadOptions opts;
+        opts.setMaximumEntrySize(1024 * 1024);
+        KPkPass::LoadOptions::Error error = KPkPass::LoadOptions::NoError;
+        QVERIFY(!KPkPass::Pass::fromData(data, opts, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::ResourceLimitExceeded);
+
+        opts.setMaximumEntrySize(0);
+        opts.setMaximumTotalSize(1024 * 1024);
+        QVERIFY(!KPkPass::Pass::fromData(data, opts, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::ResourceLimitExceeded);
+
+        opts.setMaximumTotalSize(0);
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data, opts, &error));
+        QVERIFY(pass);
+        QCOMPARE(error, KPkPass::LoadOptions::NoError);
+    }
+
+    void testEntryCount()
+    {
+        QHash<QString, QByteArray> files;
+        for (int i = 0; i < 20; ++i) {
+            files.insert(u"file%1.txt"_s.arg(i), "data");
+        }
+        const auto data = TestPasses::makePass(TestPasses::genericPass(u"123"_s), files);
+
+        KPkPass::LoadOptions opts;
+        opts.setMaximumEntryCount(10);
+        KPkPass::LoadOptions::Error error = KPkPass::LoadOptions::NoError;
+        QVERIFY(!KPkPass::Pass::fromData(data, opts, &error));
+        QCOMPARE(error, KPkPass::LoadOptions::ResourceLimitExceeded);
+
+        opts.setMaximumEntryCount(21);
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data, opts, &error));
+        QVERIFY(pass);
+    }
+
+    void testLazyLimits()
+    {
+        auto obj = TestPasses::genericPass(u"123"_s);
+        obj.insert("description"_L1, u"desc"_s);
+        auto catalog = QByteArray("\"desc\" = \"Beschreibung\";\n");
+        catalog.append(QByteArray(4096, '\n'));
+        const auto data = TestPasses::makePass(obj, {{u"de.lproj/pass.strings"_s, catalog}, {u"logo.png"_s, png(2000, 1000)}});
+
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data));
+        QVERIFY(pass);
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(pass->description(), "Beschreibung"_L1);
+        QCOMPARE(pass->logo().size(), QSize(2000, 1000));
+
+        // limits for lazily loaded content don't fail loading, but that content is then unavailable
+        KPkPass::LoadOptions opts;
+        opts.setMaximumCatalogSize(1024);
+        opts.setMaximumImagePixels(1000 * 1000);
+        KPkPass::LoadOptions::Error error = KPkPass::LoadOptions::InvalidArchive;
+        pass.reset(KPkPass::Pass::fromData(data, opts, &error));
+        QVERIFY(pass);
+        QCOMPARE(error, KPkPass::LoadOptions::NoError);
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(pass->description(), "desc"_L1);
+        QVERIFY(pass->hasLogo());
+        QVERIFY(pass->logo().isNull());
+    }
+};
+
+QTEST_GUILESS_MAIN(LoadOptionsTest)
+
+#include "loadoptionstest.moc"
@@ -0,0 +1,174 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "loadoptions.h"
+#include "loadstatistics.h"
+#include "pass.h"
+#include "testpasses.h"
+
+#include <KZip>
+
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Qt::Literals;
+
+class LoadStatisticsTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QByteArray makeArchive(const QByteArray &passJson)
+    {
+        QByteArray data;
+        QBuffer buffer(&data);
+        KZip zip(&buffer);
+        if (zip.open(QIODevice::WriteOnly)) {
+            zip.writeFile(u"pass.json"_s, passJson);
+            zip.close();
+        }
+        return data;
+    }
+
+private Q_SLOTS:
+    void testPass()
+    {
+        const auto fileName = u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s;
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(fileName));
+        QVERIFY(pass);
+
+        auto stats = pass->loadStatistics();
+        QCOMPARE(stats.passCount(), qint64(1));
+        QCOMPARE(stats.cachedPassCount(), qint64(0));
+        QCOMPARE(stats.archiveSize(), QFileInfo(fileName).size());
+        QCOMPARE(stats.entryCount(), qint64(6));
+        QVERIFY(stats.passJsonSize() > 0);
+        QCOMPARE(stats.inflatedSize(), stats.passJsonSize());
+        QCOMPARE(stats.jsonRepairCount(), qint64(0));
+        QCOMPARE(stats.catalogCount(), qint64(0));
+        QCOMPARE(stats.imageDecodeCount(), qint64(0));
+        QVERIFY(stats.catalogLanguage().isEmpty());
+
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(pass->description(), "KDE Bordkarte"_L1);
+        QVERIFY(!pass->logo().isNull());
+        QVERIFY(!pass->logo().isNull());
+
+        // snapshots don't change
+        QCOMPARE(stats.catalogCount(), qint64(0));
+
+        stats = pass->loadStatistics();
+        QCOMPARE(stats.catalogLanguage(), "de"_L1);
+        QCOMPARE(stats.catalogCount(), qint64(1));
+        QVERIFY(stats.catalogSize() > 0);
+        QVERIFY(stats.catalogEntryCount() > 0);
+        QCOMPARE(stats.imageDecodeCount(), qint64(1));
+        QCOMPARE(stats.imageCacheHitCount(), qint64(1));
+        QVERIFY(stats.inflatedSize() > stats.passJsonSize() + stats.catalogSize());
+
+        pass->setLanguage(u"en"_s);
+        QCOMPARE(pass->description(), "KDE Boarding pass"_L1);
+        stats = pass->loadStatistics();
+        QCOMPARE(stats.catalogLanguage(), "en"_L1);
+        QCOMPARE(stats.catalogCount(), qint64(2));
+    }
+
+    void testGlobal()
+    {
+        KPkPass::LoadStatistics::resetGlobal();
+        QCOMPARE(KPkPass::LoadStatistics::global().passCount(), qint64(0));
+
+        for (int i = 0; i < 3; ++i) {
+            std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(TestPasses::makePass(TestPasses::genericPass(QString::number(i)))));
+            QVERIFY(pass);
+            QCOMPARE(pass->loadStatistics().passCount(), qint64(1));
+        }
+        QVERIFY(!KPkPass::Pass::fromData("not a pass"));
+
+        const auto stats = KPkPass::LoadStatistics::global();
+        QCOMPARE(stats.passCount(), qint64(3));
+        QVERIFY(stats.passJsonSize() > 0);
+        QVERIFY(stats.archiveSize() > stats.passJsonSize());
+        QVERIFY(stats.catalogLanguage().isEmpty());
+
+        KPkPass::LoadStatistics::resetGlobal();
+        QCOMPARE(KPkPass::LoadStatistics::global().passCount(), qint64(0));
+        QCOMPARE(KPkPass::LoadStatistics::global().archiveSize(), qint64(0));
+    }
+
+    void testRepair()
+    {
+        // trailing comma in an object, fixed by the syntax error workarounds
+        const auto data = makeArchive(R"({"formatVersion": 1, "serialNumber": "1", "generic": {"primaryFields": []},})");
+        QVERIFY(!data.isEmpty());
+
+        KPkPass::LoadStatistics::resetGlobal();
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data));
+        QVERIFY(pass);
+        QCOMPARE(pass->loadStatistics().jsonRepairCount(), qint64(1));
+        QCOMPARE(KPkPass::LoadStatistics::global().jsonRepairCount(), qint64(1));
+
+        // failed repair attempts aren't counted
+        QVERIFY(!KPkPass::Pass::fromData(makeArchive(R"({"formatVersion": 1, "generic": {)")));
+        QCOMPARE(KPkPass::LoadStatistics::global().jsonRepairCount(), qint64(1));
+    }
+
+    void testFailedLoad()
+    {
+        KPkPass::LoadStatistics::resetGlobal();
+        auto error = KPkPass::LoadOptions::NoError;
+        // valid archive and JSON, but not a pass
+        QVERIFY(!KPkPass::Pass::fromData(makeArchive(R"({"formatVersion": 1, "serialNumber": "1"})"), KPkPass::LoadOptions(), &error));
+        QCOMPARE(error, KPkPass::LoadOptions::UnsupportedPass);
+
+        const auto stats = KPkPass::LoadStatistics::global();
+        QCOMPARE(stats.passCount(), qint64(0));
+        QCOMPARE(stats.archiveSize(), qint64(0));
+        QCOMPARE(stats.entryCount(), qint64(0));
+        QCOMPARE(stats.inflatedSize(), qint64(0));
+        QCOMPARE(stats.passJsonSize(), qint64(0));
+
+        // work done after loading succeeded is still counted
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        QVERIFY(pass);
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(pass->description(), "KDE Bordkarte"_L1);
+        QCOMPARE(KPkPass::LoadStatistics::global().passCount(), qint64(1));
+        QCOMPARE(KPkPass::LoadStatistics::global().catalogCount(), qint64(1));
+        QCOMPARE(KPkPass::LoadStatistics::global().inflatedSize(), pass->loadStatistics().inflatedSize());
+    }
+
+    void testCached()
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+        const auto fileName = dir.filePath(u"boardingpass-v1.pkpass"_s);
+        QVERIFY(QFile::copy(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s, fileName));
+        const auto cacheFileName = dir.filePath(u"boardingpass-v1.cache"_s);
+
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFileCached(fileName, cacheFileName));
+        QVERIFY(pass);
+        QCOMPARE(pass->loadStatistics().cachedPassCount(), qint64(0));
+
+        KPkPass::LoadStatistics::resetGlobal();
+        pass.reset(KPkPass::Pass::fromFileCached(fileName, cacheFileName));
+        QVERIFY(pass);
+        const auto stats = pass->loadStatistics();
+        QCOMPARE(stats.passCount(), qint64(1));
+        QCOMPARE(stats.cachedPassCount(), qint64(1));
+        // the archive isn't touched when loading from the cache
+        QCOMPARE(stats.archiveSize(), qint64(0));
+        QCOMPARE(stats.inflatedSize(), qint64(0));
+        QCOMPARE(KPkPass::LoadStatistics::global().cachedPassCount(), qint64(1));
+    }
+};
+
+QTEST_GUILESS_MAIN(LoadStatisticsTest)
+
+#include "loadstatisticstest.moc"
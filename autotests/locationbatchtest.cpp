@@ -0,0 +1,153 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "location.h"
+#include "locationbatch.h"
+
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+static double haversine(double lat1, double lon1, double lat2, double lon2)
+{
+    const auto rad = std::numbers::pi / 180.0;
+    const auto sinDLat = std::sin((lat2 - lat1) * rad / 2.0);
+    const auto sinDLon = std::sin((lon2 - lon1) * rad / 2.0);
+    const auto a = sinDLat * sinDLat + std::cos(lat1 * rad) * std::cos(lat2 * rad) * sinDLon * sinDLon;
+    return 2.0 * 6371000.0 * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+class LocationBatchTest : public QObject
+{
+    Q_OBJECT
+private:
+    static constexpr qsizetype PointCount = 100000;
+    static constexpr double Radius = 20000.0;
+    static constexpr double QueryLat = 52.5251;
+    static constexpr double QueryLon = 13.3694;
+
+    std::vector<double> m_lats;
+    std::vector<double> m_lons;
+    KPkPass::LocationBatch m_batch;
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QRandomGenerator rng(42);
+        for (qsizetype i = 0; i < PointCount; ++i) {
+            m_lats.push_back(QueryLat - 1.0 + rng.bounded(2.0));
+            m_lons.push_back(QueryLon - 1.5 + rng.bounded(3.0));
+        }
+        // odd size, so the scalar tail of the vectorized kernels is exercised as well
+        m_batch.append(m_lats.data(), m_lons.data(), PointCount - 1, Radius);
+        m_batch.append(m_lats.back(), m_lons.back(), Radius);
+        QCOMPARE(m_batch.size(), PointCount);
+    }
+
+    void testKernels_data()
+    {
+        QTest::addColumn<bool>("scalar");
+        QTest::newRow("auto") << false;
+        QTest::newRow("scalar") << true;
+    }
+
+    void testKernels()
+    {
+        QFETCH(bool, scalar);
+        const auto kernel = scalar ? KPkPass::LocationBatch::Scalar : KPkPass::LocationBatch::Auto;
+
+        std::vector<double> dist(PointCount);
+        m_batch.distances(QueryLat, QueryLon, dist.data(), kernel);
+        std::vector<quint8> mask(PointCount);
+        const auto count = m_batch.withinRadius(QueryLat, QueryLon, mask.data(), kernel);
+
+        qsizetype expectedCount = 0;
+        for (qsizetype i = 0; i < PointCount; ++i) {
+            const auto expected = haversine(QueryLat, QueryLon, m_lats[i], m_lons[i]);
+            QVERIFY(std::abs(dist[i] - expected) < 0.01);
+            if (std::abs(expected - Radius) < 0.01) {
+                continue;
+            }
+            QCOMPARE(mask[i] == 1, expected <= Radius);
+            expectedCount += mask[i];
+        }
+        QVERIFY(count > 0);
+        QVERIFY(count < PointCount);
+        QVERIFY(std::abs(count - expectedCount) <= 1);
+    }
+
+    void testLocations()
+    {
+        KPkPass::LocationBatch batch;
+        batch.append(QList<KPkPass::Location>{KPkPass::Location()}, 500.0);
+        QVERIFY(batch.isEmpty());
+
+        batch.append(47.4523, 8.56083, 500.0);
+        batch.append(47.4523, 8.56083 + 180.0, 0.0);
+        batch.append(-47.4523, 8.56083, 1.0e9);
+        std::vector<quint8> mask(batch.size());
+        QCOMPARE(batch.withinRadius(47.4525, 8.5609, mask.data()), 2);
+        QCOMPARE(mask, std::vector<quint8>({1, 0, 1}));
+
+        std::vector<double> dist(batch.size());
+        batch.distances(47.4523, 8.56083, dist.data());
+        QCOMPARE(dist[0], 0.0);
+        QVERIFY(std::abs(dist[1] - haversine(47.4523, 8.56083, 47.4523, 8.56083 + 180.0)) < 0.01);
+
+        batch.clear();
+        QVERIFY(batch.isEmpty());
+    }
+
+    void benchmarkWithinRadius_data()
+    {
+        testKernels_data();
+    }
+
+    void benchmarkWithinRadius()
+    {
+        QFETCH(bool, scalar);
+        const auto kernel = scalar ? KPkPass::LocationBatch::Scalar : KPkPass::LocationBatch::Auto;
+
+        std::vector<quint8> mask(PointCount);
+        qsizetype iterations = 0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            m_batch.withinRadius(QueryLat, QueryLon, mask.data(), kernel);
+            ++iterations;
+        }
+        qInfo() << "radius checks per second:" << (double(PointCount * iterations) * 1.0e9 / double(timer.nsecsElapsed()));
+    }
+
+    void benchmarkDistances_data()
+    {
+        testKernels_data();
+    }
+
+    void benchmarkDistances()
+    {
+        QFETCH(bool, scalar);
+        const auto kernel = scalar ? KPkPass::LocationBatch::Scalar : KPkPass::LocationBatch::Auto;
+
+        std::vector<double> dist(PointCount);
+        qsizetype iterations = 0;
+        QElapsedTimer timer;
+        timer.start();
+        QBENCHMARK {
+            m_batch.distances(QueryLat, QueryLon, dist.data(), kernel);
+            ++iterations;
+        }
+        qInfo() << "distances per second:" << (double(PointCount * iterations) * 1.0e9 / double(timer.nsecsElapsed()));
+    }
+};
+
+QTEST_GUILESS_MAIN(LocationBatchTest)
+
+#include "locationbatchtest.moc"
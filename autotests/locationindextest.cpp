@@ -0,0 +1,187 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "location.h"
+#include "locationindex.h"
+#include "pass.h"
+#include "testpasses.h"
+
+#include <QJsonArray>
+#include <QPointF>
+#include <QRandomGenerator>
+#include <QTest>
+
+#include <cmath>
+#include <numbers>
+
+using namespace Qt::Literals;
+
+static double distance(double lat1, double lon1, double lat2, double lon2)
+{
+    const auto rad = std::numbers::pi / 180.0;
+    const auto sinDLat = std::sin((lat2 - lat1) * rad / 2.0);
+    const auto sinDLon = std::sin((lon2 - lon1) * rad / 2.0);
+    const auto a = sinDLat * sinDLat + std::cos(lat1 * rad) * std::cos(lat2 * rad) * sinDLon * sinDLon;
+    return 2.0 * 6371000.0 * std::asin(std::min(1.0, std::sqrt(a)));
+}
+
+class LocationIndexTest : public QObject
+{
+    Q_OBJECT
+private:
+    // 1000 passes with 100 locations each, spread over roughly the area of Germany
+    static constexpr int PassCount = 1000;
+    static constexpr int LocationsPerPass = 100;
+
+    std::vector<std::unique_ptr<KPkPass::Pass>> m_passes;
+    QList<QPointF> m_queries;
+
+    static std::unique_ptr<KPkPass::Pass> makePass(const QString &serial, const QList<QPointF> &locations, int maxDistance)
+    {
+        auto obj = TestPasses::genericPass(serial);
+        QJsonArray locs;
+        for (const auto &p : locations) {
+            locs.push_back(QJsonObject{{"latitude"_L1, p.y()}, {"longitude"_L1, p.x()}});
+        }
+        obj.insert("locations"_L1, locs);
+        if (maxDistance > 0) {
+            obj.insert("maxDistance"_L1, maxDistance);
+        }
+        return std::unique_ptr<KPkPass::Pass>(KPkPass::Pass::fromData(TestPasses::makePass(obj)));
+    }
+
+    static QPointF randomPoint(QRandomGenerator &rng)
+    {
+        return QPointF(6.0 + rng.bounded(9.0), 47.5 + rng.bounded(7.0));
+    }
+
+    static QList<KPkPass::Pass *> bruteForce(const std::vector<std::unique_ptr<KPkPass::Pass>> &passes, double lat, double lon)
+    {
+        QList<KPkPass::Pass *> result;
+        for (const auto &pass : passes) {
+            const auto locs = pass->locations();
+            for (const auto &loc : locs) {
+                if (distance(lat, lon, loc.latitude(), loc.longitude()) <= pass->maximumDistance()) {
+                    result.push_back(pass.get());
+                    break;
+                }
+            }
+        }
+        return result;
+    }
+
+    static void sort(QList<KPkPass::Pass *> &l)
+    {
+        std::sort(l.begin(), l.end());
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QRandomGenerator rng(42);
+        for (int i = 0; i < PassCount; ++i) {
+            QList<QPointF> locs;
+            for (int j = 0; j < LocationsPerPass; ++j) {
+                locs.push_back(randomPoint(rng));
+            }
+            m_passes.push_back(makePass(QString::number(i), locs, 0));
+            QVERIFY(m_passes.back());
+        }
+        for (int i = 0; i < 100; ++i) {
+            m_queries.push_back(randomPoint(rng));
+        }
+        // make sure there are actual hits
+        for (int i = 0; i < 100; ++i) {
+            const auto loc = m_passes[i]->locations().at(i % LocationsPerPass);
+            m_queries.push_back(QPointF(loc.longitude() + 0.001, loc.latitude() - 0.002));
+        }
+    }
+
+    void testLookup()
+    {
+        KPkPass::LocationIndex index;
+        for (const auto &pass : m_passes) {
+            index.insert(pass.get());
+        }
+        QCOMPARE(index.size(), PassCount * LocationsPerPass);
+
+        int hits = 0;
+        for (const auto &q : m_queries) {
+            auto expected = bruteForce(m_passes, q.y(), q.x());
+            auto result = index.passesNear(q.y(), q.x());
+            sort(expected);
+            sort(result);
+            QCOMPARE(result, expected);
+            hits += result.size();
+        }
+        QVERIFY(hits >= 100);
+    }
+
+    void testWideAndRemove()
+    {
+        std::vector<std::unique_ptr<KPkPass::Pass>> passes;
+        passes.push_back(makePass(u"near"_s, {QPointF(8.56083, 47.4523)}, 0));
+        passes.push_back(makePass(u"wide"_s, {QPointF(8.0, 47.0)}, 100000));
+        passes.push_back(makePass(u"wrap"_s, {QPointF(179.9999, 10.0)}, 0));
+        passes.push_back(makePass(u"pole"_s, {QPointF(0.0, 89.9)}, 0));
+
+        KPkPass::LocationIndex index;
+        for (const auto &pass : passes) {
+            index.insert(pass.get());
+        }
+        QCOMPARE(index.size(), 4);
+
+        auto result = index.passesNear(47.4525, 8.5609);
+        QCOMPARE(result.size(), 2);
+        QVERIFY(result.contains(passes[0].get()));
+        QVERIFY(result.contains(passes[1].get()));
+
+        QCOMPARE(index.passesNear(10.0, -179.9999), QList<KPkPass::Pass *>({passes[2].get()}));
+        QCOMPARE(index.passesNear(89.9, 0.5), QList<KPkPass::Pass *>({passes[3].get()}));
+        QVERIFY(index.passesNear(0.0, 0.0).isEmpty());
+
+        index.remove(passes[1].get());
+        QCOMPARE(index.size(), 3);
+        QCOMPARE(index.passesNear(47.4525, 8.5609), QList<KPkPass::Pass *>({passes[0].get()}));
+        index.remove(passes[0].get());
+        QVERIFY(index.passesNear(47.4525, 8.5609).isEmpty());
+
+        index.insert(passes[0].get());
+        QCOMPARE(index.passesNear(47.4525, 8.5609), QList<KPkPass::Pass *>({passes[0].get()}));
+        index.clear();
+        QCOMPARE(index.size(), 0);
+        QVERIFY(index.passesNear(47.4525, 8.5609).isEmpty());
+    }
+
+    void benchmarkLookup_data()
+    {
+        QTest::addColumn<bool>("useIndex");
+        QTest::newRow("index") << true;
+        QTest::newRow("linear") << false;
+    }
+
+    void benchmarkLookup()
+    {
+        QFETCH(bool, useIndex);
+
+        KPkPass::LocationIndex index;
+        for (const auto &pass : m_passes) {
+            index.insert(pass.get());
+        }
+
+        qsizetype hits = 0;
+        QBENCHMARK {
+            for (const auto &q : std::as_const(m_queries)) {
+                hits += useIndex ? index.passesNear(q.y(), q.x()).size() : bruteForce(m_passes, q.y(), q.x()).size();
+            }
+        }
+        QVERIFY(hits > 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(LocationIndexTest)
+
+#include "locationindextest.moc"
@@ -0,0 +1,242 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "barcode.h"
+#include "boardingpass.h"
+#include "pass.h"
+#include "testpasses.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QTemporaryDir>
+#include <QTest>
+
+using namespace Qt::Literals;
+
+class PassCacheTest : public QObject
+{
+    Q_OBJECT
+private:
+    QTemporaryDir m_dir;
+
+    QString copyTestPass()
+    {
+        const auto fileName = m_dir.filePath(u"boardingpass-v1.pkpass"_s);
+        QFile::remove(fileName);
+        if (!QFile::copy(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s, fileName)) {
+            return {};
+        }
+        return fileName;
+    }
+
+    QString cacheFileName() const
+    {
+        return m_dir.filePath(u"boardingpass-v1.cache"_s);
+    }
+
+    static void accessPass(KPkPass::Pass *pass)
+    {
+        pass->setLanguage(u"de"_s);
+        (void)pass->description();
+        (void)pass->fields();
+        (void)pass->barcodes();
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QVERIFY(m_dir.isValid());
+    }
+
+    void testRoundTrip()
+    {
+        const auto fileName = copyTestPass();
+        QVERIFY(!fileName.isEmpty());
+        QFile::remove(cacheFileName());
+
+        std::unique_ptr<KPkPass::Pass> parsed(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(parsed);
+        QVERIFY(QFile::exists(cacheFileName()));
+
+        std::unique_ptr<KPkPass::Pass> cached(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(cached);
+        QCOMPARE(cached->type(), KPkPass::Pass::BoardingPass);
+        QVERIFY(qobject_cast<KPkPass::BoardingPass *>(cached.get()));
+        QCOMPARE(cached->serialNumber(), parsed->serialNumber());
+        QCOMPARE(cached->languages(), (QStringList{u"de"_s, u"en"_s}));
+        QCOMPARE(cached->barcodes().size(), 1);
+        QCOMPARE(cached->barcodes().at(0).message(), parsed->barcodes().at(0).message());
+        QCOMPARE(cached->fields().size(), parsed->fields().size());
+
+        cached->setLanguage(u"en"_s);
+        QCOMPARE(cached->description(), "KDE Boarding pass"_L1);
+        QCOMPARE(cached->headerFields().at(0).label(), "Seat"_L1);
+        cached->setLanguage(u"de"_s);
+        QCOMPARE(cached->description(), "KDE Bordkarte"_L1);
+
+        // assets come from the archive, opened on demand
+        QVERIFY(cached->hasLogo());
+        QVERIFY(!cached->hasStrip());
+        QVERIFY(!cached->logo().isNull());
+        QCOMPARE(cached->logo().size(), parsed->logo().size());
+        QCOMPARE(cached->rawData(), parsed->rawData());
+    }
+
+    void testNoArchiveAccess()
+    {
+        const auto fileName = copyTestPass();
+        QVERIFY(!fileName.isEmpty());
+        QFile::remove(cacheFileName());
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(fileName));
+        QVERIFY(pass);
+        QVERIFY(pass->writeCache(cacheFileName()));
+        pass.reset(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(pass);
+
+        // everything but the assets is available without the archive
+        QVERIFY(QFile::remove(fileName));
+        pass->setLanguage(u"en"_s);
+        QCOMPARE(pass->description(), "KDE Boarding pass"_L1);
+        QCOMPARE(pass->headerFields().at(0).label(), "Seat"_L1);
+        QVERIFY(pass->hasLogo());
+        QVERIFY(pass->logo().isNull());
+        QVERIFY(pass->rawData().isEmpty());
+
+        // the cache is invalid once the source is gone
+        pass.reset(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(!pass);
+    }
+
+    void testInvalidation()
+    {
+        const auto fileName = copyTestPass();
+        QVERIFY(!fileName.isEmpty());
+        QFile::remove(cacheFileName());
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(pass);
+        QCOMPARE(pass->serialNumber(), "1234"_L1);
+
+        // replace the source file
+        {
+            QFile f(fileName);
+            QVERIFY(f.open(QFile::WriteOnly | QFile::Truncate));
+            f.write(TestPasses::makePass(TestPasses::genericPass(u"5678"_s)));
+            f.close();
+            QVERIFY(f.open(QFile::ReadWrite));
+            QVERIFY(f.setFileTime(QDateTime::currentDateTimeUtc().addSecs(3600), QFileDevice::FileModificationTime));
+        }
+        pass.reset(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(pass);
+        QCOMPARE(pass->type(), KPkPass::Pass::Generic);
+        QCOMPARE(pass->serialNumber(), "5678"_L1);
+
+        // and the cache got updated
+        pass.reset(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(pass);
+        QCOMPARE(pass->serialNumber(), "5678"_L1);
+    }
+
+    void testSourceChangedAfterLoad()
+    {
+        const auto fileName = copyTestPass();
+        QVERIFY(!fileName.isEmpty());
+        QFile::remove(cacheFileName());
+        QVERIFY(std::unique_ptr<KPkPass::Pass>(KPkPass::Pass::fromFileCached(fileName, cacheFileName())));
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(pass);
+
+        // replace the source before the archive got opened on demand
+        {
+            QFile f(fileName);
+            QVERIFY(f.open(QFile::WriteOnly | QFile::Truncate));
+            f.write(TestPasses::makePass(TestPasses::genericPass(u"5678"_s)));
+            f.close();
+            QVERIFY(f.open(QFile::ReadWrite));
+            QVERIFY(f.setFileTime(QDateTime::currentDateTimeUtc().addSecs(3600), QFileDevice::FileModificationTime));
+        }
+
+        // cached content stays consistent, nothing is taken from the new archive
+        QCOMPARE(pass->serialNumber(), "1234"_L1);
+        QVERIFY(pass->hasLogo());
+        QVERIFY(pass->logo().isNull());
+        QVERIFY(pass->rawData().isEmpty());
+    }
+
+    void testSourceChangedBeforeWrite()
+    {
+        const auto fileName = copyTestPass();
+        QVERIFY(!fileName.isEmpty());
+        QFile::remove(cacheFileName());
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(fileName));
+        QVERIFY(pass);
+
+        // replace the source between loading and writing the cache
+        {
+            QFile f(fileName);
+            QVERIFY(f.open(QFile::WriteOnly | QFile::Truncate));
+            f.write(TestPasses::makePass(TestPasses::genericPass(u"5678"_s)));
+            f.close();
+            QVERIFY(f.open(QFile::ReadWrite));
+            QVERIFY(f.setFileTime(QDateTime::currentDateTimeUtc().addSecs(3600), QFileDevice::FileModificationTime));
+        }
+        QVERIFY(!pass->writeCache(cacheFileName()));
+        QVERIFY(!QFile::exists(cacheFileName()));
+
+        // the new content is loaded and cached instead of the outdated one
+        pass.reset(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(pass);
+        QCOMPARE(pass->serialNumber(), "5678"_L1);
+        QVERIFY(QFile::exists(cacheFileName()));
+    }
+
+    void testCorruptCache()
+    {
+        const auto fileName = copyTestPass();
+        QVERIFY(!fileName.isEmpty());
+        {
+            QFile f(cacheFileName());
+            QVERIFY(f.open(QFile::WriteOnly | QFile::Truncate));
+            f.write("KPPC garbage");
+        }
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+        QVERIFY(pass);
+        QCOMPARE(pass->serialNumber(), "1234"_L1);
+        QVERIFY(QFileInfo(cacheFileName()).size() > 100);
+
+        // passes not loaded from a file can't be cached
+        pass.reset(KPkPass::Pass::fromData(TestPasses::makePass(TestPasses::genericPass(u"1"_s))));
+        QVERIFY(pass);
+        QVERIFY(!pass->writeCache(cacheFileName()));
+    }
+
+    void benchmarkFromFile()
+    {
+        const auto fileName = copyTestPass();
+        QVERIFY(!fileName.isEmpty());
+        QBENCHMARK {
+            std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(fileName));
+            accessPass(pass.get());
+        }
+    }
+
+    void benchmarkFromFileCached()
+    {
+        const auto fileName = copyTestPass();
+        QVERIFY(!fileName.isEmpty());
+        QFile::remove(cacheFileName());
+        QVERIFY(std::unique_ptr<KPkPass::Pass>(KPkPass::Pass::fromFileCached(fileName, cacheFileName())));
+        QBENCHMARK {
+            std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFileCached(fileName, cacheFileName()));
+            accessPass(pass.get());
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(PassCacheTest)
+
+#include "passcachetest.moc"
@@ -0,0 +1,106 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "passcollection.h"
+#include "testpasses.h"
+
+#include <QTest>
+#include <QTimeZone>
+
+using namespace Qt::Literals;
+
+class PassCollectionTest : public QObject
+{
+    Q_OBJECT
+private:
+    static std::unique_ptr<KPkPass::Pass> makePass(const QString &serial, const QString &group, const QDateTime &relevantDate, const QDateTime &expirationDate)
+    {
+        auto obj = TestPasses::genericPass(serial);
+        if (!group.isEmpty()) {
+            obj.insert("groupingIdentifier"_L1, group);
+        }
+        if (relevantDate.isValid()) {
+            obj.insert("relevantDate"_L1, relevantDate.toString(Qt::ISODate));
+        }
+        if (expirationDate.isValid()) {
+            obj.insert("expirationDate"_L1, expirationDate.toString(Qt::ISODate));
+        }
+        return std::unique_ptr<KPkPass::Pass>(KPkPass::Pass::fromData(TestPasses::makePass(obj)));
+    }
+
+    static QStringList serials(const QList<KPkPass::Pass *> &passes)
+    {
+        QStringList l;
+        for (const auto pass : passes) {
+            l.push_back(pass->serialNumber());
+        }
+        return l;
+    }
+
+private Q_SLOTS:
+    void testInsertAndLookup()
+    {
+        const QDateTime dt({2026, 5, 1}, {12, 0}, QTimeZone::UTC);
+
+        KPkPass::PassCollection coll;
+        QVERIFY(coll.isEmpty());
+        QCOMPARE(coll.insert(makePass(u"1"_s, u"G1"_s, dt.addDays(2), dt.addDays(3))), false);
+        QCOMPARE(coll.insert(makePass(u"2"_s, u"G1"_s, dt, dt.addDays(10))), false);
+        QCOMPARE(coll.insert(makePass(u"3"_s, u"G2"_s, dt.addDays(1), {})), false);
+        QCOMPARE(coll.insert(makePass(u"4"_s, {}, {}, dt.addDays(1))), false);
+        QCOMPARE(coll.size(), 4);
+
+        QVERIFY(coll.contains(u"pass.org.kde.test"_s, u"2"_s));
+        QVERIFY(!coll.contains(u"pass.org.kde.test"_s, u"5"_s));
+        QVERIFY(!coll.pass(u"pass.org.kde.other"_s, u"1"_s));
+        QCOMPARE(coll.pass(u"pass.org.kde.test"_s, u"3"_s)->serialNumber(), "3"_L1);
+
+        auto group = serials(coll.passesInGroup(u"G1"_s));
+        group.sort();
+        QCOMPARE(group, QStringList({u"1"_s, u"2"_s}));
+        QCOMPARE(serials(coll.passesInGroup(u"G2"_s)), QStringList({u"3"_s}));
+        QVERIFY(coll.passesInGroup(u"G3"_s).isEmpty());
+
+        QCOMPARE(serials(coll.passesByRelevantDate({}, {})), QStringList({u"2"_s, u"3"_s, u"1"_s}));
+        QCOMPARE(serials(coll.passesByRelevantDate(dt.addSecs(1), {})), QStringList({u"3"_s, u"1"_s}));
+        QCOMPARE(serials(coll.passesByRelevantDate(dt, dt.addDays(2))), QStringList({u"2"_s, u"3"_s}));
+        QVERIFY(coll.passesByRelevantDate(dt.addDays(2), dt).isEmpty());
+        QCOMPARE(serials(coll.passesByExpirationDate({}, dt.addDays(5))), QStringList({u"4"_s, u"1"_s}));
+    }
+
+    void testReplaceAndRemove()
+    {
+        const QDateTime dt({2026, 5, 1}, {12, 0}, QTimeZone::UTC);
+
+        KPkPass::PassCollection coll;
+        coll.insert(makePass(u"1"_s, u"G1"_s, dt, {}));
+        coll.insert(makePass(u"2"_s, u"G1"_s, dt.addDays(1), {}));
+
+        // replacing updates all indexes
+        QCOMPARE(coll.insert(makePass(u"1"_s, u"G2"_s, dt.addDays(2), {})), true);
+        QCOMPARE(coll.size(), 2);
+        QCOMPARE(serials(coll.passesInGroup(u"G1"_s)), QStringList({u"2"_s}));
+        QCOMPARE(serials(coll.passesInGroup(u"G2"_s)), QStringList({u"1"_s}));
+        QCOMPARE(serials(coll.passesByRelevantDate({}, {})), QStringList({u"2"_s, u"1"_s}));
+
+        auto pass = coll.take(u"pass.org.kde.test"_s, u"2"_s);
+        QVERIFY(pass);
+        QCOMPARE(pass->serialNumber(), "2"_L1);
+        QCOMPARE(coll.size(), 1);
+        QVERIFY(coll.passesInGroup(u"G1"_s).isEmpty());
+        QCOMPARE(serials(coll.passesByRelevantDate({}, {})), QStringList({u"1"_s}));
+
+        QVERIFY(!coll.remove(u"pass.org.kde.test"_s, u"2"_s));
+        QVERIFY(coll.remove(u"pass.org.kde.test"_s, u"1"_s));
+        QVERIFY(coll.isEmpty());
+        QVERIFY(coll.passesByRelevantDate({}, {}).isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(PassCollectionTest)
+
+#include "passcollectiontest.moc"
@@ -0,0 +1,141 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "field.h"
+#include "pass.h"
+#include "passdiff.h"
+#include "testpasses.h"
+
+#include <QJsonArray>
+#include <QTest>
+
+using namespace Qt::Literals;
+
+class PassDiffTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QJsonObject field(const QString &key, const QString &value, const QString &label = {})
+    {
+        QJsonObject obj{{"key"_L1, key}, {"value"_L1, value}};
+        if (!label.isEmpty()) {
+            obj.insert("label"_L1, label);
+        }
+        return obj;
+    }
+
+    static QJsonObject passJson()
+    {
+        auto obj = TestPasses::genericPass(u"1234"_s);
+        obj.insert("organizationName"_L1, u"KDE"_s);
+        obj.insert("generic"_L1,
+                   QJsonObject{
+                       {"primaryFields"_L1, QJsonArray{field(u"gate"_s, u"A1"_s, u"Gate"_s)}},
+                       {"secondaryFields"_L1, QJsonArray{field(u"seat"_s, u"12A"_s), field(u"class"_s, u"Economy"_s)}},
+                   });
+        obj.insert("barcodes"_L1, QJsonArray{QJsonObject{{"format"_L1, u"PKBarcodeFormatQR"_s}, {"message"_L1, u"1234"_s}}});
+        return obj;
+    }
+
+    static std::unique_ptr<KPkPass::Pass> makePass(const QJsonObject &obj, const QHash<QString, QByteArray> &files = {})
+    {
+        return std::unique_ptr<KPkPass::Pass>(KPkPass::Pass::fromData(TestPasses::makePass(obj, files)));
+    }
+
+    static QStringList keys(const QList<KPkPass::Field> &fields)
+    {
+        QStringList l;
+        std::transform(fields.begin(), fields.end(), std::back_inserter(l), [](const auto &f) {
+            return f.key();
+        });
+        l.sort();
+        return l;
+    }
+
+private Q_SLOTS:
+    void testIdentical()
+    {
+        const QHash<QString, QByteArray> files{{u"icon.png"_s, "icon"_ba}};
+        auto oldPass = makePass(passJson(), files);
+        auto newPass = makePass(passJson(), files);
+        QVERIFY(oldPass);
+        QVERIFY(newPass);
+
+        const auto diff = KPkPass::PassDiff::compare(oldPass.get(), newPass.get());
+        QVERIFY(diff.isEmpty());
+        QVERIFY(diff.addedFields().isEmpty());
+        QVERIFY(diff.removedFields().isEmpty());
+        QVERIFY(diff.changedFields().isEmpty());
+        QVERIFY(diff.changedKeys().isEmpty());
+        QVERIFY(!diff.barcodesChanged());
+        QVERIFY(diff.changedAssets().isEmpty());
+    }
+
+    void testFields()
+    {
+        auto oldPass = makePass(passJson());
+
+        auto obj = passJson();
+        obj.insert("generic"_L1,
+                   QJsonObject{
+                       {"primaryFields"_L1, QJsonArray{field(u"gate"_s, u"B7"_s, u"Gate"_s)}},
+                       {"secondaryFields"_L1, QJsonArray{field(u"seat"_s, u"12A"_s), field(u"boarding"_s, u"12:30"_s)}},
+                       {"transitType"_L1, u"PKTransitTypeAir"_s},
+                   });
+        auto newPass = makePass(obj);
+
+        const auto diff = KPkPass::PassDiff::compare(oldPass.get(), newPass.get());
+        QVERIFY(!diff.isEmpty());
+        QCOMPARE(keys(diff.addedFields()), QStringList{u"boarding"_s});
+        QCOMPARE(keys(diff.removedFields()), QStringList{u"class"_s});
+        QCOMPARE(diff.changedFields().size(), 1);
+        QCOMPARE(diff.changedFields().at(0).key(), "gate"_L1);
+        QCOMPARE(diff.changedFields().at(0).value(), u"B7"_s);
+        QCOMPARE(diff.changedKeys(), QStringList{u"generic.transitType"_s});
+        QVERIFY(!diff.barcodesChanged());
+    }
+
+    void testKeysAndBarcodes()
+    {
+        auto oldPass = makePass(passJson());
+
+        auto obj = passJson();
+        obj.insert("organizationName"_L1, u"KDE e.V."_s);
+        obj.insert("voided"_L1, true);
+        obj.insert("barcodes"_L1, QJsonArray{QJsonObject{{"format"_L1, u"PKBarcodeFormatQR"_s}, {"message"_L1, u"5678"_s}}});
+        auto newPass = makePass(obj);
+
+        const auto diff = KPkPass::PassDiff::compare(oldPass.get(), newPass.get());
+        auto changedKeys = diff.changedKeys();
+        changedKeys.sort();
+        QCOMPARE(changedKeys, (QStringList{u"organizationName"_s, u"voided"_s}));
+        QVERIFY(diff.barcodesChanged());
+        QVERIFY(diff.addedFields().isEmpty());
+        QVERIFY(diff.removedFields().isEmpty());
+        QVERIFY(diff.changedFields().isEmpty());
+    }
+
+    void testAssets()
+    {
+        auto oldPass = makePass(passJson(), {{u"icon.png"_s, "icon"_ba}, {u"logo.png"_s, "logo"_ba}, {u"de.lproj/pass.strings"_s, "\"a\" = \"b\";"_ba}});
+        auto newPass = makePass(passJson(), {{u"icon.png"_s, "new icon"_ba}, {u"strip.png"_s, "strip"_ba}, {u"de.lproj/pass.strings"_s, "\"a\" = \"b\";"_ba}});
+
+        const auto diff = KPkPass::PassDiff::compare(oldPass.get(), newPass.get());
+        QCOMPARE(diff.changedAssets(), (QStringList{u"icon.png"_s, u"logo.png"_s, u"strip.png"_s}));
+        QVERIFY(diff.changedKeys().isEmpty());
+        QVERIFY(!diff.isEmpty());
+
+        // copies are independent
+        auto copy = diff;
+        copy = KPkPass::PassDiff();
+        QVERIFY(copy.isEmpty());
+        QCOMPARE(diff.changedAssets().size(), 3);
+    }
+};
+
+QTEST_GUILESS_MAIN(PassDiffTest)
+
+#include "passdifftest.moc"
@@ -0,0 +1,151 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "barcode.h"
+#include "field.h"
+#include "location.h"
+#include "pass.h"
+#include "seat.h"
+
+#include <QTest>
+
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+using namespace Qt::Literals;
+
+// count heap allocations done via operator new
+static std::atomic<qint64> s_allocationCount = 0;
+
+void *operator new(std::size_t size)
+{
+    ++s_allocationCount;
+    if (auto p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+class PassElementsTest : public QObject
+{
+    Q_OBJECT
+private:
+    static qint64 countAllocations(const std::function<void()> &func)
+    {
+        const auto before = s_allocationCount.load();
+        func();
+        return s_allocationCount.load() - before;
+    }
+
+    static void accessElements(const KPkPass::Pass *pass)
+    {
+        const auto fields = pass->fields();
+        const auto headerFields = pass->headerFields();
+        const auto barcodes = pass->barcodes();
+        const auto locations = pass->locations();
+        const auto seats = pass->seats();
+        const auto field = pass->field(u"gate"_s);
+        Q_UNUSED(field);
+        Q_UNUSED(headerFields);
+        Q_UNUSED(barcodes);
+        Q_UNUSED(locations);
+        Q_UNUSED(seats);
+    }
+
+private Q_SLOTS:
+    void testNoAllocations()
+    {
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        QVERIFY(pass);
+
+        // first access parses
+        const auto firstAccess = countAllocations([&pass]() {
+            accessElements(pass.get());
+        });
+        qInfo() << "allocations on first access:" << firstAccess;
+        QVERIFY(firstAccess > 0);
+
+        // subsequent ones only hand out shared handles
+        const auto repeatedAccess = countAllocations([&pass]() {
+            accessElements(pass.get());
+        });
+        QCOMPARE(repeatedAccess, 0);
+        QCOMPARE(pass->fields().constData(), pass->fields().constData());
+
+        // default constructed handles don't allocate either
+        const auto defaultConstructed = countAllocations([]() {
+            KPkPass::Field f;
+            KPkPass::Barcode b;
+            KPkPass::Location l;
+            KPkPass::Seat s;
+            Q_UNUSED(f);
+            Q_UNUSED(b);
+            Q_UNUSED(l);
+            Q_UNUSED(s);
+        });
+        QCOMPARE(defaultConstructed, 0);
+    }
+
+    void testElements()
+    {
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/apple-store-UA-sample-unsigned-scrubbed.pkpass"_s));
+        QVERIFY(pass);
+        QCOMPARE(pass->seats().size(), 1);
+        QCOMPARE(pass->barcodes().size(), 1);
+
+        const auto fields = pass->fields();
+        QVERIFY(!fields.isEmpty());
+        const auto field = pass->field(fields.back().key());
+        QCOMPARE(field.key(), fields.back().key());
+        QVERIFY(pass->field(u"does not exist"_s).key().isEmpty());
+
+        std::unique_ptr<KPkPass::Pass> bp(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        QVERIFY(bp);
+        const auto locations = bp->locations();
+        QVERIFY(!locations.isEmpty());
+        QVERIFY(!std::isnan(locations.at(0).latitude()));
+
+        // handles remain valid for pass-independent data
+        const auto key = fields.front().key();
+        const auto latitude = locations.at(0).latitude();
+        pass.reset();
+        bp.reset();
+        QCOMPARE(fields.front().key(), key);
+        QCOMPARE(locations.at(0).latitude(), latitude);
+    }
+
+    void benchmarkElementAccess()
+    {
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        QVERIFY(pass);
+        qint64 allocations = 0;
+        int iterations = 0;
+        QBENCHMARK {
+            allocations += countAllocations([&pass]() {
+                accessElements(pass.get());
+            });
+            ++iterations;
+        }
+        qInfo() << "allocations per iteration:" << (double)allocations / iterations;
+    }
+};
+
+QTEST_GUILESS_MAIN(PassElementsTest)
+
+#include "passelementstest.moc"
@@ -0,0 +1,127 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "passes.h"
+#include "passeswriter.h"
+#include "testpasses.h"
+
+#include <KZip>
+
+#include <QBuffer>
+#include <QTest>
+#include <QThreadPool>
+
+using namespace Qt::Literals;
+
+class PassesWriterTest : public QObject
+{
+    Q_OBJECT
+private:
+    // something reasonably large and compressible, but different per pass
+    static QByteArray payload(int seed)
+    {
+        QByteArray data;
+        for (int i = 0; i < 5000; ++i) {
+            data += "entry " + QByteArray::number(seed * i) + " of pass " + QByteArray::number(seed) + '\n';
+        }
+        return data;
+    }
+
+    static QByteArray writeBundle(QThreadPool *pool, int count)
+    {
+        QByteArray data;
+        QBuffer buffer(&data);
+        KPkPass::PassesWriter writer(&buffer);
+        writer.setThreadPool(pool);
+        for (int i = 0; i < count; ++i) {
+            const auto serial = QString::number(i);
+            writer.addPass(serial + ".pkpass"_L1, TestPasses::genericPass(serial), {{u"data.txt"_s, payload(i)}});
+        }
+        return writer.finish() ? data : QByteArray();
+    }
+
+private Q_SLOTS:
+    void testWrite()
+    {
+        const auto rawPass = TestPasses::makePass(TestPasses::genericPass(u"raw"_s));
+
+        QByteArray data;
+        {
+            QBuffer buffer(&data);
+            KPkPass::PassesWriter writer(&buffer);
+            for (int i = 0; i < 20; ++i) {
+                const auto serial = QString::number(i);
+                QVERIFY(writer.addPass(serial + ".pkpass"_L1, TestPasses::genericPass(serial), {{u"data.txt"_s, payload(i)}}));
+                if (i == 10) {
+                    QVERIFY(writer.addPassData(u"raw.pkpass"_s, rawPass));
+                }
+            }
+            QVERIFY(!writer.addPass(u"3.pkpass"_s, TestPasses::genericPass(u"3"_s)));
+            QVERIFY(!writer.addPassData(u"raw.pkpass"_s, rawPass));
+            QVERIFY(writer.finish());
+            QVERIFY(!writer.addPassData(u"late.pkpass"_s, rawPass));
+        }
+
+        std::unique_ptr<KPkPass::Passes> passes(KPkPass::Passes::fromData(data));
+        QVERIFY(passes);
+        QCOMPARE(passes->entries().size(), 21);
+        QCOMPARE(passes->passData(u"raw.pkpass"_s), rawPass);
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(passes->passData(u"7.pkpass"_s)));
+        QVERIFY(pass);
+        QCOMPARE(pass->serialNumber(), u"7"_s);
+
+        // members are in insertion order, and stored
+        QBuffer buffer(&data);
+        KZip zip(&buffer);
+        QVERIFY(zip.open(QIODevice::ReadOnly));
+        std::vector<const KZipFileEntry *> entries;
+        for (const auto &name : zip.directory()->entries()) {
+            entries.push_back(static_cast<const KZipFileEntry *>(zip.directory()->file(name)));
+            QCOMPARE(entries.back()->encoding(), 0);
+        }
+        std::sort(entries.begin(), entries.end(), [](auto lhs, auto rhs) {
+            return lhs->position() < rhs->position();
+        });
+        QStringList names;
+        std::transform(entries.begin(), entries.end(), std::back_inserter(names), [](auto entry) {
+            return entry->name();
+        });
+        QCOMPARE(names.at(0), u"0.pkpass"_s);
+        QCOMPARE(names.at(10), u"10.pkpass"_s);
+        QCOMPARE(names.at(11), u"raw.pkpass"_s);
+        QCOMPARE(names.at(20), u"19.pkpass"_s);
+    }
+
+    void testSequential()
+    {
+        const auto data = writeBundle(nullptr, 5);
+        std::unique_ptr<KPkPass::Passes> passes(KPkPass::Passes::fromData(data));
+        QVERIFY(passes);
+        QCOMPARE(passes->entries().size(), 5);
+    }
+
+    void benchmarkWrite_data()
+    {
+        QTest::addColumn<bool>("parallel");
+        QTest::newRow("single-threaded") << false;
+        QTest::newRow("thread pool") << true;
+    }
+
+    void benchmarkWrite()
+    {
+        QFETCH(bool, parallel);
+        QByteArray data;
+        QBENCHMARK {
+            data = writeBundle(parallel ? QThreadPool::globalInstance() : nullptr, 200);
+        }
+        QVERIFY(!data.isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(PassesWriterTest)
+
+#include "passeswritertest.moc"
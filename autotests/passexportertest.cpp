@@ -0,0 +1,178 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "passexporter.h"
+#include "testpasses.h"
+
+#include <QBuffer>
+#include <QCborMap>
+#include <QCborStreamReader>
+#include <QCborValue>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTest>
+#include <QThreadPool>
+
+#include <algorithm>
+
+using namespace Qt::Literals;
+
+class PassExporterTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QByteArray exportPasses(QThreadPool *pool, KPkPass::PassExporter::Format format, int count, int maximumPending = 0)
+    {
+        QByteArray data;
+        QBuffer buffer(&data);
+        KPkPass::PassExporter exporter(&buffer, format);
+        exporter.setThreadPool(pool);
+        exporter.setMaximumPendingRecords(maximumPending);
+        for (int i = 0; i < count; ++i) {
+            const auto serial = QString::number(i);
+            auto passJson = TestPasses::genericPass(serial);
+            passJson.insert("description"_L1, u"line\nbreak \"quoted\" ä"_s);
+            exporter.addData(TestPasses::makePass(passJson), serial);
+        }
+        return exporter.finish() && exporter.recordCount() == count ? data : QByteArray();
+    }
+
+    static QList<QJsonObject> parseJsonLines(const QByteArray &data)
+    {
+        QList<QJsonObject> records;
+        for (const auto &line : data.split('\n')) {
+            if (line.isEmpty()) {
+                continue;
+            }
+            QJsonParseError error;
+            const auto doc = QJsonDocument::fromJson(line, &error);
+            if (error.error != QJsonParseError::NoError) {
+                qWarning() << error.errorString() << line;
+                return {};
+            }
+            records.push_back(doc.object());
+        }
+        return records;
+    }
+
+private Q_SLOTS:
+    void testJsonLines()
+    {
+        QFile sourceFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s);
+        QVERIFY(sourceFile.open(QFile::ReadOnly));
+        const auto passData = sourceFile.readAll();
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(passData));
+        QVERIFY(pass);
+
+        QByteArray data;
+        {
+            QBuffer buffer(&data);
+            KPkPass::PassExporter exporter(&buffer);
+            QVERIFY(exporter.addFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+            QVERIFY(exporter.addData("not a pass", u"garbage"_s));
+            QVERIFY(exporter.addPass(pass.get(), u"loaded"_s));
+            QVERIFY(exporter.addFile(u"" SOURCE_DIR "/data/does-not-exist.pkpass"_s));
+            QVERIFY(exporter.finish());
+            QCOMPARE(exporter.recordCount(), 4);
+            QVERIFY(!exporter.addData(passData));
+        }
+
+        const auto records = parseJsonLines(data);
+        QCOMPARE(records.size(), 4);
+        QVERIFY(records[0].value("source"_L1).toString().endsWith("boardingpass-v1.pkpass"_L1));
+        QCOMPARE(records[0].value("type"_L1).toString(), "BoardingPass"_L1);
+        QCOMPARE(records[0].value("serialNumber"_L1).toString(), "1234"_L1);
+        QCOMPARE(records[0].value("voided"_L1).toBool(), false);
+        const auto fields = records[0].value("fields"_L1).toArray();
+        QVERIFY(!fields.isEmpty());
+        const auto primary = std::find_if(fields.begin(), fields.end(), [](const auto &field) {
+            return field.toObject().value("key"_L1).toString() == "depart"_L1;
+        });
+        QVERIFY(primary != fields.end());
+        QCOMPARE((*primary).toObject().value("section"_L1).toString(), "primary"_L1);
+        QCOMPARE((*primary).toObject().value("value"_L1).toString(), "ZRH"_L1);
+        const auto barcodes = records[0].value("barcodes"_L1).toArray();
+        QCOMPARE(barcodes.size(), 1);
+        QCOMPARE(barcodes.at(0).toObject().value("format"_L1).toString(), "QR"_L1);
+        const auto locations = records[0].value("locations"_L1).toArray();
+        QCOMPARE(locations.size(), 1);
+        QCOMPARE(locations.at(0).toObject().value("latitude"_L1).toDouble(), 47.4523);
+        QVERIFY(!locations.at(0).toObject().contains("altitude"_L1));
+
+        QCOMPARE(records[1].value("source"_L1).toString(), "garbage"_L1);
+        QCOMPARE(records[1].value("error"_L1).toString(), "InvalidArchive"_L1);
+        QCOMPARE(records[2].value("source"_L1).toString(), "loaded"_L1);
+        QCOMPARE(records[2].value("fields"_L1), records[0].value("fields"_L1));
+        QCOMPARE(records[3].value("error"_L1).toString(), "FileError"_L1);
+    }
+
+    void testOrder_data()
+    {
+        QTest::addColumn<bool>("parallel");
+        QTest::addColumn<int>("maximumPending");
+        QTest::newRow("sequential") << false << 0;
+        QTest::newRow("parallel") << true << 0;
+        QTest::newRow("parallel-bounded") << true << 1;
+    }
+
+    void testOrder()
+    {
+        QFETCH(bool, parallel);
+        QFETCH(int, maximumPending);
+
+        const auto data = exportPasses(parallel ? QThreadPool::globalInstance() : nullptr, KPkPass::PassExporter::JsonLines, 50, maximumPending);
+        const auto records = parseJsonLines(data);
+        QCOMPARE(records.size(), 50);
+        for (int i = 0; i < records.size(); ++i) {
+            QCOMPARE(records[i].value("serialNumber"_L1).toString(), QString::number(i));
+            QCOMPARE(records[i].value("description"_L1).toString(), u"line\nbreak \"quoted\" ä"_s);
+        }
+    }
+
+    void testCbor()
+    {
+        const auto data = exportPasses(QThreadPool::globalInstance(), KPkPass::PassExporter::Cbor, 20);
+        QVERIFY(!data.isEmpty());
+
+        QCborStreamReader reader(data);
+        int count = 0;
+        while (reader.isValid()) {
+            const auto record = QCborValue::fromCbor(reader).toMap();
+            QCOMPARE(record.value("serialNumber"_L1).toString(), QString::number(count));
+            QCOMPARE(record.value("source"_L1).toString(), QString::number(count));
+            QCOMPARE(record.value("type"_L1).toString(), "Generic"_L1);
+            QVERIFY(record.value("fields"_L1).isArray());
+            ++count;
+        }
+        QCOMPARE(count, 20);
+    }
+
+    void benchmarkExport_data()
+    {
+        QTest::addColumn<bool>("parallel");
+        QTest::addColumn<bool>("cbor");
+        QTest::newRow("json single-threaded") << false << false;
+        QTest::newRow("json thread pool") << true << false;
+        QTest::newRow("cbor thread pool") << true << true;
+    }
+
+    void benchmarkExport()
+    {
+        QFETCH(bool, parallel);
+        QFETCH(bool, cbor);
+        QByteArray data;
+        QBENCHMARK {
+            data = exportPasses(parallel ? QThreadPool::globalInstance() : nullptr, cbor ? KPkPass::PassExporter::Cbor : KPkPass::PassExporter::JsonLines, 200);
+        }
+        QVERIFY(!data.isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(PassExporterTest)
+
+#include "passexportertest.moc"
@@ -0,0 +1,271 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "testpasses.h"
+
+#include <QFile>
+#include <QImage>
+#include <QTest>
+#include <QtEndian>
+
+using namespace Qt::Literals;
+
+class PassProbeTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QByteArray storedPass(const QByteArray &passJson)
+    {
+        QByteArray data;
+        QBuffer buffer(&data);
+        KZip zip(&buffer);
+        zip.open(QIODevice::WriteOnly);
+        zip.setCompression(KZip::NoCompression);
+        zip.writeFile(u"icon.png"_s, "not really a PNG");
+        zip.writeFile(u"pass.json"_s, passJson);
+        zip.close();
+        return data;
+    }
+
+    /** Offset of the central directory record of @p name, or @c -1. */
+    static qsizetype centralDirectoryRecord(const QByteArray &data, QByteArrayView name)
+    {
+        for (auto idx = data.indexOf("PK\x01\x02"); idx >= 0 && idx + 46 <= data.size(); idx = data.indexOf("PK\x01\x02", idx + 4)) {
+            const auto nameLength = qFromLittleEndian<quint16>(data.constData() + idx + 28);
+            if (QByteArrayView(data).mid(idx + 46, nameLength) == name) {
+                return idx;
+            }
+        }
+        return -1;
+    }
+
+private Q_SLOTS:
+    void testFiles_data()
+    {
+        QTest::addColumn<QString>("fileName");
+        QTest::addColumn<KPkPass::Pass::Type>("type");
+        QTest::newRow("boardingpass-v1") << u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s << KPkPass::Pass::BoardingPass;
+        QTest::newRow("boardingpass-v2") << u"" SOURCE_DIR "/data/boardingpass-v2.pkpass"_s << KPkPass::Pass::BoardingPass;
+        QTest::newRow("apple-store") << u"" SOURCE_DIR "/data/apple-store-UA-sample-unsigned-scrubbed.pkpass"_s << KPkPass::Pass::BoardingPass;
+    }
+
+    void testFiles()
+    {
+        QFETCH(QString, fileName);
+        QFETCH(KPkPass::Pass::Type, type);
+
+        const auto res = KPkPass::Pass::probeFile(fileName);
+        QVERIFY(res.isValid);
+        QCOMPARE(res.type, type);
+        QCOMPARE(res.formatVersion, 1);
+
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(fileName));
+        QVERIFY(pass);
+        QCOMPARE(pass->type(), res.type);
+    }
+
+    void testSynthetic()
+    {
+        auto res = KPkPass::Pass::probe(TestPasses::makePass(TestPasses::genericPass(u"123"_s)));
+        QVERIFY(res.isValid);
+        QCOMPARE(res.type, KPkPass::Pass::Generic);
+
+        // stored, with nested and escaped content ahead of the type key
+        res = KPkPass::Pass::probe(
+            storedPass(R"({"description": "a \"coupon\": {", "nested": {"storeCard": {}}, "list": ["boardingPass", {"generic": 1}], "eventTicket": {}, "formatVersion": 1})"));
+        QVERIFY(res.isValid);
+        QCOMPARE(res.type, KPkPass::Pass::EventTicket);
+        QCOMPARE(res.formatVersion, 1);
+
+        // no formatVersion is accepted, as in fromData()
+        res = KPkPass::Pass::probe(storedPass(R"({"coupon": {}})"));
+        QVERIFY(res.isValid);
+        QCOMPARE(res.type, KPkPass::Pass::Coupon);
+        QCOMPARE(res.formatVersion, 0);
+    }
+
+    void testMultipleTypes_data()
+    {
+        QTest::addColumn<QByteArray>("passJson");
+        QTest::addColumn<KPkPass::Pass::Type>("type");
+        QTest::newRow("generic-boardingPass") << QByteArray(R"({"formatVersion": 1, "serialNumber": "1", "generic": {}, "boardingPass": {}})")
+                                              << KPkPass::Pass::BoardingPass;
+        QTest::newRow("storeCard-coupon-eventTicket")
+            << QByteArray(R"({"storeCard": {}, "formatVersion": 1, "serialNumber": "1", "coupon": {}, "eventTicket": {}})") << KPkPass::Pass::Coupon;
+        QTest::newRow("boardingPass-generic") << QByteArray(R"({"boardingPass": {}, "formatVersion": 1, "serialNumber": "1", "generic": {}})")
+                                              << KPkPass::Pass::BoardingPass;
+    }
+
+    void testMultipleTypes()
+    {
+        QFETCH(QByteArray, passJson);
+        QFETCH(KPkPass::Pass::Type, type);
+
+        // the pass type needs to match what loading the pass determines, independent of the key order
+        const auto data = storedPass(passJson);
+        const auto res = KPkPass::Pass::probe(data);
+        QVERIFY(res.isValid);
+        QCOMPARE(res.type, type);
+
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data));
+        QVERIFY(pass);
+        QCOMPARE(pass->type(), res.type);
+    }
+
+    void testInvalid()
+    {
+        QVERIFY(!KPkPass::Pass::probe(QByteArray()).isValid);
+        QVERIFY(!KPkPass::Pass::probe("PK\x05\x06 garbage").isValid);
+        QVERIFY(!KPkPass::Pass::probeFile(u"" SOURCE_DIR "/data/does-not-exist.pkpass"_s).isValid);
+        QVERIFY(!KPkPass::Pass::probe(storedPass(R"({"formatVersion": 2, "generic": {}})")).isValid);
+        QVERIFY(!KPkPass::Pass::probe(storedPass(R"({"formatVersion": 1, "nested": {"generic": {}}})")).isValid);
+        QVERIFY(!KPkPass::Pass::probe(storedPass(R"(["generic"])")).isValid);
+
+        QByteArray data;
+        {
+            QBuffer buffer(&data);
+            KZip zip(&buffer);
+            zip.open(QIODevice::WriteOnly);
+            zip.writeFile(u"manifest.json"_s, "{}");
+            zip.close();
+        }
+        QVERIFY(!KPkPass::Pass::probe(data).isValid);
+
+        // huge pass.json without the highest priority pass type, as produced by a deflate bomb
+        QByteArray bomb = R"({"formatVersion": 1, "generic": {}, "padding": ")";
+        bomb += QByteArray(64 * 1024 * 1024, 'x');
+        bomb += R"("})";
+        QByteArray bombArchive;
+        {
+            QBuffer buffer(&bombArchive);
+            KZip zip(&buffer);
+            zip.open(QIODevice::WriteOnly);
+            zip.writeFile(u"pass.json"_s, bomb);
+            zip.close();
+        }
+        QVERIFY(bombArchive.size() < 1024 * 1024);
+        QVERIFY(!KPkPass::Pass::probe(bombArchive).isValid);
+        // the same within the scan budget is fine
+        QVERIFY(KPkPass::Pass::probe(storedPass(R"({"formatVersion": 1, "generic": {}, "padding": ")" + QByteArray(64 * 1024, 'x') + R"("})")).isValid);
+
+        // truncated archive
+        auto pass = TestPasses::makePass(TestPasses::genericPass(u"123"_s));
+        pass.truncate(pass.size() / 2);
+        QVERIFY(!KPkPass::Pass::probe(pass).isValid);
+    }
+
+    void testImageFromData()
+    {
+        const auto fileName = u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s;
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(fileName));
+        QVERIFY(pass);
+        for (unsigned int dpr = 1; dpr <= 4; ++dpr) {
+            const auto img = KPkPass::Pass::imageFromFile(fileName, u"logo"_s, dpr);
+            QVERIFY(!img.isNull());
+            QCOMPARE(img, pass->logo(dpr));
+            QCOMPARE(img.devicePixelRatio(), pass->logo(dpr).devicePixelRatio());
+        }
+
+        QFile f(fileName);
+        QVERIFY(f.open(QFile::ReadOnly));
+        const auto data = f.readAll();
+        // scaled down to the requested size
+        auto img = KPkPass::Pass::imageFromData(data, u"logo"_s, 2, QSize(8, 8));
+        QCOMPARE(img.size(), QSize(16, 16));
+        QCOMPARE(img.devicePixelRatio(), 2.0);
+        // never scaled up
+        img = KPkPass::Pass::imageFromData(data, u"logo"_s, 1, QSize(100, 100));
+        QCOMPARE(img.size(), pass->logo().size());
+        QCOMPARE(img.devicePixelRatio(), 1.0);
+
+        QVERIFY(KPkPass::Pass::imageFromData(data, u"icon"_s).isNull());
+        QVERIFY(KPkPass::Pass::imageFromData(QByteArray(), u"logo"_s).isNull());
+
+        KPkPass::LoadOptions opts;
+        opts.setMaximumImagePixels(16);
+        QVERIFY(KPkPass::Pass::imageFromData(data, u"logo"_s, 1, {}, opts).isNull());
+    }
+
+    void testImageFromDamagedData()
+    {
+        QByteArray png;
+        {
+            QBuffer buffer(&png);
+            QVERIFY(buffer.open(QIODevice::WriteOnly));
+            QImage img(4, 4, QImage::Format_ARGB32);
+            img.fill(Qt::red);
+            QVERIFY(img.save(&buffer, "PNG"));
+        }
+        const auto data = TestPasses::makePass(TestPasses::genericPass(u"1"_s), {{u"logo.png"_s, png}});
+        QVERIFY(!KPkPass::Pass::imageFromData(data, u"logo"_s).isNull());
+        const auto idx = centralDirectoryRecord(data, "logo.png");
+        QVERIFY(idx > 0);
+
+        // checksum mismatch
+        auto damaged = data;
+        qToLittleEndian<quint32>(qFromLittleEndian<quint32>(data.constData() + idx + 16) ^ 0x55, damaged.data() + idx + 16);
+        QVERIFY(KPkPass::Pass::imageFromData(damaged, u"logo"_s).isNull());
+
+        // declared size deflate can't produce, also without any size limit
+        KPkPass::LoadOptions opts;
+        opts.setMaximumEntrySize(0);
+        damaged = data;
+        qToLittleEndian<quint32>(0x7fffffff, damaged.data() + idx + 24);
+        QVERIFY(KPkPass::Pass::imageFromData(damaged, u"logo"_s, 1, {}, opts).isNull());
+
+        // encrypted
+        damaged = data;
+        qToLittleEndian<quint16>(qFromLittleEndian<quint16>(data.constData() + idx + 8) | 0x0001, damaged.data() + idx + 8);
+        QVERIFY(KPkPass::Pass::imageFromData(damaged, u"logo"_s).isNull());
+    }
+
+    void benchmarkImageFromData()
+    {
+        QFile f(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s);
+        QVERIFY(f.open(QFile::ReadOnly));
+        const auto data = f.readAll();
+        QBENCHMARK {
+            QVERIFY(!KPkPass::Pass::imageFromData(data, u"logo"_s, 2).isNull());
+        }
+    }
+
+    void benchmarkImageFromPass()
+    {
+        QFile f(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s);
+        QVERIFY(f.open(QFile::ReadOnly));
+        const auto data = f.readAll();
+        QBENCHMARK {
+            std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data));
+            QVERIFY(!pass->logo(2).isNull());
+        }
+    }
+
+    void benchmarkProbe()
+    {
+        QFile f(u"" SOURCE_DIR "/data/apple-store-UA-sample-unsigned-scrubbed.pkpass"_s);
+        QVERIFY(f.open(QFile::ReadOnly));
+        const auto data = f.readAll();
+        QBENCHMARK {
+            QVERIFY(KPkPass::Pass::probe(data).isValid);
+        }
+    }
+
+    void benchmarkFromData()
+    {
+        QFile f(u"" SOURCE_DIR "/data/apple-store-UA-sample-unsigned-scrubbed.pkpass"_s);
+        QVERIFY(f.open(QFile::ReadOnly));
+        const auto data = f.readAll();
+        QBENCHMARK {
+            std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data));
+            QVERIFY(pass);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(PassProbeTest)
+
+#include "passprobetest.moc"
@@ -0,0 +1,110 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "passscheduler.h"
+#include "testpasses.h"
+
+#include <QSignalSpy>
+#include <QTest>
+
+using namespace Qt::Literals;
+using namespace std::chrono_literals;
+
+class PassSchedulerTest : public QObject
+{
+    Q_OBJECT
+private:
+    static std::unique_ptr<KPkPass::Pass> makePass(const QString &serial, const QDateTime &relevantDate, const QDateTime &expirationDate, bool voided = false)
+    {
+        auto obj = TestPasses::genericPass(serial);
+        if (relevantDate.isValid()) {
+            obj.insert("relevantDate"_L1, relevantDate.toString(Qt::ISODateWithMs));
+        }
+        if (expirationDate.isValid()) {
+            obj.insert("expirationDate"_L1, expirationDate.toString(Qt::ISODateWithMs));
+        }
+        if (voided) {
+            obj.insert("voided"_L1, u"true"_s);
+        }
+        return std::unique_ptr<KPkPass::Pass>(KPkPass::Pass::fromData(TestPasses::makePass(obj)));
+    }
+
+private Q_SLOTS:
+    void testScheduling()
+    {
+        const auto now = QDateTime::currentDateTimeUtc();
+        auto relevant = makePass(u"relevant"_s, now.addMSecs(200), {});
+        auto expiring = makePass(u"expiring"_s, now.addMSecs(100), now.addMSecs(400));
+        auto voided = makePass(u"voided"_s, now.addSecs(3600), {}, true);
+        auto past = makePass(u"past"_s, now.addDays(-2), {});
+        auto future = makePass(u"future"_s, now.addDays(200), now.addDays(201));
+
+        KPkPass::PassScheduler scheduler;
+        QCOMPARE(scheduler.relevanceLeadTime(), 2h);
+        scheduler.setRelevanceInterval(0s, 1s);
+        QSignalSpy relevantSpy(&scheduler, &KPkPass::PassScheduler::passBecameRelevant);
+        QSignalSpy notRelevantSpy(&scheduler, &KPkPass::PassScheduler::passNoLongerRelevant);
+        QSignalSpy expiredSpy(&scheduler, &KPkPass::PassScheduler::passExpired);
+
+        scheduler.addPass(relevant.get());
+        scheduler.addPass(expiring.get());
+        scheduler.addPass(voided.get());
+        scheduler.addPass(past.get());
+        scheduler.addPass(future.get());
+        scheduler.addPass(future.get());
+
+        // voided passes expire right away
+        QVERIFY(expiredSpy.wait());
+        QCOMPARE(expiredSpy.at(0).at(0).value<KPkPass::Pass *>(), voided.get());
+        QVERIFY(!scheduler.isRelevant(voided.get()));
+
+        QTRY_COMPARE(relevantSpy.size(), 2);
+        QCOMPARE(relevantSpy.at(0).at(0).value<KPkPass::Pass *>(), expiring.get());
+        QCOMPARE(relevantSpy.at(1).at(0).value<KPkPass::Pass *>(), relevant.get());
+        QVERIFY(scheduler.isRelevant(relevant.get()));
+
+        // expiration ends relevance
+        QTRY_COMPARE(expiredSpy.size(), 2);
+        QCOMPARE(expiredSpy.at(1).at(0).value<KPkPass::Pass *>(), expiring.get());
+        QCOMPARE(notRelevantSpy.size(), 1);
+        QCOMPARE(notRelevantSpy.at(0).at(0).value<KPkPass::Pass *>(), expiring.get());
+        QVERIFY(!scheduler.isRelevant(expiring.get()));
+
+        QTRY_COMPARE_WITH_TIMEOUT(notRelevantSpy.size(), 2, 5000);
+        QCOMPARE(notRelevantSpy.at(1).at(0).value<KPkPass::Pass *>(), relevant.get());
+        QVERIFY(!scheduler.isRelevant(relevant.get()));
+
+        QCOMPARE(relevantSpy.size(), 2);
+        QCOMPARE(expiredSpy.size(), 2);
+    }
+
+    void testRemove()
+    {
+        const auto now = QDateTime::currentDateTimeUtc();
+        auto removed = makePass(u"removed"_s, now.addMSecs(100), {});
+        auto deleted = makePass(u"deleted"_s, now.addMSecs(100), {});
+        auto kept = makePass(u"kept"_s, now.addMSecs(200), {});
+
+        KPkPass::PassScheduler scheduler;
+        scheduler.setRelevanceInterval(0s, 60s);
+        QSignalSpy relevantSpy(&scheduler, &KPkPass::PassScheduler::passBecameRelevant);
+        scheduler.addPass(removed.get());
+        scheduler.addPass(deleted.get());
+        scheduler.addPass(kept.get());
+
+        scheduler.removePass(removed.get());
+        deleted.reset();
+
+        QVERIFY(relevantSpy.wait());
+        QCOMPARE(relevantSpy.size(), 1);
+        QCOMPARE(relevantSpy.at(0).at(0).value<KPkPass::Pass *>(), kept.get());
+    }
+};
+
+QTEST_GUILESS_MAIN(PassSchedulerTest)
+
+#include "passschedulertest.moc"
@@ -0,0 +1,270 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "passupdater.h"
+#include "testpasses.h"
+
+#include <QNetworkAccessManager>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+#include <QTimeZone>
+#include <QTimer>
+
+using namespace Qt::Literals;
+
+// minimal stand-in for a PassKit web service
+class FakeWebService : public QObject
+{
+    Q_OBJECT
+public:
+    explicit FakeWebService(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+        connect(&m_server, &QTcpServer::newConnection, this, [this]() {
+            while (auto socket = m_server.nextPendingConnection()) {
+                ++connectionCount;
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+                    handleData(socket);
+                });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+        m_server.listen(QHostAddress::LocalHost);
+    }
+
+    [[nodiscard]] QString url() const
+    {
+        return u"http://127.0.0.1:%1/ws"_s.arg(m_server.serverPort());
+    }
+
+    int connectionCount = 0;
+    int requestCount = 0;
+    int inFlight = 0;
+    int maxInFlight = 0;
+    QByteArray lastAuthorization;
+    QByteArray updatedPassData;
+
+private:
+    void handleData(QTcpSocket *socket)
+    {
+        auto &buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        qsizetype idx = 0;
+        while ((idx = buffer.indexOf("\r\n\r\n")) >= 0) {
+            const auto header = buffer.left(idx);
+            buffer.remove(0, idx + 4);
+            handleRequest(socket, header);
+        }
+    }
+
+    void handleRequest(QTcpSocket *socket, const QByteArray &header)
+    {
+        ++requestCount;
+        ++inFlight;
+        maxInFlight = std::max(maxInFlight, inFlight);
+
+        const auto lines = header.split('\n');
+        const auto path = lines.at(0).split(' ').at(1);
+        QHash<QByteArray, QByteArray> headers;
+        for (auto it = std::next(lines.begin()); it != lines.end(); ++it) {
+            const auto idx = (*it).indexOf(':');
+            if (idx > 0) {
+                headers.insert((*it).left(idx).trimmed().toLower(), (*it).mid(idx + 1).trimmed());
+            }
+        }
+        lastAuthorization = headers.value("authorization");
+
+        QByteArray response;
+        const auto serial = path.mid(path.lastIndexOf('/') + 1);
+        if (serial == "unchanged" && (headers.contains("if-modified-since") || headers.value("if-none-match") == "\"v1\"")) {
+            response = "HTTP/1.1 304 Not Modified\r\nContent-Length: 0\r\n\r\n";
+        } else if (serial == "unchanged" || serial == "changed" || serial == "swapped") {
+            response = "HTTP/1.1 200 OK\r\nContent-Type: application/vnd.apple.pkpass\r\nLast-Modified: Wed, 21 Oct 2026 07:28:00 GMT\r\nETag: \"v2\"\r\nContent-Length: "
+                + QByteArray::number(updatedPassData.size()) + "\r\n\r\n" + updatedPassData;
+        } else if (serial == "garbage") {
+            response = "HTTP/1.1 200 OK\r\nContent-Length: 7\r\n\r\ngarbage";
+        } else {
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        }
+
+        // delay responses a bit so concurrent requests overlap
+        QTimer::singleShot(50, socket, [this, socket, response]() {
+            --inFlight;
+            socket->write(response);
+        });
+    }
+
+    QTcpServer m_server;
+    QHash<QTcpSocket *, QByteArray> m_buffers;
+};
+
+class PassUpdaterTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QJsonObject passJson(const QString &serial, const QString &url)
+    {
+        auto obj = TestPasses::genericPass(serial);
+        obj.insert("webServiceURL"_L1, url);
+        obj.insert("authenticationToken"_L1, u"0123456789abcdef"_s);
+        return obj;
+    }
+
+    static std::unique_ptr<KPkPass::Pass> makePass(const QString &serial, const QString &url)
+    {
+        return std::unique_ptr<KPkPass::Pass>(KPkPass::Pass::fromData(TestPasses::makePass(passJson(serial, url))));
+    }
+
+private Q_SLOTS:
+    void testConditionalUpdate()
+    {
+        FakeWebService service;
+        auto updatedJson = passJson(u"changed"_s, service.url());
+        updatedJson.insert("organizationName"_L1, u"KDE e.V."_s);
+        service.updatedPassData = TestPasses::makePass(updatedJson);
+
+        auto changed = makePass(u"changed"_s, service.url());
+        auto unchanged = makePass(u"unchanged"_s, service.url());
+        auto unchangedEtag = makePass(u"unchanged"_s, service.url());
+        auto missing = makePass(u"missing"_s, service.url());
+        auto garbage = makePass(u"garbage"_s, service.url());
+        auto noUrl = std::unique_ptr<KPkPass::Pass>(KPkPass::Pass::fromData(TestPasses::makePass(TestPasses::genericPass(u"nourl"_s))));
+
+        KPkPass::PassUpdater updater;
+        QSignalSpy updatedSpy(&updater, &KPkPass::PassUpdater::passUpdated);
+        QSignalSpy unchangedSpy(&updater, &KPkPass::PassUpdater::passUnchanged);
+        QSignalSpy failedSpy(&updater, &KPkPass::PassUpdater::updateFailed);
+        QSignalSpy finishedSpy(&updater, &KPkPass::PassUpdater::finished);
+
+        KPkPass::Pass *keptPass = nullptr;
+        connect(&updater, &KPkPass::PassUpdater::passUpdated, this, [&keptPass](KPkPass::Pass *, KPkPass::Pass *updatedPass) {
+            QCOMPARE(updatedPass->organizationName(), u"KDE e.V."_s);
+            updatedPass->setParent(nullptr);
+            keptPass = updatedPass;
+        });
+
+        const auto lastModified = QDateTime({2026, 10, 1}, {12, 0}, QTimeZone::UTC);
+        updater.addPass(changed.get());
+        updater.addPass(unchanged.get(), lastModified);
+        updater.addPass(unchangedEtag.get(), QDateTime(), "\"v1\"");
+        updater.addPass(missing.get());
+        updater.addPass(garbage.get());
+        updater.addPass(noUrl.get());
+        QCOMPARE(updater.pendingCount(), 6);
+
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(updater.pendingCount(), 0);
+        QCOMPARE(service.requestCount, 5);
+        QCOMPARE(service.lastAuthorization, "ApplePass 0123456789abcdef");
+
+        QCOMPARE(updatedSpy.size(), 1);
+        QCOMPARE(updatedSpy.at(0).at(0).value<KPkPass::Pass *>(), changed.get());
+        QCOMPARE(updatedSpy.at(0).at(2).toDateTime(), QDateTime({2026, 10, 21}, {7, 28}, QTimeZone::UTC));
+        QCOMPARE(updatedSpy.at(0).at(3).toByteArray(), "\"v2\"");
+        std::unique_ptr<KPkPass::Pass> kept(keptPass);
+        QVERIFY(kept);
+        QCOMPARE(kept->serialNumber(), u"changed"_s);
+
+        QCOMPARE(unchangedSpy.size(), 2);
+        QCOMPARE(failedSpy.size(), 3);
+        QCOMPARE(finishedSpy.size(), 1);
+    }
+
+    void testConcurrency()
+    {
+        FakeWebService service;
+        std::vector<std::unique_ptr<KPkPass::Pass>> passes;
+        QNetworkAccessManager nam;
+        KPkPass::PassUpdater updater;
+        updater.setNetworkAccessManager(&nam);
+        updater.setMaximumConcurrentRequests(4);
+        QCOMPARE(updater.maximumConcurrentRequests(), 4);
+        QSignalSpy unchangedSpy(&updater, &KPkPass::PassUpdater::passUnchanged);
+        QSignalSpy finishedSpy(&updater, &KPkPass::PassUpdater::finished);
+
+        for (int i = 0; i < 20; ++i) {
+            passes.push_back(makePass(u"unchanged"_s, service.url()));
+            updater.addPass(passes.back().get(), QDateTime::currentDateTimeUtc());
+        }
+
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(unchangedSpy.size(), 20);
+        QCOMPARE(service.requestCount, 20);
+        QVERIFY(service.maxInFlight > 1);
+        QVERIFY(service.maxInFlight <= 4);
+        // connections are reused
+        QVERIFY(service.connectionCount < 20);
+    }
+
+    void testIdentityMismatch()
+    {
+        FakeWebService service;
+        service.updatedPassData = TestPasses::makePass(passJson(u"changed"_s, service.url()));
+        auto pass = makePass(u"swapped"_s, service.url());
+
+        KPkPass::PassUpdater updater;
+        QSignalSpy updatedSpy(&updater, &KPkPass::PassUpdater::passUpdated);
+        QSignalSpy failedSpy(&updater, &KPkPass::PassUpdater::updateFailed);
+        QSignalSpy finishedSpy(&updater, &KPkPass::PassUpdater::finished);
+        updater.addPass(pass.get());
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(service.requestCount, 1);
+        QCOMPARE(updatedSpy.size(), 0);
+        QCOMPARE(failedSpy.size(), 1);
+        QCOMPARE(failedSpy.at(0).at(0).value<KPkPass::Pass *>(), pass.get());
+        // the received pass isn't leaked to the updater either
+        QVERIFY(updater.findChildren<KPkPass::Pass *>().isEmpty());
+    }
+
+    void testChangeNetworkAccessManager()
+    {
+        FakeWebService service;
+        auto pass = makePass(u"unchanged"_s, service.url());
+        KPkPass::PassUpdater updater;
+        QSignalSpy unchangedSpy(&updater, &KPkPass::PassUpdater::passUnchanged);
+        QSignalSpy finishedSpy(&updater, &KPkPass::PassUpdater::finished);
+        updater.addPass(pass.get(), QDateTime::currentDateTimeUtc());
+        QCoreApplication::processEvents();
+        QCOMPARE(updater.pendingCount(), 1);
+
+        // would destroy the running reply of the internal network access manager
+        QNetworkAccessManager nam;
+        QTest::ignoreMessage(QtWarningMsg, "Can't change the network access manager while requests are running");
+        updater.setNetworkAccessManager(&nam);
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(unchangedSpy.size(), 1);
+        QCOMPARE(updater.pendingCount(), 0);
+
+        updater.setNetworkAccessManager(&nam);
+        updater.addPass(pass.get(), QDateTime::currentDateTimeUtc());
+        QVERIFY(finishedSpy.wait());
+        QCOMPARE(unchangedSpy.size(), 2);
+        QCOMPARE(service.requestCount, 2);
+    }
+
+    void testCancel()
+    {
+        FakeWebService service;
+        auto pass = makePass(u"changed"_s, service.url());
+        KPkPass::PassUpdater updater;
+        QSignalSpy updatedSpy(&updater, &KPkPass::PassUpdater::passUpdated);
+        QSignalSpy failedSpy(&updater, &KPkPass::PassUpdater::updateFailed);
+        QSignalSpy finishedSpy(&updater, &KPkPass::PassUpdater::finished);
+        updater.addPass(pass.get());
+        updater.cancel();
+        QCOMPARE(updater.pendingCount(), 0);
+        QVERIFY(!finishedSpy.wait(200));
+        QCOMPARE(updatedSpy.size(), 0);
+        QCOMPARE(failedSpy.size(), 0);
+    }
+};
+
+QTEST_GUILESS_MAIN(PassUpdaterTest)
+
+#include "passupdatertest.moc"
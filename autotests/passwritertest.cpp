@@ -0,0 +1,128 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "passwriter.h"
+#include "testpasses.h"
+
+#include <KZip>
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocale>
+#include <QTest>
+
+using namespace Qt::Literals;
+
+class PassWriterTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QByteArray readEntry(KZip &zip, const QString &path)
+    {
+        const auto file = zip.directory()->file(path);
+        return file ? file->data() : QByteArray();
+    }
+
+    static int encoding(KZip &zip, const QString &path)
+    {
+        const auto file = dynamic_cast<const KZipFileEntry *>(zip.directory()->file(path));
+        return file ? file->encoding() : -1;
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QLocale::setDefault(QLocale(u"en_US"_s));
+    }
+
+    void testRoundTrip()
+    {
+        auto passJson = TestPasses::genericPass(u"1234"_s);
+        passJson.insert("organizationName"_L1, u"orgName"_s);
+
+        QImage icon(29, 29, QImage::Format_ARGB32);
+        icon.fill(Qt::red);
+
+        QByteArray largeText;
+        for (int i = 0; i < 10000; ++i) {
+            largeText += "line " + QByteArray::number(i) + '\n';
+        }
+        QBuffer largeTextDev(&largeText);
+        QVERIFY(largeTextDev.open(QIODevice::ReadOnly));
+
+        QByteArray random(4096, Qt::Uninitialized);
+        quint32 seed = 42;
+        for (auto &c : random) {
+            seed = seed * 1103515245 + 12345;
+            c = char(seed >> 16);
+        }
+
+        QByteArray data;
+        {
+            QBuffer buffer(&data);
+            KPkPass::PassWriter writer(&buffer);
+            QVERIFY(writer.writePassJson(passJson));
+            QVERIFY(writer.writeCatalog(u"en"_s, {{u"orgName"_s, u"KDE \"e.V.\"\nBerlin\\"_s}}));
+            QVERIFY(writer.writeImage(u"icon"_s, icon));
+            QVERIFY(writer.writeImage(u"icon"_s, icon.scaled(58, 58), 2));
+            QVERIFY(writer.writeFile(u"large.txt"_s, &largeTextDev));
+            QVERIFY(writer.writeFile(u"random.bin"_s, random));
+            QVERIFY(writer.writeFile(u"forced.bin"_s, random, KPkPass::PassWriter::DeflateCompression));
+
+            QVERIFY(!writer.writeFile(u"pass.json"_s, "{}"_ba));
+            QVERIFY(!writer.errorString().isEmpty());
+            QVERIFY(!writer.writeFile(u"manifest.json"_s, "{}"_ba));
+
+            QVERIFY(writer.finish());
+            QVERIFY(!writer.writeFile(u"late.txt"_s, "too late"_ba));
+        }
+
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data));
+        QVERIFY(pass);
+        QCOMPARE(pass->serialNumber(), u"1234"_s);
+        QCOMPARE(pass->organizationName(), u"KDE \"e.V.\"\nBerlin\\"_s);
+        QCOMPARE(pass->icon().size(), QSize(29, 29));
+        QCOMPARE(pass->icon(2).size(), QSize(58, 58));
+
+        QBuffer buffer(&data);
+        KZip zip(&buffer);
+        QVERIFY(zip.open(QIODevice::ReadOnly));
+        QCOMPARE(readEntry(zip, u"large.txt"_s), largeText);
+        QCOMPARE(readEntry(zip, u"random.bin"_s), random);
+
+        // compression choice
+        QCOMPARE(encoding(zip, u"large.txt"_s), 8);
+        QCOMPARE(encoding(zip, u"icon.png"_s), 0);
+        QCOMPARE(encoding(zip, u"random.bin"_s), 0);
+        QCOMPARE(encoding(zip, u"forced.bin"_s), 8);
+
+        // manifest
+        const auto manifest = QJsonDocument::fromJson(readEntry(zip, u"manifest.json"_s)).object();
+        QCOMPARE(manifest.size(), 7);
+        for (auto it = manifest.begin(); it != manifest.end(); ++it) {
+            QCOMPARE(it.value().toString(), QString::fromLatin1(QCryptographicHash::hash(readEntry(zip, it.key()), QCryptographicHash::Sha1).toHex()));
+        }
+        QVERIFY(!manifest.contains("manifest.json"_L1));
+    }
+
+    void testInvalid()
+    {
+        QByteArray data;
+        QBuffer buffer(&data);
+        KPkPass::PassWriter writer(&buffer);
+        QVERIFY(writer.writeFile(u"icon.png"_s, "not really"_ba));
+        QVERIFY(!writer.finish());
+        QVERIFY(!writer.errorString().isEmpty());
+    }
+};
+
+QTEST_GUILESS_MAIN(PassWriterTest)
+
+#include "passwritertest.moc"
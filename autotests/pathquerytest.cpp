@@ -0,0 +1,177 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "pathquery.h"
+#include "testpasses.h"
+
+#include <QJsonArray>
+#include <QTest>
+
+#include <vector>
+
+using namespace Qt::Literals;
+
+class PathQueryTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QByteArray boardingPass(int n)
+    {
+        auto passJson = TestPasses::genericPass(QString::number(n));
+        passJson.remove("generic"_L1);
+        passJson.insert("boardingPass"_L1,
+                        QJsonObject{
+                            {u"transitType"_s, u"PKTransitTypeAir"_s},
+                            {u"primaryFields"_s,
+                             QJsonArray{
+                                 QJsonObject{{u"key"_s, u"from"_s}, {u"value"_s, u"TXL"_s}},
+                                 QJsonObject{{u"key"_s, u"to"_s}, {u"value"_s, u"LEJ"_s}},
+                             }},
+                        });
+        passJson.insert("semantics"_L1,
+                        QJsonObject{
+                            {u"flightNumber"_s, n},
+                            {u"seats"_s, QJsonArray{QJsonObject{{u"seatRow"_s, u"12"_s}, {u"seatNumber"_s, u"C"_s}}}},
+                        });
+        return TestPasses::makePass(passJson);
+    }
+
+    static std::vector<std::unique_ptr<KPkPass::Pass>> loadPasses(int count)
+    {
+        std::vector<std::unique_ptr<KPkPass::Pass>> passes;
+        for (int i = 0; i < count; ++i) {
+            passes.emplace_back(KPkPass::Pass::fromData(boardingPass(i)));
+        }
+        return passes;
+    }
+
+private Q_SLOTS:
+    void testParse_data()
+    {
+        QTest::addColumn<QString>("path");
+        QTest::addColumn<bool>("valid");
+        QTest::addColumn<bool>("wildcard");
+        QTest::newRow("key") << u"serialNumber"_s << true << false;
+        QTest::newRow("nested") << u"semantics.seats[0].seatNumber"_s << true << false;
+        QTest::newRow("wildcard") << u"boardingPass.primaryFields[*].value"_s << true << true;
+        QTest::newRow("nested-array") << u"a[1][*]"_s << true << true;
+        QTest::newRow("empty") << QString() << false << false;
+        QTest::newRow("empty-key") << u"a..b"_s << false << false;
+        QTest::newRow("trailing-dot") << u"a."_s << false << false;
+        QTest::newRow("leading-subscript") << u"[0]"_s << false << false;
+        QTest::newRow("unterminated") << u"a[0"_s << false << false;
+        QTest::newRow("negative") << u"a[-1]"_s << false << false;
+        QTest::newRow("empty-subscript") << u"a[]"_s << false << false;
+        QTest::newRow("garbage") << u"a[0]b"_s << false << false;
+    }
+
+    void testParse()
+    {
+        QFETCH(QString, path);
+        QFETCH(bool, valid);
+        QFETCH(bool, wildcard);
+
+        const KPkPass::PathQuery query(path);
+        QCOMPARE(query.isValid(), valid);
+        QCOMPARE(query.hasWildcard(), wildcard);
+        QCOMPARE(query.path(), path);
+    }
+
+    void testEvaluate()
+    {
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(boardingPass(42)));
+        QVERIFY(pass);
+
+        QCOMPARE(KPkPass::PathQuery(u"serialNumber").evaluate(pass.get()), QJsonValue(u"42"_s));
+        QCOMPARE(KPkPass::PathQuery(u"semantics.seats[0].seatNumber").evaluate(pass.get()), QJsonValue(u"C"_s));
+        QCOMPARE(KPkPass::PathQuery(u"semantics.flightNumber").evaluate(pass.get()), QJsonValue(42));
+        QCOMPARE(KPkPass::PathQuery(u"boardingPass.primaryFields[*].value").evaluate(pass.get()), QJsonValue(QJsonArray{u"TXL"_s, u"LEJ"_s}));
+        QCOMPARE(KPkPass::PathQuery(u"boardingPass.primaryFields[1]").evaluate(pass.get()).toObject().value("key"_L1), QJsonValue(u"to"_s));
+
+        // no match
+        QVERIFY(KPkPass::PathQuery(u"semantics.seats[1].seatNumber").evaluate(pass.get()).isUndefined());
+        QVERIFY(KPkPass::PathQuery(u"serialNumber.foo").evaluate(pass.get()).isUndefined());
+        QVERIFY(KPkPass::PathQuery(u"serialNumber[0]").evaluate(pass.get()).isUndefined());
+        QVERIFY(KPkPass::PathQuery(u"doesNotExist").evaluate(pass.get()).isUndefined());
+        QCOMPARE(KPkPass::PathQuery(u"doesNotExist[*]").evaluate(pass.get()), QJsonValue(QJsonArray()));
+        QCOMPARE(KPkPass::PathQuery(u"boardingPass.primaryFields[*].label").evaluate(pass.get()), QJsonValue(QJsonArray()));
+        QVERIFY(KPkPass::PathQuery().evaluate(pass.get()).isUndefined());
+        QVERIFY(KPkPass::PathQuery(u"serialNumber").evaluate(static_cast<const KPkPass::Pass *>(nullptr)).isUndefined());
+
+        // plain JSON
+        const QJsonValue json(QJsonObject{{u"a"_s, QJsonArray{QJsonArray{1, 2}, QJsonArray{3}}}});
+        QCOMPARE(KPkPass::PathQuery(u"a[*][*]").evaluate(json), QJsonValue(QJsonArray{1, 2, 3}));
+        QCOMPARE(KPkPass::PathQuery(u"a[0][1]").evaluate(json), QJsonValue(2));
+    }
+
+    void testColumns()
+    {
+        const auto passes = loadPasses(3);
+        QList<KPkPass::Pass *> passList;
+        for (const auto &pass : passes) {
+            passList.push_back(pass.get());
+        }
+        const QList<KPkPass::PathQuery> queries{
+            KPkPass::PathQuery(u"serialNumber"),
+            KPkPass::PathQuery(u"boardingPass.primaryFields[*].value"),
+            KPkPass::PathQuery(u"invalid["),
+        };
+
+        const auto columns = KPkPass::PathQuery::evaluate(queries, passList);
+        QCOMPARE(columns.size(), 3);
+        for (const auto &column : columns) {
+            QCOMPARE(column.size(), 3);
+        }
+        QCOMPARE(columns[0][0], QJsonValue(u"0"_s));
+        QCOMPARE(columns[0][2], QJsonValue(u"2"_s));
+        QCOMPARE(columns[1][1], QJsonValue(QJsonArray{u"TXL"_s, u"LEJ"_s}));
+        QVERIFY(columns[2][0].isUndefined());
+
+        QVERIFY(KPkPass::PathQuery::evaluate({}, passList).isEmpty());
+        QCOMPARE(KPkPass::PathQuery::evaluate(queries, {}).size(), 3);
+    }
+
+    void benchmarkPathQuery()
+    {
+        const auto passes = loadPasses(500);
+        QList<KPkPass::Pass *> passList;
+        for (const auto &pass : passes) {
+            passList.push_back(pass.get());
+        }
+        const QList<KPkPass::PathQuery> queries{
+            KPkPass::PathQuery(u"boardingPass.primaryFields[*].value"),
+            KPkPass::PathQuery(u"semantics.seats[0].seatNumber"),
+        };
+        QBENCHMARK {
+            const auto columns = KPkPass::PathQuery::evaluate(queries, passList);
+            QCOMPARE(columns[1].size(), passList.size());
+        }
+    }
+
+    void benchmarkHandWritten()
+    {
+        const auto passes = loadPasses(500);
+        QBENCHMARK {
+            QList<QJsonValue> values;
+            QList<QJsonValue> seatNumbers;
+            for (const auto &pass : passes) {
+                QJsonArray fieldValues;
+                const auto fields = pass->rawValue("boardingPass"_L1).toObject().value("primaryFields"_L1).toArray();
+                for (const auto &field : fields) {
+                    fieldValues.push_back(field.toObject().value("value"_L1));
+                }
+                values.push_back(fieldValues);
+                seatNumbers.push_back(pass->rawValue("semantics"_L1).toObject().value("seats"_L1).toArray().at(0).toObject().value("seatNumber"_L1));
+            }
+            QCOMPARE(seatNumbers.size(), (qsizetype)passes.size());
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(PathQueryTest)
+
+#include "pathquerytest.moc"
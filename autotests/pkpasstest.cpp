@@ -7,14 +7,25 @@
 #include "barcode.h"
 #include "boardingpass.h"
 #include "location.h"
+#include "passassets.h"
+#include "passstyle.h"
 #include "seat.h"
+#include "semantictags.h"
+#include "testpasses.h"
 
+#include <QBuffer>
+#include <QImage>
 #include <QJsonObject>
 #include <QLocale>
+#include <QMetaProperty>
+#include <QSignalSpy>
 #include <QTest>
 #include <QTimeZone>
 
+#include <atomic>
 #include <cmath>
+#include <thread>
+#include <vector>
 
 using namespace Qt::Literals;
 
@@ -67,6 +78,7 @@ private Q_SLOTS:
         QCOMPARE(pass->auxiliaryFields().size(), 4);
         QCOMPARE(pass->auxiliaryFieldsInRow(0).size(), 4);
         QCOMPARE(pass->auxiliaryFieldsInRow(1).size(), 0);
+        QCOMPARE(pass->auxiliaryFieldsInRow(-1).size(), 4);
 
         auto boardingPass = dynamic_cast<KPkPass::BoardingPass *>(pass.get());
         QVERIFY(boardingPass);
@@ -127,6 +139,7 @@ private Q_SLOTS:
         const auto styles = pass->preferredStyleSchemes();
         QCOMPARE(styles.size(), 2);
         QCOMPARE(styles.front(), "semanticBoardingPass"_L1);
+        QCOMPARE(pass->style().preferredStyleSchemes(), styles);
 
         const auto seats = pass->seats();
         QCOMPARE(seats.size(), 1);
@@ -136,6 +149,196 @@ private Q_SLOTS:
         QCOMPARE(seat.seatNumber(), "C"_L1);
         QCOMPARE(seat.hasSeatSection(), false);
         QCOMPARE(seat.asAirplaneSeat(), "52C"_L1);
+
+        const auto semantics = pass->semantics();
+        QVERIFY(!semantics.isEmpty());
+        QCOMPARE(semantics.airlineCode(), "UA"_L1);
+        QCOMPARE(semantics.flightNumber(), 987);
+        QCOMPARE(semantics.boardingGroup(), "2"_L1);
+        QCOMPARE(semantics.confirmationNumber(), "H8JP44"_L1);
+        QCOMPARE(semantics.passengerName(), "Lani Martinez"_L1);
+        QCOMPARE(semantics.currentDepartureDate(), QDateTime({2025, 12, 9}, {23, 0}, QTimeZone::UTC));
+        QCOMPARE(semantics.currentArrivalDate(), QDateTime({2025, 12, 10}, {7, 1}, QTimeZone::UTC));
+        QCOMPARE(semantics.departure().airportCode(), "ORD"_L1);
+        QCOMPARE(semantics.departure().airportName(), "O'Hare International Airport"_L1);
+        QCOMPARE(semantics.departure().gate(), "C10"_L1);
+        QCOMPARE(semantics.departure().terminal(), "1"_L1);
+        QVERIFY(semantics.departure().hasCoordinate());
+        QCOMPARE(semantics.departure().latitude(), 41.9742);
+        QCOMPARE(semantics.destination().airportCode(), "CDG"_L1);
+        QVERIFY(semantics.destination().gate().isEmpty());
+        QCOMPARE(semantics.seats().size(), 1);
+        QCOMPARE(semantics.seats().front().seatRow(), "52"_L1);
+        QVERIFY(semantics.eventName().isEmpty());
+        QVERIFY(!semantics.eventStartDate().isValid());
+    }
+
+    void testLanguageSwitching()
+    {
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        QVERIFY(pass);
+        QCOMPARE(pass->languages(), (QStringList{u"de"_s, u"en"_s}));
+        QVERIFY(pass->language().isEmpty());
+        QCOMPARE(pass->description(), "KDE Bordkarte"_L1);
+
+        pass->setLanguage(u"en_GB"_s);
+        QCOMPARE(pass->language(), "en_GB"_L1);
+        QCOMPARE(pass->description(), "KDE Boarding pass"_L1);
+        QCOMPARE(pass->headerFields().at(0).label(), "Seat"_L1);
+
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(pass->description(), "KDE Bordkarte"_L1);
+
+        // localized properties notify language changes
+        const auto prop = pass->metaObject()->property(pass->metaObject()->indexOfProperty("description"));
+        QVERIFY(prop.hasNotifySignal());
+        QCOMPARE(prop.notifySignal(), QMetaMethod::fromSignal(&KPkPass::Pass::languageChanged));
+        const auto semanticsProp = pass->metaObject()->property(pass->metaObject()->indexOfProperty("semantics"));
+        QCOMPARE(semanticsProp.notifySignal(), QMetaMethod::fromSignal(&KPkPass::Pass::languageChanged));
+        QSignalSpy spy(pass.get(), &KPkPass::Pass::languageChanged);
+        pass->setLanguage(u"en"_s);
+        QCOMPARE(spy.size(), 1);
+        QCOMPARE(prop.read(pass.get()).toString(), "KDE Boarding pass"_L1);
+        pass->setLanguage(u"en"_s);
+        QCOMPARE(spy.size(), 1);
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(spy.size(), 2);
+        QCOMPARE(prop.read(pass.get()).toString(), "KDE Bordkarte"_L1);
+
+        // unavailable languages fall back to English
+        pass->setLanguage(u"fr"_s);
+        QCOMPARE(pass->description(), "KDE Boarding pass"_L1);
+
+        // global default applies to passes without an explicit language
+        pass->setLanguage({});
+        KPkPass::Pass::setDefaultLanguage(u"en-US"_s);
+        QCOMPARE(KPkPass::Pass::defaultLanguage(), "en-US"_L1);
+        QCOMPARE(pass->description(), "KDE Boarding pass"_L1);
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(pass->description(), "KDE Bordkarte"_L1);
+        pass->setLanguage({});
+        KPkPass::Pass::setDefaultLanguage({});
+        QCOMPARE(pass->description(), "KDE Bordkarte"_L1);
+    }
+
+    void testConcurrentLanguages()
+    {
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        QVERIFY(pass);
+        const auto key = pass->rawValue("description"_L1).toString();
+        QCOMPARE(pass->lookupMessage(key, u"fr"_s), "KDE Boarding pass"_L1);
+
+        // one pass used for several languages at the same time, catalogs get parsed concurrently
+        pass.reset(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        std::atomic<int> failures = 0;
+        std::vector<std::thread> threads;
+        for (int i = 0; i < 8; ++i) {
+            threads.emplace_back([&pass, &key, &failures, i]() {
+                const auto german = i % 2 == 0;
+                for (int j = 0; j < 200; ++j) {
+                    const auto msg = pass->lookupMessage(key, german ? u"de"_s : u"en"_s);
+                    if (msg != (german ? "KDE Bordkarte"_L1 : "KDE Boarding pass"_L1)) {
+                        ++failures;
+                    }
+                }
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+        QCOMPARE(failures.load(), 0);
+        QVERIFY(pass->language().isEmpty());
+    }
+
+    void testStyle()
+    {
+        const KPkPass::PassStyle empty;
+        QVERIFY(!empty.hasBackgroundColor());
+        QVERIFY(!empty.labelColor().isValid());
+        QCOMPARE(empty.images(), KPkPass::PassStyle::NoImage);
+
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        QVERIFY(pass);
+        const auto style = pass->style();
+        QVERIFY(style.hasBackgroundColor());
+        QCOMPARE(style.backgroundColor(), QColor(61, 174, 233));
+        QCOMPARE(style.backgroundColor(), pass->backgroundColor());
+        QVERIFY(style.hasForegroundColor());
+        QCOMPARE(style.foregroundColor(), pass->foregroundColor());
+        QVERIFY(style.hasLabelColor());
+        QVERIFY(style.labelColor().isValid());
+        QCOMPARE(style.labelColor(), pass->labelColor());
+        QVERIFY(style.preferredStyleSchemes().isEmpty());
+
+        QVERIFY(style.hasImage(KPkPass::PassStyle::Logo));
+        QVERIFY(!style.hasImage(KPkPass::PassStyle::Icon));
+        QCOMPARE(style.hasImage(KPkPass::PassStyle::Strip), pass->hasStrip());
+        QCOMPARE(KPkPass::PassStyle::imageName(KPkPass::PassStyle::PrimaryLogo), "primaryLogo"_L1);
+        QVERIFY(KPkPass::PassStyle::imageName(KPkPass::PassStyle::NoImage).isEmpty());
+    }
+
+    void testStyleImageVariants()
+    {
+        QByteArray png;
+        {
+            QBuffer buffer(&png);
+            QVERIFY(buffer.open(QIODevice::WriteOnly));
+            QImage img(4, 4, QImage::Format_ARGB32);
+            img.fill(Qt::red);
+            QVERIFY(img.save(&buffer, "PNG"));
+        }
+        const auto data = TestPasses::makePass(TestPasses::genericPass(u"1"_s),
+                                               {{u"icon.dark.png"_s, png}, {u"strip@2x.png"_s, png}, {u"thumbnail.dark@2x.png"_s, png}});
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data));
+        QVERIFY(pass);
+
+        // the style and the image accessors need to agree on which images exist
+        const auto style = pass->style();
+        QVERIFY(style.hasImage(KPkPass::PassStyle::Icon));
+        QCOMPARE(style.hasImage(KPkPass::PassStyle::Icon), pass->hasIcon());
+        QVERIFY(style.hasImage(KPkPass::PassStyle::Strip));
+        QCOMPARE(style.hasImage(KPkPass::PassStyle::Strip), pass->hasStrip());
+        QVERIFY(style.hasImage(KPkPass::PassStyle::Thumbnail));
+        QVERIFY(!style.hasImage(KPkPass::PassStyle::Logo));
+        QCOMPARE(style.hasImage(KPkPass::PassStyle::Logo), pass->hasLogo());
+    }
+
+    void testAssets()
+    {
+        QVERIFY(!KPkPass::PassAssets().isValid());
+        QVERIFY(KPkPass::PassAssets().image(u"logo"_s).isNull());
+
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s));
+        QVERIFY(pass);
+        auto assets = pass->assets();
+        QVERIFY(assets.isValid());
+        QVERIFY(assets.hasImage(u"logo"_s));
+        QVERIFY(!assets.hasImage(u"icon"_s));
+
+        // shares the image cache with the pass
+        const auto logo = pass->logo(2);
+        QVERIFY(!logo.isNull());
+        QCOMPARE(assets.image(u"logo"_s, 2).cacheKey(), logo.cacheKey());
+
+        // usable from other threads, and after the pass is gone
+        std::vector<std::thread> threads;
+        std::atomic<int> decoded = 0;
+        for (int i = 0; i < 4; ++i) {
+            threads.emplace_back([assets, i, &decoded]() {
+                if (!assets.image(u"logo"_s, i % 3 + 1).isNull()) {
+                    ++decoded;
+                }
+            });
+        }
+        for (auto &t : threads) {
+            t.join();
+        }
+        QCOMPARE(decoded, 4);
+
+        pass.reset();
+        QVERIFY(assets.hasImage(u"logo"_s));
+        QCOMPARE(assets.image(u"logo"_s, 2).cacheKey(), logo.cacheKey());
+        QVERIFY(assets.image(u"I don't exist"_s).isNull());
     }
 };
 
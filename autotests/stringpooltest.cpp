@@ -0,0 +1,161 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "passwriter.h"
+#include "stringpool_p.h"
+#include "testpasses.h"
+
+#include <QBuffer>
+#include <QLocale>
+#include <QTest>
+
+using namespace Qt::Literals;
+
+class StringPoolTest : public QObject
+{
+    Q_OBJECT
+private:
+    static QByteArray makePass(int issuer, int serial, const QHash<QString, QString> &catalog)
+    {
+        QByteArray data;
+        QBuffer buffer(&data);
+        KPkPass::PassWriter writer(&buffer);
+        auto passJson = TestPasses::genericPass(QString::number(serial), u"pass.org.kde.issuer%1"_s.arg(issuer));
+        passJson.insert("description"_L1, u"description"_s);
+        writer.writePassJson(passJson);
+        writer.writeCatalog(u"en"_s, catalog);
+        writer.finish();
+        return data;
+    }
+
+private Q_SLOTS:
+    void initTestCase()
+    {
+        QLocale::setDefault(QLocale(u"en_US"_s));
+    }
+
+    void testIntern()
+    {
+        const auto before = KPkPass::StringPool::size();
+        const QString s1 = u"StringPoolTest"_s;
+        const QString s2 = QString::fromUtf8("StringPoolTest");
+        QVERIFY(s1.constData() != s2.constData());
+
+        const auto i1 = KPkPass::StringPool::intern(s1);
+        const auto i2 = KPkPass::StringPool::intern(s2);
+        const auto i3 = KPkPass::StringPool::intern(QStringView(u"xxStringPoolTestxx").mid(2, 14));
+        QCOMPARE(i1, s1);
+        QCOMPARE(i1.constData(), i2.constData());
+        QCOMPARE(i1.constData(), i3.constData());
+        QCOMPARE(KPkPass::StringPool::size(), before + 1);
+        QVERIFY(KPkPass::StringPool::intern(QString()).isEmpty());
+        QCOMPARE(KPkPass::StringPool::size(), before + 1);
+
+        // still referenced
+        KPkPass::StringPool::purge();
+        QCOMPARE(KPkPass::StringPool::intern(u"StringPoolTest"_s).constData(), i1.constData());
+    }
+
+    void testPurge()
+    {
+        {
+            const auto s = KPkPass::StringPool::intern(u"purge me"_s);
+            QVERIFY(!s.isEmpty());
+        }
+        const auto before = KPkPass::StringPool::size();
+        const auto beforeData = KPkPass::StringPool::dataSize();
+        KPkPass::StringPool::purge();
+        QVERIFY(KPkPass::StringPool::size() < before);
+        QVERIFY(KPkPass::StringPool::dataSize() < beforeData);
+    }
+
+    void testAutoPurge()
+    {
+        KPkPass::StringPool::purge();
+
+        // catalog content unique to each pass, such as passenger names
+        std::vector<std::unique_ptr<KPkPass::Pass>> passes;
+        for (int i = 0; i < 1000; ++i) {
+            QHash<QString, QString> catalog;
+            for (int j = 0; j < 10; ++j) {
+                catalog.insert(u"unique%1"_s.arg(j), u"Passenger %1/%2"_s.arg(i).arg(j));
+            }
+            passes.emplace_back(KPkPass::Pass::fromData(makePass(0, i, catalog)));
+            QVERIFY(passes.back());
+            QCOMPARE(passes.back()->lookupMessage(u"unique0"_s), u"Passenger %1/0"_s.arg(i));
+        }
+        const auto peakSize = KPkPass::StringPool::size();
+        const auto peakDataSize = KPkPass::StringPool::dataSize();
+        QVERIFY(peakSize > 10000);
+
+        // once the passes are gone, further interning evicts their content without an explicit purge
+        passes.clear();
+        for (qsizetype i = 0; i < 2 * peakSize && KPkPass::StringPool::size() >= peakSize; ++i) {
+            (void)KPkPass::StringPool::intern(u"temporary %1"_s.arg(i));
+        }
+        QVERIFY(KPkPass::StringPool::size() < peakSize / 2);
+        QVERIFY(KPkPass::StringPool::dataSize() < peakDataSize / 2);
+    }
+
+    void testPassCorpus()
+    {
+        constexpr int IssuerCount = 10;
+        constexpr int PassCount = 10000;
+        constexpr int MessageCount = 30;
+
+        std::vector<QHash<QString, QString>> catalogs;
+        for (int i = 0; i < IssuerCount; ++i) {
+            QHash<QString, QString> catalog;
+            catalog.insert(u"description"_s, u"Boarding pass of issuer %1"_s.arg(i));
+            for (int j = 0; j < MessageCount; ++j) {
+                catalog.insert(u"message%1"_s.arg(j), u"Translated message %1 of issuer %2"_s.arg(j).arg(i % 3));
+            }
+            catalogs.push_back(std::move(catalog));
+        }
+        std::vector<QByteArray> passData;
+        for (int i = 0; i < IssuerCount; ++i) {
+            passData.push_back(makePass(i, i, catalogs[i]));
+        }
+
+        KPkPass::StringPool::purge();
+        const auto poolSizeBefore = KPkPass::StringPool::dataSize();
+
+        // the catalog data as it would be held by each pass individually
+        qsizetype unsharedSize = 0;
+        std::vector<std::unique_ptr<KPkPass::Pass>> passes;
+        passes.reserve(PassCount);
+        for (int i = 0; i < PassCount; ++i) {
+            passes.emplace_back(KPkPass::Pass::fromData(passData[i % IssuerCount]));
+            QCOMPARE(passes.back()->description(), u"Boarding pass of issuer %1"_s.arg(i % IssuerCount));
+            const auto &catalog = catalogs[i % IssuerCount];
+            for (auto it = catalog.begin(); it != catalog.end(); ++it) {
+                unsharedSize += (it.key().size() + it.value().size()) * (qsizetype)sizeof(QChar);
+            }
+        }
+
+        const auto sharedSize = KPkPass::StringPool::dataSize() - poolSizeBefore;
+        qInfo() << "catalog string data:" << unsharedSize << "bytes unshared," << sharedSize << "bytes interned";
+        QVERIFY(sharedSize > 0);
+        QVERIFY(sharedSize * 100 < unsharedSize);
+
+        // identical messages share their data across passes
+        {
+            const auto m1 = passes[0]->lookupMessage(u"message1"_s);
+            const auto m2 = passes[3]->lookupMessage(u"message1"_s);
+            QCOMPARE(m1, m2);
+            QCOMPARE(m1.constData(), m2.constData());
+        }
+
+        passes.clear();
+        KPkPass::StringPool::purge();
+        QCOMPARE(KPkPass::StringPool::dataSize(), poolSizeBefore);
+    }
+};
+
+QTEST_GUILESS_MAIN(StringPoolTest)
+
+#include "stringpooltest.moc"
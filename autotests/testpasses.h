@@ -0,0 +1,44 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#pragma once
+
+#include <KZip>
+
+#include <QBuffer>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+// helpers for creating synthetic pkpass files in tests
+namespace TestPasses
+{
+inline QJsonObject genericPass(const QString &serialNumber, const QString &passTypeIdentifier = QStringLiteral("pass.org.kde.test"))
+{
+    return QJsonObject{
+        {QStringLiteral("formatVersion"), 1},
+        {QStringLiteral("passTypeIdentifier"), passTypeIdentifier},
+        {QStringLiteral("serialNumber"), serialNumber},
+        {QStringLiteral("generic"), QJsonObject()},
+    };
+}
+
+inline QByteArray makePass(const QJsonObject &passJson, const QHash<QString, QByteArray> &files = {})
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    KZip zip(&buffer);
+    if (!zip.open(QIODevice::WriteOnly)) {
+        return {};
+    }
+    zip.writeFile(QStringLiteral("pass.json"), QJsonDocument(passJson).toJson());
+    for (auto it = files.begin(); it != files.end(); ++it) {
+        zip.writeFile(it.key(), it.value());
+    }
+    zip.close();
+    return data;
+}
+}
@@ -0,0 +1,141 @@
+/*
+    SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+
+    SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "testpasses.h"
+#include "tracer.h"
+
+#include <QFileInfo>
+#include <QImage>
+#include <QMutex>
+#include <QTest>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Qt::Literals;
+
+namespace
+{
+struct TraceEvent {
+    KPkPass::Tracer::Event event;
+    quintptr pass;
+    qint64 size;
+    qint64 duration;
+};
+
+class RecordingTracer : public KPkPass::Tracer
+{
+public:
+    void trace(Event event, quintptr pass, qint64 size, qint64 duration) override
+    {
+        QMutexLocker locker(&mutex);
+        events.push_back({event, pass, size, duration});
+    }
+
+    [[nodiscard]] std::vector<TraceEvent> eventsOfType(Event type)
+    {
+        QMutexLocker locker(&mutex);
+        std::vector<TraceEvent> result;
+        std::copy_if(events.begin(), events.end(), std::back_inserter(result), [type](const auto &e) {
+            return e.event == type;
+        });
+        return result;
+    }
+
+    QMutex mutex;
+    std::vector<TraceEvent> events;
+};
+}
+
+class TracerTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testPipeline()
+    {
+        const auto fileName = u"" SOURCE_DIR "/data/boardingpass-v1.pkpass"_s;
+        RecordingTracer tracer;
+        KPkPass::Tracer::install(&tracer);
+        QCOMPARE(KPkPass::Tracer::installed(), &tracer);
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromFile(fileName));
+        QVERIFY(pass);
+        pass->setLanguage(u"de"_s);
+        QCOMPARE(pass->description(), "KDE Bordkarte"_L1);
+        QVERIFY(!pass->logo().isNull());
+        QVERIFY(!pass->logo().isNull());
+        KPkPass::Tracer::install(nullptr);
+        QCOMPARE(KPkPass::Tracer::installed(), nullptr);
+
+        if (!KPkPass::Tracer::isAvailable()) {
+            QVERIFY(tracer.events.empty());
+            QSKIP("Built without KPKPASS_TRACING.");
+        }
+
+        const auto load = tracer.eventsOfType(KPkPass::Tracer::PassLoad);
+        QCOMPARE(load.size(), 1u);
+        QCOMPARE(load[0].size, QFileInfo(fileName).size());
+        QVERIFY(load[0].duration > 0);
+        const auto passId = load[0].pass;
+        for (const auto &e : tracer.events) {
+            QCOMPARE(e.pass, passId);
+            QVERIFY(e.duration >= 0);
+        }
+
+        QCOMPARE(tracer.eventsOfType(KPkPass::Tracer::ArchiveOpen).size(), 1u);
+        const auto extract = tracer.eventsOfType(KPkPass::Tracer::PassJsonExtract);
+        QCOMPARE(extract.size(), 1u);
+        QVERIFY(extract[0].size > 0);
+        const auto parse = tracer.eventsOfType(KPkPass::Tracer::JsonParse);
+        QCOMPARE(parse.size(), 1u);
+        QCOMPARE(parse[0].size, extract[0].size);
+        QVERIFY(tracer.eventsOfType(KPkPass::Tracer::JsonRepair).empty());
+
+        const auto lookup = tracer.eventsOfType(KPkPass::Tracer::CatalogLookup);
+        QCOMPARE(lookup.size(), 1u);
+        QVERIFY(lookup[0].size > 0);
+        const auto catalogs = tracer.eventsOfType(KPkPass::Tracer::CatalogParse);
+        QCOMPARE(catalogs.size(), 1u);
+        QVERIFY(catalogs[0].size > 0);
+
+        const auto decode = tracer.eventsOfType(KPkPass::Tracer::ImageDecode);
+        QCOMPARE(decode.size(), 1u);
+        QVERIFY(decode[0].size > 0);
+        const auto hits = tracer.eventsOfType(KPkPass::Tracer::ImageCacheHit);
+        QCOMPARE(hits.size(), 1u);
+        QCOMPARE(hits[0].duration, qint64(0));
+    }
+
+    void testRepair()
+    {
+        // trailing comma in an object, fixed by the syntax error workarounds
+        QByteArray data;
+        {
+            QBuffer buffer(&data);
+            KZip zip(&buffer);
+            QVERIFY(zip.open(QIODevice::WriteOnly));
+            zip.writeFile(u"pass.json"_s, R"({"formatVersion": 1, "serialNumber": "1", "generic": {"primaryFields": []},})");
+            zip.close();
+        }
+
+        RecordingTracer tracer;
+        KPkPass::Tracer::install(&tracer);
+        std::unique_ptr<KPkPass::Pass> pass(KPkPass::Pass::fromData(data));
+        KPkPass::Tracer::install(nullptr);
+        QVERIFY(pass);
+        QCOMPARE(pass->serialNumber(), "1"_L1);
+        if (!KPkPass::Tracer::isAvailable()) {
+            QSKIP("Built without KPKPASS_TRACING.");
+        }
+        const auto repair = tracer.eventsOfType(KPkPass::Tracer::JsonRepair);
+        QCOMPARE(repair.size(), 1u);
+        QCOMPARE(repair[0].size, tracer.eventsOfType(KPkPass::Tracer::JsonParse).at(0).size);
+    }
+};
+
+QTEST_GUILESS_MAIN(TracerTest)
+
+#include "tracertest.moc"
@@ -0,0 +1,133 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "archivereader_p.h"
+#include "logging.h"
+
+#include <KZip>
+
+#include <QIODevice>
+
+#include <algorithm>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+ArchiveReader::~ArchiveReader() = default;
+
+std::unique_ptr<ArchiveReader> ArchiveReader::create(LoadOptions::ArchiveBackend backend)
+{
+    switch (backend) {
+    case LoadOptions::BuiltinBackend:
+        return std::make_unique<ZipReader>();
+    case LoadOptions::KArchiveBackend:
+        return std::make_unique<KArchiveReader>();
+    }
+    return {};
+}
+
+const std::vector<ArchiveReader::File> &ArchiveReader::files() const
+{
+    return m_files;
+}
+
+qsizetype ArchiveReader::indexOf(QStringView path) const
+{
+    const auto it = std::find_if(m_files.begin(), m_files.end(), [path](const auto &file) {
+        return file.path == path;
+    });
+    return it == m_files.end() ? -1 : std::distance(m_files.begin(), it);
+}
+
+QStringList ArchiveReader::topLevelEntries() const
+{
+    QStringList entries;
+    for (const auto &file : m_files) {
+        const auto idx = file.path.indexOf('/'_L1);
+        auto name = idx < 0 ? file.path : file.path.left(idx);
+        if (!name.isEmpty() && !entries.contains(name)) {
+            entries.push_back(std::move(name));
+        }
+    }
+    return entries;
+}
+
+KArchiveReader::~KArchiveReader() = default;
+
+static qsizetype collectFiles(const KArchiveDirectory *dir,
+                              const QString &prefix,
+                              std::vector<ArchiveReader::File> &files,
+                              std::vector<const KArchiveFile *> &entries)
+{
+    const auto names = dir->entries();
+    auto count = names.size();
+    for (const auto &name : names) {
+        const auto entry = dir->entry(name);
+        if (!entry) {
+            continue;
+        }
+        if (entry->isDirectory()) {
+            count += collectFiles(static_cast<const KArchiveDirectory *>(entry), prefix + name + '/'_L1, files, entries);
+        } else if (entry->isFile()) {
+            const auto file = static_cast<const KArchiveFile *>(entry);
+            files.push_back({prefix + name, file->size()});
+            entries.push_back(file);
+        }
+    }
+    return count;
+}
+
+bool KArchiveReader::open(QIODevice *device)
+{
+    m_zip = std::make_unique<KZip>(device);
+    if (!m_zip->open(QIODevice::ReadOnly)) {
+        qCWarning(Log) << "Failed to open ZIP file" << m_zip->errorString();
+        return false;
+    }
+    m_entryCount = collectFiles(m_zip->directory(), QString(), m_files, m_entries);
+    return true;
+}
+
+qsizetype KArchiveReader::entryCount() const
+{
+    return m_entryCount;
+}
+
+LoadOptions::Error KArchiveReader::read(qsizetype index, QByteArray &data, qint64 maximumSize)
+{
+    data.clear();
+    const auto file = m_entries[index];
+    const auto exceedsLimit = [maximumSize](qint64 size) {
+        return maximumSize >= 0 && size > maximumSize;
+    };
+    // the declared size allows to fail early, but can't be trusted, so we check again while decompressing
+    if (exceedsLimit(file->size())) {
+        return LoadOptions::ResourceLimitExceeded;
+    }
+
+    std::unique_ptr<QIODevice> dev(file->createDevice());
+    if (!dev) {
+        return LoadOptions::InvalidArchive;
+    }
+    data.reserve(file->size());
+    char chunk[16384];
+    while (true) {
+        const auto n = dev->read(chunk, sizeof(chunk));
+        if (n < 0) {
+            qCWarning(Log) << "Failed to decompress" << file->name() << dev->errorString();
+            data.clear();
+            return LoadOptions::InvalidArchive;
+        }
+        if (n == 0) {
+            break;
+        }
+        if (exceedsLimit(data.size() + n)) {
+            data.clear();
+            return LoadOptions::ResourceLimitExceeded;
+        }
+        data.append(chunk, n);
+    }
+    return LoadOptions::NoError;
+}
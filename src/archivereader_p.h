@@ -0,0 +1,103 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_ARCHIVEREADER_P_H
+#define KPKPASS_ARCHIVEREADER_P_H
+
+#include "loadoptions.h"
+#include "zipdirectory_p.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <optional>
+#include <vector>
+
+class KArchiveFile;
+class KZip;
+class QIODevice;
+
+namespace KPkPass
+{
+
+/** Read-only access to the files in a pass archive, independent of the ZIP implementation.
+ *  Files are identified by their index in files(), directories are only implied by the file paths.
+ */
+class ArchiveReader
+{
+public:
+    virtual ~ArchiveReader();
+
+    /** Creates a reader for @p backend. */
+    [[nodiscard]] static std::unique_ptr<ArchiveReader> create(LoadOptions::ArchiveBackend backend);
+
+    /** Opens the archive in @p device, which has to outlive the reader. */
+    [[nodiscard]] virtual bool open(QIODevice *device) = 0;
+    /** Number of archive entries, including directories. */
+    [[nodiscard]] virtual qsizetype entryCount() const = 0;
+    /** Decompresses file @p index into @p data.
+     *  Fails with LoadOptions::ResourceLimitExceeded if that is more than @p maximumSize bytes,
+     *  unless @p maximumSize is negative.
+     */
+    [[nodiscard]] virtual LoadOptions::Error read(qsizetype index, QByteArray &data, qint64 maximumSize) = 0;
+
+    struct File {
+        QString path;
+        /** Declared decompressed size, this can't be trusted. */
+        qint64 size = 0;
+    };
+    [[nodiscard]] const std::vector<File> &files() const;
+    /** Index of the file with @p path, or @c -1 if there is none. */
+    [[nodiscard]] qsizetype indexOf(QStringView path) const;
+    /** Names of the top-level files and directories. */
+    [[nodiscard]] QStringList topLevelEntries() const;
+
+protected:
+    std::vector<File> m_files;
+};
+
+/** Reader based on KArchive's KZip. */
+class KArchiveReader : public ArchiveReader
+{
+public:
+    ~KArchiveReader() override;
+    [[nodiscard]] bool open(QIODevice *device) override;
+    [[nodiscard]] qsizetype entryCount() const override;
+    [[nodiscard]] LoadOptions::Error read(qsizetype index, QByteArray &data, qint64 maximumSize) override;
+
+private:
+    std::unique_ptr<KZip> m_zip;
+    std::vector<const KArchiveFile *> m_entries;
+    qsizetype m_entryCount = 0;
+};
+
+/** Minimal built-in reader, parsing the central directory into a flat table
+ *  and inflating entries in a single pass into a buffer of the declared size.
+ *  In-memory archives are read without copying, for anything else only the
+ *  requested entries are read. ZIP64 and encrypted archives are not supported.
+ */
+class ZipReader : public ArchiveReader
+{
+public:
+    [[nodiscard]] bool open(QIODevice *device) override;
+    [[nodiscard]] qsizetype entryCount() const override;
+    [[nodiscard]] LoadOptions::Error read(qsizetype index, QByteArray &data, qint64 maximumSize) override;
+
+private:
+    /** The compressed data of @p entry, using @p storage if it needs to be read from the device. */
+    [[nodiscard]] std::optional<QByteArrayView> compressedData(const ZipDirectory::Entry &entry, QByteArray &storage) const;
+
+    QIODevice *m_device = nullptr;
+    /** The archive content, for in-memory archives. */
+    QByteArray m_data;
+    std::vector<ZipDirectory::Entry> m_entries;
+    qsizetype m_entryCount = 0;
+};
+
+}
+
+#endif
@@ -7,32 +7,23 @@
 #include "barcode.h"
 #include "pass.h"
 #include "pass_p.h"
+#include "passstorage_p.h"
 
 #include <QJsonObject>
 
 using namespace Qt::Literals;
 using namespace KPkPass;
 
-namespace KPkPass
-{
-class BarcodePrivate
-{
-public:
-    const Pass *pass = nullptr;
-    QJsonObject obj;
-};
-}
+static const BarcodePrivate s_emptyBarcode;
 
 Barcode::Barcode()
-    : d(new BarcodePrivate)
+    : d(std::shared_ptr<const BarcodePrivate>(), &s_emptyBarcode)
 {
 }
 
-Barcode::Barcode(const QJsonObject &obj, const Pass *pass)
-    : d(new BarcodePrivate)
+Barcode::Barcode(std::shared_ptr<const BarcodePrivate> &&dd)
+    : d(std::move(dd))
 {
-    d->pass = pass;
-    d->obj = obj;
 }
 
 Barcode::~Barcode() = default;
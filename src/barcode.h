@@ -13,8 +13,6 @@
 
 #include <memory>
 
-class QJsonObject;
-
 namespace KPkPass
 {
 class BarcodePrivate;
@@ -62,9 +60,9 @@ public:
     [[nodiscard]] QString messageEncoding() const;
 
 private:
-    friend class Pass;
-    explicit Barcode(const QJsonObject &obj, const Pass *file);
-    std::shared_ptr<BarcodePrivate> d;
+    friend class PassElements;
+    explicit Barcode(std::shared_ptr<const BarcodePrivate> &&dd);
+    std::shared_ptr<const BarcodePrivate> d;
 };
 
 }
@@ -7,6 +7,8 @@
 #include "field.h"
 #include "pass.h"
 #include "pass_p.h"
+#include "passstorage_p.h"
+#include "stringpool_p.h"
 
 #include <QGuiApplication>
 #include <QJsonObject>
@@ -14,18 +16,10 @@
 using namespace KPkPass;
 using namespace Qt::Literals;
 
-namespace KPkPass
-{
-class FieldPrivate
-{
-public:
-    const Pass *pass = nullptr;
-    QJsonObject obj;
-};
-}
+static const FieldPrivate s_emptyField;
 
 Field::Field()
-    : d(new FieldPrivate)
+    : d(std::shared_ptr<const FieldPrivate>(), &s_emptyField)
 {
 }
 
@@ -35,15 +29,23 @@ Field::~Field() = default;
 Field &Field::operator=(const Field &) = default;
 
 Field::Field(const QJsonObject &obj, const Pass *pass)
-    : d(new FieldPrivate)
 {
-    d->pass = pass;
-    d->obj = obj;
+    auto dd = std::make_shared<FieldPrivate>();
+    dd->pass = pass;
+    dd->obj = obj;
+    dd->key = StringPool::intern(obj.value(QLatin1StringView("key")).toString());
+    dd->row = obj.value("row"_L1).toInt(0);
+    d = std::move(dd);
+}
+
+Field::Field(std::shared_ptr<const FieldPrivate> &&dd)
+    : d(std::move(dd))
+{
 }
 
 QString Field::key() const
 {
-    return d->obj.value(QLatin1StringView("key")).toString();
+    return d->key;
 }
 
 QString Field::label() const
@@ -158,7 +160,7 @@ QString Field::currencyCode() const
 
 int Field::row() const
 {
-    return d->obj.value("row"_L1).toInt(0);
+    return d->row;
 }
 
 bool Field::isRichText() const
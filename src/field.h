@@ -18,7 +18,6 @@ class QJsonObject;
 namespace KPkPass
 {
 class Pass;
-class PassPrivate;
 class FieldPrivate;
 class FieldTest;
 
@@ -82,11 +81,12 @@ public:
     [[nodiscard]] bool isRichText() const;
 
 private:
-    friend class PassPrivate;
     friend class FieldTest;
+    friend class PassElements;
     explicit Field(const QJsonObject &obj, const Pass *pass);
+    explicit Field(std::shared_ptr<const FieldPrivate> &&dd);
 
-    std::shared_ptr<FieldPrivate> d;
+    std::shared_ptr<const FieldPrivate> d;
 };
 
 }
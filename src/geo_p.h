@@ -0,0 +1,37 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_GEO_P_H
+#define KPKPASS_GEO_P_H
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+namespace KPkPass
+{
+namespace Geo
+{
+/** Mean earth radius in meters. */
+constexpr inline double EarthRadius = 6371000.0;
+constexpr inline double MetersPerDegree = EarthRadius * std::numbers::pi / 180.0;
+
+[[nodiscard]] constexpr inline double toRadian(double degree)
+{
+    return degree * std::numbers::pi / 180.0;
+}
+
+/** Great-circle distance in meters between two coordinates given in degree, using the haversine formula. */
+[[nodiscard]] inline double distance(double lat1, double lon1, double lat2, double lon2)
+{
+    const auto sinDLat = std::sin(toRadian(lat2 - lat1) / 2.0);
+    const auto sinDLon = std::sin(toRadian(lon2 - lon1) / 2.0);
+    const auto a = sinDLat * sinDLat + std::cos(toRadian(lat1)) * std::cos(toRadian(lat2)) * sinDLon * sinDLon;
+    return 2.0 * EarthRadius * std::asin(std::min(1.0, std::sqrt(a)));
+}
+}
+}
+
+#endif
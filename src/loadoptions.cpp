@@ -0,0 +1,103 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "loadoptions.h"
+
+using namespace KPkPass;
+
+namespace KPkPass
+{
+class LoadOptionsPrivate
+{
+public:
+    qint64 maximumEntrySize = 16 * 1024 * 1024;
+    qint64 maximumTotalSize = 64 * 1024 * 1024;
+    qint64 maximumCatalogSize = 1024 * 1024;
+    qint64 maximumImagePixels = 4096 * 4096;
+    int maximumEntryCount = 1000;
+    LoadOptions::ArchiveBackend archiveBackend = LoadOptions::BuiltinBackend;
+};
+}
+
+LoadOptions::LoadOptions()
+    : d(std::make_unique<LoadOptionsPrivate>())
+{
+}
+
+LoadOptions::LoadOptions(const LoadOptions &other)
+    : d(std::make_unique<LoadOptionsPrivate>(*other.d))
+{
+}
+
+LoadOptions::LoadOptions(LoadOptions &&) noexcept = default;
+LoadOptions::~LoadOptions() = default;
+
+LoadOptions &LoadOptions::operator=(const LoadOptions &other)
+{
+    *d = *other.d;
+    return *this;
+}
+
+LoadOptions &LoadOptions::operator=(LoadOptions &&) noexcept = default;
+
+qint64 LoadOptions::maximumEntrySize() const
+{
+    return d->maximumEntrySize;
+}
+
+void LoadOptions::setMaximumEntrySize(qint64 size)
+{
+    d->maximumEntrySize = size;
+}
+
+qint64 LoadOptions::maximumTotalSize() const
+{
+    return d->maximumTotalSize;
+}
+
+void LoadOptions::setMaximumTotalSize(qint64 size)
+{
+    d->maximumTotalSize = size;
+}
+
+int LoadOptions::maximumEntryCount() const
+{
+    return d->maximumEntryCount;
+}
+
+void LoadOptions::setMaximumEntryCount(int count)
+{
+    d->maximumEntryCount = count;
+}
+
+qint64 LoadOptions::maximumCatalogSize() const
+{
+    return d->maximumCatalogSize;
+}
+
+void LoadOptions::setMaximumCatalogSize(qint64 size)
+{
+    d->maximumCatalogSize = size;
+}
+
+qint64 LoadOptions::maximumImagePixels() const
+{
+    return d->maximumImagePixels;
+}
+
+void LoadOptions::setMaximumImagePixels(qint64 pixels)
+{
+    d->maximumImagePixels = pixels;
+}
+
+LoadOptions::ArchiveBackend LoadOptions::archiveBackend() const
+{
+    return d->archiveBackend;
+}
+
+void LoadOptions::setArchiveBackend(ArchiveBackend backend)
+{
+    d->archiveBackend = backend;
+}
@@ -0,0 +1,105 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_LOADOPTIONS_H
+#define KPKPASS_LOADOPTIONS_H
+
+#include "kpkpass_export.h"
+
+#include <QtGlobal>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class LoadOptionsPrivate;
+
+/*!
+ * \brief Resource limits for loading untrusted pass files.
+ *
+ * Limits are enforced while decompressing archive entries, so that
+ * a compressed archive cannot make us inflate more than the configured
+ * amount of data. Limits apply to the initial loading as well as to
+ * assets such as images and translation catalogs that are only read
+ * on demand later on.
+ *
+ * A limit of \c 0 or less disables the corresponding check.
+ *
+ * \sa Pass::fromData()
+ * \class KPkPass::LoadOptions
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/LoadOptions
+ * \since 26.08
+ */
+class KPKPASS_EXPORT LoadOptions
+{
+public:
+    /*!
+     * \value NoError Loading succeeded.
+     * \value FileError The file could not be opened or read.
+     * \value InvalidArchive The input is not a valid ZIP archive.
+     * \value InvalidPassJson pass.json is missing or could not be parsed.
+     * \value UnsupportedPass The pass uses an unsupported format version or has no pass data structure.
+     * \value ResourceLimitExceeded One of the configured limits was hit.
+     */
+    enum Error {
+        NoError,
+        FileError,
+        InvalidArchive,
+        InvalidPassJson,
+        UnsupportedPass,
+        ResourceLimitExceeded,
+    };
+
+    /*!
+     * \value BuiltinBackend A minimal built-in ZIP reader optimized for small archives,
+     *        falling back to KArchive for archives it cannot handle, such as ZIP64 ones.
+     * \value KArchiveBackend KArchive's ZIP implementation.
+     */
+    enum ArchiveBackend {
+        BuiltinBackend,
+        KArchiveBackend,
+    };
+
+    /*! Creates load options with default limits, sufficient for all legitimate passes we are aware of. */
+    LoadOptions();
+    LoadOptions(const LoadOptions &);
+    LoadOptions(LoadOptions &&) noexcept;
+    ~LoadOptions();
+    LoadOptions &operator=(const LoadOptions &);
+    LoadOptions &operator=(LoadOptions &&) noexcept;
+
+    /*! Maximum decompressed size of a single archive entry, in bytes. */
+    [[nodiscard]] qint64 maximumEntrySize() const;
+    void setMaximumEntrySize(qint64 size);
+
+    /*! Maximum total amount of decompressed data, in bytes. */
+    [[nodiscard]] qint64 maximumTotalSize() const;
+    void setMaximumTotalSize(qint64 size);
+
+    /*! Maximum number of entries in the archive. */
+    [[nodiscard]] int maximumEntryCount() const;
+    void setMaximumEntryCount(int count);
+
+    /*! Maximum decompressed size of a translation catalog, in bytes. */
+    [[nodiscard]] qint64 maximumCatalogSize() const;
+    void setMaximumCatalogSize(qint64 size);
+
+    /*! Maximum number of pixels (width times height) of an image asset. */
+    [[nodiscard]] qint64 maximumImagePixels() const;
+    void setMaximumImagePixels(qint64 pixels);
+
+    /*! The implementation used for reading pass archives, BuiltinBackend by default. */
+    [[nodiscard]] ArchiveBackend archiveBackend() const;
+    void setArchiveBackend(ArchiveBackend backend);
+
+private:
+    std::unique_ptr<LoadOptionsPrivate> d;
+};
+
+}
+
+#endif
@@ -0,0 +1,156 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "loadstatistics.h"
+#include "loadstatistics_p.h"
+
+#include <atomic>
+#include <iterator>
+
+using namespace KPkPass;
+
+static constexpr qint64 LoadCounters::*s_counters[] = {
+    &LoadCounters::passCount,
+    &LoadCounters::cachedPassCount,
+    &LoadCounters::archiveSize,
+    &LoadCounters::inflatedSize,
+    &LoadCounters::entryCount,
+    &LoadCounters::passJsonSize,
+    &LoadCounters::jsonRepairCount,
+    &LoadCounters::catalogCount,
+    &LoadCounters::catalogSize,
+    &LoadCounters::catalogEntryCount,
+    &LoadCounters::imageDecodeCount,
+    &LoadCounters::imageCacheHitCount,
+};
+static_assert(std::size(s_counters) * sizeof(qint64) == sizeof(LoadCounters), "s_counters needs to cover all of LoadCounters");
+
+// the global counters are independent sums, so there is no need to order accesses to them
+static std::atomic<qint64> s_global[std::size(s_counters)];
+
+LoadStatistics LoadStatisticsPrivate::create(const LoadCounters &counters, const QString &catalogLanguage)
+{
+    auto stats = std::make_shared<LoadStatisticsPrivate>();
+    stats->counters = counters;
+    stats->catalogLanguage = catalogLanguage;
+    return LoadStatistics(std::move(stats));
+}
+
+void LoadStatisticsPrivate::countGlobal(qint64 LoadCounters::*counter, qint64 value)
+{
+    for (std::size_t i = 0; i < std::size(s_counters); ++i) {
+        if (s_counters[i] == counter) {
+            s_global[i].fetch_add(value, std::memory_order_relaxed);
+            return;
+        }
+    }
+}
+
+void LoadStatisticsPrivate::countGlobal(const LoadCounters &counters)
+{
+    for (std::size_t i = 0; i < std::size(s_counters); ++i) {
+        if (const auto value = counters.*s_counters[i]) {
+            s_global[i].fetch_add(value, std::memory_order_relaxed);
+        }
+    }
+}
+
+LoadStatistics::LoadStatistics()
+{
+    static const std::shared_ptr<const LoadStatisticsPrivate> s_empty = std::make_shared<LoadStatisticsPrivate>();
+    d = s_empty;
+}
+
+LoadStatistics::LoadStatistics(std::shared_ptr<const LoadStatisticsPrivate> &&dd)
+    : d(std::move(dd))
+{
+}
+
+LoadStatistics::LoadStatistics(const LoadStatistics &) = default;
+LoadStatistics::LoadStatistics(LoadStatistics &&) noexcept = default;
+LoadStatistics::~LoadStatistics() = default;
+LoadStatistics &LoadStatistics::operator=(const LoadStatistics &) = default;
+LoadStatistics &LoadStatistics::operator=(LoadStatistics &&) noexcept = default;
+
+qint64 LoadStatistics::passCount() const
+{
+    return d->counters.passCount;
+}
+
+qint64 LoadStatistics::cachedPassCount() const
+{
+    return d->counters.cachedPassCount;
+}
+
+qint64 LoadStatistics::archiveSize() const
+{
+    return d->counters.archiveSize;
+}
+
+qint64 LoadStatistics::inflatedSize() const
+{
+    return d->counters.inflatedSize;
+}
+
+qint64 LoadStatistics::entryCount() const
+{
+    return d->counters.entryCount;
+}
+
+qint64 LoadStatistics::passJsonSize() const
+{
+    return d->counters.passJsonSize;
+}
+
+qint64 LoadStatistics::jsonRepairCount() const
+{
+    return d->counters.jsonRepairCount;
+}
+
+qint64 LoadStatistics::catalogCount() const
+{
+    return d->counters.catalogCount;
+}
+
+qint64 LoadStatistics::catalogSize() const
+{
+    return d->counters.catalogSize;
+}
+
+qint64 LoadStatistics::catalogEntryCount() const
+{
+    return d->counters.catalogEntryCount;
+}
+
+qint64 LoadStatistics::imageDecodeCount() const
+{
+    return d->counters.imageDecodeCount;
+}
+
+qint64 LoadStatistics::imageCacheHitCount() const
+{
+    return d->counters.imageCacheHitCount;
+}
+
+QString LoadStatistics::catalogLanguage() const
+{
+    return d->catalogLanguage;
+}
+
+LoadStatistics LoadStatistics::global()
+{
+    LoadCounters counters;
+    for (std::size_t i = 0; i < std::size(s_counters); ++i) {
+        counters.*s_counters[i] = s_global[i].load(std::memory_order_relaxed);
+    }
+    return LoadStatisticsPrivate::create(counters, {});
+}
+
+void LoadStatistics::resetGlobal()
+{
+    for (auto &counter : s_global) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,93 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_LOADSTATISTICS_H
+#define KPKPASS_LOADSTATISTICS_H
+
+#include "kpkpass_export.h"
+
+#include <QString>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class LoadStatisticsPrivate;
+
+/*!
+ * \brief Counters describing the work done for loading passes.
+ *
+ * Pass::loadStatistics() returns the counters of a single pass, including
+ * work done lazily after loading, such as parsing translation catalogs or
+ * decoding images. global() returns the same counters summed up over all
+ * passes loaded successfully by the current process, work done for passes
+ * that failed to load isn't included there.
+ *
+ * This is a snapshot, later activity of the pass isn't reflected in
+ * an existing instance.
+ *
+ * \class KPkPass::LoadStatistics
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/LoadStatistics
+ * \since 26.08
+ */
+class KPKPASS_EXPORT LoadStatistics
+{
+public:
+    LoadStatistics();
+    LoadStatistics(const LoadStatistics &);
+    LoadStatistics(LoadStatistics &&) noexcept;
+    ~LoadStatistics();
+    LoadStatistics &operator=(const LoadStatistics &);
+    LoadStatistics &operator=(LoadStatistics &&) noexcept;
+
+    /*! Number of passes loaded, \c 1 for the statistics of a single pass. */
+    [[nodiscard]] qint64 passCount() const;
+    /*! Number of passes restored from a cache file written by Pass::writeCache(). */
+    [[nodiscard]] qint64 cachedPassCount() const;
+    /*! Size of the pass archives read, in bytes. */
+    [[nodiscard]] qint64 archiveSize() const;
+    /*! Decompressed size of all archive entries read, in bytes. */
+    [[nodiscard]] qint64 inflatedSize() const;
+    /*! Number of entries in the pass archives. */
+    [[nodiscard]] qint64 entryCount() const;
+    /*! Size of pass.json, in bytes. */
+    [[nodiscard]] qint64 passJsonSize() const;
+    /*! Number of passes whose pass.json was only readable after applying workarounds for syntax errors. */
+    [[nodiscard]] qint64 jsonRepairCount() const;
+    /*! Number of translation catalogs parsed. */
+    [[nodiscard]] qint64 catalogCount() const;
+    /*! Raw size of all parsed translation catalogs, in bytes. */
+    [[nodiscard]] qint64 catalogSize() const;
+    /*! Number of messages in all parsed translation catalogs. */
+    [[nodiscard]] qint64 catalogEntryCount() const;
+    /*! Number of images decoded. */
+    [[nodiscard]] qint64 imageDecodeCount() const;
+    /*! Number of image requests served from the image cache. */
+    [[nodiscard]] qint64 imageCacheHitCount() const;
+
+    /*! The translation catalog (lproj name without extension) currently used by the pass.
+     *  Empty if none is used, and for global statistics.
+     */
+    [[nodiscard]] QString catalogLanguage() const;
+
+    /*! Statistics summed up over all passes loaded in this process.
+     *  The counters are read one by one, so this isn't an atomic snapshot
+     *  while passes are loaded on other threads.
+     */
+    [[nodiscard]] static LoadStatistics global();
+    /*! Resets the global statistics. */
+    static void resetGlobal();
+
+private:
+    friend class LoadStatisticsPrivate;
+    explicit LoadStatistics(std::shared_ptr<const LoadStatisticsPrivate> &&dd);
+    std::shared_ptr<const LoadStatisticsPrivate> d;
+};
+
+}
+
+#endif
@@ -0,0 +1,43 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_LOADSTATISTICS_P_H
+#define KPKPASS_LOADSTATISTICS_P_H
+
+#include "loadstatistics.h"
+
+namespace KPkPass
+{
+/** The counters behind LoadStatistics. */
+struct LoadCounters {
+    qint64 passCount = 0;
+    qint64 cachedPassCount = 0;
+    qint64 archiveSize = 0;
+    qint64 inflatedSize = 0;
+    qint64 entryCount = 0;
+    qint64 passJsonSize = 0;
+    qint64 jsonRepairCount = 0;
+    qint64 catalogCount = 0;
+    qint64 catalogSize = 0;
+    qint64 catalogEntryCount = 0;
+    qint64 imageDecodeCount = 0;
+    qint64 imageCacheHitCount = 0;
+};
+
+class LoadStatisticsPrivate
+{
+public:
+    [[nodiscard]] static LoadStatistics create(const LoadCounters &counters, const QString &catalogLanguage);
+    /** Adds @p value to @p counter of the global statistics. Thread-safe. */
+    static void countGlobal(qint64 LoadCounters::*counter, qint64 value);
+    /** Adds all of @p counters to the global statistics. Thread-safe. */
+    static void countGlobal(const LoadCounters &counters);
+
+    LoadCounters counters;
+    QString catalogLanguage;
+};
+}
+
+#endif
@@ -5,6 +5,7 @@
 */
 
 #include "location.h"
+#include "passstorage_p.h"
 
 #include <QJsonObject>
 
@@ -12,41 +13,33 @@
 
 using namespace KPkPass;
 
-namespace KPkPass
-{
-class LocationPrivate
-{
-public:
-    QJsonObject obj;
-};
-}
+static const LocationPrivate s_emptyLocation;
 
 Location::Location()
-    : d(new LocationPrivate)
+    : d(std::shared_ptr<const LocationPrivate>(), &s_emptyLocation)
 {
 }
 
-Location::Location(const QJsonObject &obj)
-    : d(new LocationPrivate)
+Location::Location(std::shared_ptr<const LocationPrivate> &&dd)
+    : d(std::move(dd))
 {
-    d->obj = obj;
 }
 
 Location::~Location() = default;
 
 double Location::altitude() const
 {
-    return d->obj.value(QLatin1StringView("altitude")).toDouble(NAN);
+    return d->altitude;
 }
 
 double Location::latitude() const
 {
-    return d->obj.value(QLatin1StringView("latitude")).toDouble(NAN);
+    return d->latitude;
 }
 
 double Location::longitude() const
 {
-    return d->obj.value(QLatin1StringView("longitude")).toDouble(NAN);
+    return d->longitude;
 }
 
 QString Location::relevantText() const
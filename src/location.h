@@ -12,8 +12,6 @@
 
 #include <memory>
 
-class QJsonObject;
-
 namespace KPkPass
 {
 class LocationPrivate;
@@ -46,9 +44,9 @@ public:
     [[nodiscard]] QString relevantText() const;
 
 private:
-    friend class Pass;
-    explicit Location(const QJsonObject &obj);
-    std::shared_ptr<LocationPrivate> d;
+    friend class PassElements;
+    explicit Location(std::shared_ptr<const LocationPrivate> &&dd);
+    std::shared_ptr<const LocationPrivate> d;
 };
 
 }
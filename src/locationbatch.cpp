@@ -0,0 +1,279 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "locationbatch.h"
+#include "geo_p.h"
+#include "location.h"
+
+#include <bit>
+#include <cmath>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define KPKPASS_HAVE_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define KPKPASS_HAVE_SSE2 1
+#endif
+
+using namespace KPkPass;
+using namespace KPkPass::Geo;
+
+// Coordinates are stored as unit vectors, the squared chord length between two such
+// vectors is a monotonic function of the great-circle distance, so radius checks
+// only need multiplications and additions, and the distance only needs a single
+// asin per element.
+
+namespace
+{
+struct UnitVector {
+    double x;
+    double y;
+    double z;
+};
+
+[[nodiscard]] UnitVector toUnitVector(double latitude, double longitude)
+{
+    const auto lat = toRadian(latitude);
+    const auto lon = toRadian(longitude);
+    return {std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat)};
+}
+
+[[nodiscard]] double chordSquaredForRadius(double radius)
+{
+    const auto angle = std::min(radius / EarthRadius, std::numbers::pi);
+    const auto chord = 2.0 * std::sin(angle / 2.0);
+    return chord * chord;
+}
+}
+
+namespace KPkPass
+{
+class LocationBatchPrivate
+{
+public:
+    // each kernel processes elements starting at index i, and returns the index
+    // of the first element it didn't process
+    std::size_t chordSquaredScalar(const UnitVector &q, double *result, std::size_t i) const;
+    std::size_t withinRadiusScalar(const UnitVector &q, quint8 *mask, std::size_t i, qsizetype &count) const;
+#if defined(KPKPASS_HAVE_AVX)
+    std::size_t chordSquaredAvx(const UnitVector &q, double *result, std::size_t i) const;
+    std::size_t withinRadiusAvx(const UnitVector &q, quint8 *mask, std::size_t i, qsizetype &count) const;
+#elif defined(KPKPASS_HAVE_SSE2)
+    std::size_t chordSquaredSse2(const UnitVector &q, double *result, std::size_t i) const;
+    std::size_t withinRadiusSse2(const UnitVector &q, quint8 *mask, std::size_t i, qsizetype &count) const;
+#endif
+
+    std::vector<double> m_x;
+    std::vector<double> m_y;
+    std::vector<double> m_z;
+    std::vector<double> m_threshold;
+};
+}
+
+std::size_t LocationBatchPrivate::chordSquaredScalar(const UnitVector &q, double *result, std::size_t i) const
+{
+    for (; i < m_x.size(); ++i) {
+        const auto dx = m_x[i] - q.x;
+        const auto dy = m_y[i] - q.y;
+        const auto dz = m_z[i] - q.z;
+        result[i] = dx * dx + dy * dy + dz * dz;
+    }
+    return i;
+}
+
+std::size_t LocationBatchPrivate::withinRadiusScalar(const UnitVector &q, quint8 *mask, std::size_t i, qsizetype &count) const
+{
+    for (; i < m_x.size(); ++i) {
+        const auto dx = m_x[i] - q.x;
+        const auto dy = m_y[i] - q.y;
+        const auto dz = m_z[i] - q.z;
+        mask[i] = (dx * dx + dy * dy + dz * dz) <= m_threshold[i] ? 1 : 0;
+        count += mask[i];
+    }
+    return i;
+}
+
+#if defined(KPKPASS_HAVE_AVX)
+std::size_t LocationBatchPrivate::chordSquaredAvx(const UnitVector &q, double *result, std::size_t i) const
+{
+    const auto qx = _mm256_set1_pd(q.x);
+    const auto qy = _mm256_set1_pd(q.y);
+    const auto qz = _mm256_set1_pd(q.z);
+    for (; i + 4 <= m_x.size(); i += 4) {
+        const auto dx = _mm256_sub_pd(_mm256_loadu_pd(m_x.data() + i), qx);
+        const auto dy = _mm256_sub_pd(_mm256_loadu_pd(m_y.data() + i), qy);
+        const auto dz = _mm256_sub_pd(_mm256_loadu_pd(m_z.data() + i), qz);
+        const auto c = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+        _mm256_storeu_pd(result + i, c);
+    }
+    return i;
+}
+
+std::size_t LocationBatchPrivate::withinRadiusAvx(const UnitVector &q, quint8 *mask, std::size_t i, qsizetype &count) const
+{
+    const auto qx = _mm256_set1_pd(q.x);
+    const auto qy = _mm256_set1_pd(q.y);
+    const auto qz = _mm256_set1_pd(q.z);
+    for (; i + 4 <= m_x.size(); i += 4) {
+        const auto dx = _mm256_sub_pd(_mm256_loadu_pd(m_x.data() + i), qx);
+        const auto dy = _mm256_sub_pd(_mm256_loadu_pd(m_y.data() + i), qy);
+        const auto dz = _mm256_sub_pd(_mm256_loadu_pd(m_z.data() + i), qz);
+        const auto c = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+        const auto bits = static_cast<unsigned int>(_mm256_movemask_pd(_mm256_cmp_pd(c, _mm256_loadu_pd(m_threshold.data() + i), _CMP_LE_OQ)));
+        for (std::size_t j = 0; j < 4; ++j) {
+            mask[i + j] = (bits >> j) & 1;
+        }
+        count += std::popcount(bits);
+    }
+    return i;
+}
+#elif defined(KPKPASS_HAVE_SSE2)
+std::size_t LocationBatchPrivate::chordSquaredSse2(const UnitVector &q, double *result, std::size_t i) const
+{
+    const auto qx = _mm_set1_pd(q.x);
+    const auto qy = _mm_set1_pd(q.y);
+    const auto qz = _mm_set1_pd(q.z);
+    for (; i + 2 <= m_x.size(); i += 2) {
+        const auto dx = _mm_sub_pd(_mm_loadu_pd(m_x.data() + i), qx);
+        const auto dy = _mm_sub_pd(_mm_loadu_pd(m_y.data() + i), qy);
+        const auto dz = _mm_sub_pd(_mm_loadu_pd(m_z.data() + i), qz);
+        const auto c = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+        _mm_storeu_pd(result + i, c);
+    }
+    return i;
+}
+
+std::size_t LocationBatchPrivate::withinRadiusSse2(const UnitVector &q, quint8 *mask, std::size_t i, qsizetype &count) const
+{
+    const auto qx = _mm_set1_pd(q.x);
+    const auto qy = _mm_set1_pd(q.y);
+    const auto qz = _mm_set1_pd(q.z);
+    for (; i + 2 <= m_x.size(); i += 2) {
+        const auto dx = _mm_sub_pd(_mm_loadu_pd(m_x.data() + i), qx);
+        const auto dy = _mm_sub_pd(_mm_loadu_pd(m_y.data() + i), qy);
+        const auto dz = _mm_sub_pd(_mm_loadu_pd(m_z.data() + i), qz);
+        const auto c = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+        const auto bits = static_cast<unsigned int>(_mm_movemask_pd(_mm_cmple_pd(c, _mm_loadu_pd(m_threshold.data() + i))));
+        mask[i] = bits & 1;
+        mask[i + 1] = (bits >> 1) & 1;
+        count += std::popcount(bits);
+    }
+    return i;
+}
+#endif
+
+LocationBatch::LocationBatch()
+    : d(std::make_unique<LocationBatchPrivate>())
+{
+}
+
+LocationBatch::LocationBatch(const LocationBatch &other)
+    : d(std::make_unique<LocationBatchPrivate>(*other.d))
+{
+}
+
+LocationBatch::LocationBatch(LocationBatch &&) noexcept = default;
+LocationBatch::~LocationBatch() = default;
+
+LocationBatch &LocationBatch::operator=(const LocationBatch &other)
+{
+    *d = *other.d;
+    return *this;
+}
+
+LocationBatch &LocationBatch::operator=(LocationBatch &&) noexcept = default;
+
+qsizetype LocationBatch::size() const
+{
+    return static_cast<qsizetype>(d->m_x.size());
+}
+
+bool LocationBatch::isEmpty() const
+{
+    return d->m_x.empty();
+}
+
+void LocationBatch::reserve(qsizetype size)
+{
+    d->m_x.reserve(size);
+    d->m_y.reserve(size);
+    d->m_z.reserve(size);
+    d->m_threshold.reserve(size);
+}
+
+void LocationBatch::clear()
+{
+    d->m_x.clear();
+    d->m_y.clear();
+    d->m_z.clear();
+    d->m_threshold.clear();
+}
+
+void LocationBatch::append(double latitude, double longitude, double radius)
+{
+    const auto v = toUnitVector(latitude, longitude);
+    d->m_x.push_back(v.x);
+    d->m_y.push_back(v.y);
+    d->m_z.push_back(v.z);
+    d->m_threshold.push_back(chordSquaredForRadius(radius));
+}
+
+void LocationBatch::append(const double *latitudes, const double *longitudes, qsizetype count, double radius)
+{
+    const auto threshold = chordSquaredForRadius(radius);
+    for (qsizetype i = 0; i < count; ++i) {
+        const auto v = toUnitVector(latitudes[i], longitudes[i]);
+        d->m_x.push_back(v.x);
+        d->m_y.push_back(v.y);
+        d->m_z.push_back(v.z);
+        d->m_threshold.push_back(threshold);
+    }
+}
+
+void LocationBatch::append(const QList<Location> &locations, double radius)
+{
+    for (const auto &loc : locations) {
+        if (std::isnan(loc.latitude()) || std::isnan(loc.longitude())) {
+            continue;
+        }
+        append(loc.latitude(), loc.longitude(), radius);
+    }
+}
+
+void LocationBatch::distances(double latitude, double longitude, double *result, Kernel kernel) const
+{
+    const auto q = toUnitVector(latitude, longitude);
+    std::size_t i = 0;
+    if (kernel == Auto) {
+#if defined(KPKPASS_HAVE_AVX)
+        i = d->chordSquaredAvx(q, result, i);
+#elif defined(KPKPASS_HAVE_SSE2)
+        i = d->chordSquaredSse2(q, result, i);
+#endif
+    }
+    d->chordSquaredScalar(q, result, i);
+
+    for (std::size_t j = 0; j < d->m_x.size(); ++j) {
+        result[j] = 2.0 * EarthRadius * std::asin(std::min(1.0, std::sqrt(result[j]) / 2.0));
+    }
+}
+
+qsizetype LocationBatch::withinRadius(double latitude, double longitude, quint8 *mask, Kernel kernel) const
+{
+    const auto q = toUnitVector(latitude, longitude);
+    std::size_t i = 0;
+    qsizetype count = 0;
+    if (kernel == Auto) {
+#if defined(KPKPASS_HAVE_AVX)
+        i = d->withinRadiusAvx(q, mask, i, count);
+#elif defined(KPKPASS_HAVE_SSE2)
+        i = d->withinRadiusSse2(q, mask, i, count);
+#endif
+    }
+    d->withinRadiusScalar(q, mask, i, count);
+    return count;
+}
@@ -0,0 +1,90 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_LOCATIONBATCH_H
+#define KPKPASS_LOCATIONBATCH_H
+
+#include "kpkpass_export.h"
+
+#include <QList>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class Location;
+class LocationBatchPrivate;
+
+/*!
+ * \brief A packed set of coordinates for batched distance computations.
+ *
+ * Coordinates are stored as a structure of arrays, with everything that
+ * only depends on the coordinates themselves computed once on insertion.
+ * This allows computing the great-circle distances to or radius checks against
+ * a query position for all elements with vectorized kernels, without any
+ * trigonometric functions in the inner loop.
+ *
+ * Each element can have an associated radius in meters, typically the
+ * Pass::maximumDistance() of the pass the location belongs to.
+ *
+ * \class KPkPass::LocationBatch
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/LocationBatch
+ * \since 26.08
+ */
+class KPKPASS_EXPORT LocationBatch
+{
+public:
+    /*! Kernel implementation to use. */
+    enum Kernel {
+        Auto, ///< the fastest implementation available on the current platform
+        Scalar, ///< portable scalar implementation
+    };
+
+    LocationBatch();
+    LocationBatch(const LocationBatch &);
+    LocationBatch(LocationBatch &&) noexcept;
+    ~LocationBatch();
+    LocationBatch &operator=(const LocationBatch &);
+    LocationBatch &operator=(LocationBatch &&) noexcept;
+
+    /*! Number of coordinates in this batch. */
+    [[nodiscard]] qsizetype size() const;
+    [[nodiscard]] bool isEmpty() const;
+    void reserve(qsizetype size);
+    void clear();
+
+    /*! Appends a single coordinate given in degree, with a radius of \a radius meters. */
+    void append(double latitude, double longitude, double radius = 0.0);
+    /*! Appends \a count coordinates from the packed arrays \a latitudes and \a longitudes (in degree),
+     *  all with a radius of \a radius meters.
+     */
+    void append(const double *latitudes, const double *longitudes, qsizetype count, double radius = 0.0);
+    /*! Appends all \a locations, with a radius of \a radius meters.
+     *  Locations without valid coordinates are skipped.
+     */
+    void append(const QList<Location> &locations, double radius = 0.0);
+
+    /*! Computes the great-circle distances in meters from the position given
+     *  by \a latitude and \a longitude (in degree) to all coordinates in this batch.
+     *  \a result has to point to an array of at least size() elements.
+     */
+    void distances(double latitude, double longitude, double *result, Kernel kernel = Auto) const;
+    /*! Checks for all coordinates in this batch whether the position given by
+     *  \a latitude and \a longitude (in degree) is within their radius.
+     *  \a mask has to point to an array of at least size() elements, which
+     *  are set to \c 1 for elements within range and \c 0 otherwise.
+     *  Returns the number of elements within range.
+     */
+    qsizetype withinRadius(double latitude, double longitude, quint8 *mask, Kernel kernel = Auto) const;
+
+private:
+    std::unique_ptr<LocationBatchPrivate> d;
+};
+
+}
+
+#endif
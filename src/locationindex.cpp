@@ -0,0 +1,219 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "locationindex.h"
+#include "geo_p.h"
+#include "location.h"
+#include "pass.h"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+using namespace KPkPass;
+using namespace KPkPass::Geo;
+
+namespace
+{
+// grid cell size in degree, ~1.1km in latitude direction, which is in the order
+// of magnitude of the default maximum distance of 500m
+constexpr inline double CellSize = 0.01;
+constexpr inline int LongitudeCellCount = 36000; // 360 / CellSize
+// locations covering more cells than this are not put into the grid but checked for every query
+constexpr inline int MaximumCellsPerLocation = 64;
+
+struct Entry {
+    double latitude = NAN;
+    double longitude = NAN;
+    double radius = 0.0;
+    Pass *pass = nullptr;
+};
+
+struct CellRange {
+    int latitudeBegin;
+    int latitudeEnd;
+    int longitudeBegin;
+    int longitudeEnd;
+};
+
+[[nodiscard]] int cellIndex(double degree)
+{
+    return static_cast<int>(std::floor(degree / CellSize));
+}
+
+[[nodiscard]] quint64 cellKey(int latitudeCell, int longitudeCell)
+{
+    longitudeCell %= LongitudeCellCount;
+    if (longitudeCell < 0) {
+        longitudeCell += LongitudeCellCount;
+    }
+    return (quint64(quint32(latitudeCell)) << 32) | quint64(quint32(longitudeCell));
+}
+
+[[nodiscard]] std::optional<CellRange> cellRange(const Entry &entry)
+{
+    const auto latitudeSpan = entry.radius / MetersPerDegree;
+    const auto maxLatitude = std::abs(entry.latitude) + latitudeSpan;
+    if (maxLatitude >= 89.0) {
+        return {};
+    }
+    const auto longitudeSpan = latitudeSpan / std::cos(toRadian(maxLatitude));
+
+    CellRange range{
+        cellIndex(entry.latitude - latitudeSpan),
+        cellIndex(entry.latitude + latitudeSpan) + 1,
+        cellIndex(entry.longitude - longitudeSpan),
+        cellIndex(entry.longitude + longitudeSpan) + 1,
+    };
+    if ((range.latitudeEnd - range.latitudeBegin) * (range.longitudeEnd - range.longitudeBegin) > MaximumCellsPerLocation) {
+        return {};
+    }
+    return range;
+}
+}
+
+namespace KPkPass
+{
+class LocationIndexPrivate
+{
+public:
+    void addEntry(const Entry &entry);
+    void removeEntry(quint32 idx);
+
+    std::vector<Entry> m_entries;
+    std::vector<quint32> m_freeEntries;
+    std::unordered_map<quint64, std::vector<quint32>> m_cells;
+    std::vector<quint32> m_wideEntries;
+    std::unordered_map<Pass *, std::vector<quint32>> m_passEntries;
+    qsizetype m_size = 0;
+};
+}
+
+void LocationIndexPrivate::addEntry(const Entry &entry)
+{
+    quint32 idx = 0;
+    if (m_freeEntries.empty()) {
+        idx = static_cast<quint32>(m_entries.size());
+        m_entries.push_back(entry);
+    } else {
+        idx = m_freeEntries.back();
+        m_freeEntries.pop_back();
+        m_entries[idx] = entry;
+    }
+    m_passEntries[entry.pass].push_back(idx);
+    ++m_size;
+
+    const auto range = cellRange(entry);
+    if (!range) {
+        m_wideEntries.push_back(idx);
+        return;
+    }
+    for (auto lat = range->latitudeBegin; lat < range->latitudeEnd; ++lat) {
+        for (auto lon = range->longitudeBegin; lon < range->longitudeEnd; ++lon) {
+            m_cells[cellKey(lat, lon)].push_back(idx);
+        }
+    }
+}
+
+void LocationIndexPrivate::removeEntry(quint32 idx)
+{
+    const auto range = cellRange(m_entries[idx]);
+    if (!range) {
+        std::erase(m_wideEntries, idx);
+    } else {
+        for (auto lat = range->latitudeBegin; lat < range->latitudeEnd; ++lat) {
+            for (auto lon = range->longitudeBegin; lon < range->longitudeEnd; ++lon) {
+                const auto it = m_cells.find(cellKey(lat, lon));
+                if (it == m_cells.end()) {
+                    continue;
+                }
+                std::erase((*it).second, idx);
+                if ((*it).second.empty()) {
+                    m_cells.erase(it);
+                }
+            }
+        }
+    }
+
+    m_entries[idx] = {};
+    m_freeEntries.push_back(idx);
+    --m_size;
+}
+
+LocationIndex::LocationIndex()
+    : d(std::make_unique<LocationIndexPrivate>())
+{
+}
+
+LocationIndex::LocationIndex(LocationIndex &&) noexcept = default;
+LocationIndex::~LocationIndex() = default;
+LocationIndex &LocationIndex::operator=(LocationIndex &&) noexcept = default;
+
+void LocationIndex::insert(Pass *pass)
+{
+    if (!pass || d->m_passEntries.contains(pass)) {
+        return;
+    }
+
+    const double radius = pass->maximumDistance();
+    const auto locs = pass->locations();
+    for (const auto &loc : locs) {
+        const Entry entry{loc.latitude(), loc.longitude(), radius, pass};
+        if (std::isnan(entry.latitude) || std::isnan(entry.longitude)) {
+            continue;
+        }
+        d->addEntry(entry);
+    }
+}
+
+void LocationIndex::remove(Pass *pass)
+{
+    const auto it = d->m_passEntries.find(pass);
+    if (it == d->m_passEntries.end()) {
+        return;
+    }
+    for (const auto idx : (*it).second) {
+        d->removeEntry(idx);
+    }
+    d->m_passEntries.erase(it);
+}
+
+void LocationIndex::clear()
+{
+    d->m_entries.clear();
+    d->m_freeEntries.clear();
+    d->m_cells.clear();
+    d->m_wideEntries.clear();
+    d->m_passEntries.clear();
+    d->m_size = 0;
+}
+
+qsizetype LocationIndex::size() const
+{
+    return d->m_size;
+}
+
+QList<Pass *> LocationIndex::passesNear(double latitude, double longitude) const
+{
+    QList<Pass *> result;
+    const auto check = [&](quint32 idx) {
+        const auto &entry = d->m_entries[idx];
+        if (result.contains(entry.pass)) {
+            return;
+        }
+        if (distance(latitude, longitude, entry.latitude, entry.longitude) <= entry.radius) {
+            result.push_back(entry.pass);
+        }
+    };
+
+    const auto it = d->m_cells.find(cellKey(cellIndex(latitude), cellIndex(longitude)));
+    if (it != d->m_cells.end()) {
+        std::ranges::for_each((*it).second, check);
+    }
+    std::ranges::for_each(d->m_wideEntries, check);
+    return result;
+}
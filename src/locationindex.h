@@ -0,0 +1,67 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_LOCATIONINDEX_H
+#define KPKPASS_LOCATIONINDEX_H
+
+#include "kpkpass_export.h"
+
+#include <QList>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class LocationIndexPrivate;
+class Pass;
+
+/*!
+ * \brief Spatial index over the relevant locations of a set of passes.
+ *
+ * This allows to find all passes that are relevant at a given position,
+ * that is passes that have a location within their maximum distance
+ * of that position, without having to check all locations of all passes.
+ *
+ * The index does not take ownership of the passes, they have to be removed
+ * from the index before they are deleted.
+ *
+ * \sa Pass::locations(), Pass::maximumDistance()
+ * \class KPkPass::LocationIndex
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/LocationIndex
+ * \since 26.08
+ */
+class KPKPASS_EXPORT LocationIndex
+{
+public:
+    LocationIndex();
+    LocationIndex(LocationIndex &&) noexcept;
+    ~LocationIndex();
+    LocationIndex &operator=(LocationIndex &&) noexcept;
+
+    /*! Adds all locations of \a pass to the index. */
+    void insert(Pass *pass);
+    /*! Removes all locations of \a pass from the index. */
+    void remove(Pass *pass);
+    /*! Removes all passes from the index. */
+    void clear();
+
+    /*! Number of indexed locations. */
+    [[nodiscard]] qsizetype size() const;
+
+    /*! Returns all passes with a location within their maximum distance
+     *  of the position given by \a latitude and \a longitude (in degree).
+     *  Each pass is returned at most once, in no particular order.
+     */
+    [[nodiscard]] QList<Pass *> passesNear(double latitude, double longitude) const;
+
+private:
+    std::unique_ptr<LocationIndexPrivate> d;
+};
+
+}
+
+#endif
@@ -7,24 +7,33 @@
 #include "pass.h"
 #include "barcode.h"
 #include "boardingpass.h"
+#include "loadstatistics_p.h"
 #include "location.h"
 #include "logging.h"
 #include "pass_p.h"
+#include "passassets.h"
+#include "passstyle_p.h"
+#include "semantictags_p.h"
 #include "seat.h"
-
-#include <KZip>
+#include "stringpool_p.h"
+#include "trace_p.h"
 
 #include <QBuffer>
-#include <QColor>
+#include <QCryptographicHash>
+#include <QDateTime>
 #include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLocale>
+#include <QMutexLocker>
+#include <QReadWriteLock>
 #include <QRegularExpression>
 #include <QStringDecoder>
 #include <QUrl>
 
+#include <algorithm>
+#include <atomic>
 #include <cctype>
 
 using namespace Qt::Literals;
@@ -35,35 +44,166 @@ static const auto passTypesCount = sizeof(passTypes) / sizeof(passTypes[0]);
 
 QJsonObject PassPrivate::passData() const
 {
-    return passObj.value(QLatin1StringView(passTypes[passType])).toObject();
+    return passObj.value(passDataKey()).toObject();
+}
+
+QLatin1StringView PassPrivate::passDataKey() const
+{
+    return QLatin1StringView(passTypes[passType]);
+}
+
+bool PassPrivate::isPassDataKey(QStringView key)
+{
+    return std::any_of(std::begin(passTypes), std::end(passTypes), [key](const char *passType) {
+        return key == QLatin1StringView(passType);
+    });
+}
+
+int PassPrivate::passTypeIndex(QLatin1StringView key)
+{
+    const auto it = std::find_if(std::begin(passTypes), std::end(passTypes), [key](const char *passType) {
+        return key == QLatin1StringView(passType);
+    });
+    return it == std::end(passTypes) ? -1 : static_cast<int>(std::distance(std::begin(passTypes), it));
 }
 
 QString PassPrivate::message(const QString &key) const
 {
-    const auto it = messages.constFind(key);
-    if (it != messages.constEnd()) {
+    return lookupMessage(key, activeCatalog());
+}
+
+QString PassPrivate::message(const QString &key, const QString &language) const
+{
+    auto messages = catalog(language);
+    if (!messages) {
+        messages = catalog(u"en"_s);
+    }
+    return lookupMessage(key, messages);
+}
+
+QString PassPrivate::lookupMessage(const QString &key, const QHash<QString, QString> *messages)
+{
+    if (!messages) {
+        return key;
+    }
+    const auto it = messages->constFind(key);
+    if (it != messages->constEnd()) {
         return it.value();
     }
     return key;
 }
 
-void PassPrivate::parse()
+namespace
+{
+struct DefaultLanguage {
+    QReadWriteLock lock;
+    QString language;
+    std::atomic<int> generation = 0;
+};
+}
+
+Q_GLOBAL_STATIC(DefaultLanguage, s_defaultLanguage)
+
+static QString normalizedLanguage(QString lang)
 {
-    // find the first matching message catalog
-    const auto langs = QLocale().uiLanguages();
-    for (auto lang : langs) {
-        auto idx = lang.indexOf(QLatin1Char('-'));
-        if (idx > 0) {
-            lang = lang.left(idx);
+    lang.replace(QLatin1Char('_'), QLatin1Char('-'));
+    return lang.toLower();
+}
+
+void PassPrivate::indexCatalogs()
+{
+    for (const auto &entry : std::as_const(archive->entries)) {
+        if (entry.endsWith(".lproj"_L1) && archive->reader->indexOf(QString(entry + "/pass.strings"_L1)) >= 0) {
+            languages.push_back(entry.left(entry.size() - 6));
         }
-        lang += QLatin1StringView(".lproj");
-        if (parseMessages(lang)) {
-            return;
+    }
+    languages.sort();
+}
+
+const QHash<QString, QString> *PassPrivate::parsedCatalog(const QString &lang) const
+{
+    {
+        QMutexLocker locker(&archive->mutex);
+        if (const auto it = catalogs.find(lang); it != catalogs.end()) {
+            return &(*it).second;
+        }
+    }
+    // parse without holding the lock, that's needed for archive access
+    // if another thread was faster meanwhile, its result is kept
+    auto messages = parseMessages(lang + ".lproj"_L1);
+    QMutexLocker locker(&archive->mutex);
+    return &(*catalogs.try_emplace(lang, std::move(messages)).first).second;
+}
+
+const QHash<QString, QString> *PassPrivate::catalog(const QString &lang, QString *catalogLanguage) const
+{
+    // try an exact match first, then only the language part
+    const auto normalized = normalizedLanguage(lang);
+    const auto idx = normalized.indexOf(QLatin1Char('-'));
+    QStringList candidates{normalized};
+    if (idx > 0) {
+        candidates.push_back(normalized.left(idx));
+    }
+    for (const auto &candidate : candidates) {
+        const auto it = std::find_if(languages.begin(), languages.end(), [&candidate](const auto &l) {
+            return normalizedLanguage(l) == candidate;
+        });
+        if (it == languages.end()) {
+            continue;
+        }
+
+        const auto messages = parsedCatalog(*it);
+        if (!messages->isEmpty()) {
+            if (catalogLanguage) {
+                *catalogLanguage = *it;
+            }
+            return messages;
+        }
+    }
+    return nullptr;
+}
+
+const QHash<QString, QString> *PassPrivate::activeCatalog() const
+{
+    const auto generation = s_defaultLanguage->generation.load();
+    QString selectedLanguage;
+    {
+        QMutexLocker locker(&archive->mutex);
+        if (currentCatalogGeneration == generation) {
+            return currentCatalog;
+        }
+        selectedLanguage = language;
+    }
+    KPKPASS_TRACE_SCOPE(lookupTrace, CatalogLookup, archive.get());
+
+    QStringList langs;
+    if (!selectedLanguage.isEmpty()) {
+        langs.push_back(selectedLanguage);
+    } else if (const auto defaultLanguage = Pass::defaultLanguage(); !defaultLanguage.isEmpty()) {
+        langs.push_back(defaultLanguage);
+    } else {
+        langs = QLocale().uiLanguages();
+    }
+    // fallback to English if we didn't find anything better
+    langs.push_back(u"en"_s);
+
+    const QHash<QString, QString> *messages = nullptr;
+    QString catalogLanguage;
+    for (const auto &lang : langs) {
+        if ((messages = catalog(lang, &catalogLanguage))) {
+            break;
         }
     }
+    KPKPASS_TRACE_SIZE(lookupTrace, messages ? messages->size() : 0);
 
-    // fallback to Englis if we didn't find anything better
-    parseMessages(QStringLiteral("en.lproj"));
+    QMutexLocker locker(&archive->mutex);
+    // don't overwrite the result for a language selected meanwhile
+    if (language == selectedLanguage) {
+        currentCatalog = messages;
+        currentCatalogGeneration = generation;
+        archive->catalogLanguage = catalogLanguage;
+    }
+    return messages;
 }
 
 static int indexOfUnquoted(const QString &catalog, QLatin1Char c, int start)
@@ -93,7 +233,7 @@ static QString unquote(QStringView str)
                 res.push_back(QLatin1Char('\r'));
             } else if (c2 == QLatin1Char('n')) {
                 res.push_back(QLatin1Char('\n'));
-            } else if (c2 == QLatin1Char('\\')) {
+            } else if (c2 == QLatin1Char('\\') || c2 == QLatin1Char('"')) {
                 res.push_back(c2);
             } else {
                 res.push_back(c1);
@@ -107,24 +247,29 @@ static QString unquote(QStringView str)
     return res;
 }
 
-bool PassPrivate::parseMessages(const QString &lang)
+QHash<QString, QString> PassPrivate::parseMessages(const QString &lang) const
 {
-    auto entry = zip->directory()->entry(lang);
-    if (!entry || !entry->isDirectory()) {
-        return false;
-    }
+    KPKPASS_TRACE_SCOPE(parseTrace, CatalogParse, archive.get());
+    QByteArray rawData;
+    {
+        QMutexLocker locker(&archive->mutex);
+        if (!archive->ensureOpen()) {
+            return {};
+        }
+        const auto file = archive->reader->indexOf(QString(lang + "/pass.strings"_L1));
+        if (file < 0) {
+            return {};
+        }
 
-    auto dir = static_cast<const KArchiveDirectory *>(entry);
-    auto file = dir->file(QStringLiteral("pass.strings"));
-    if (!file) {
-        return false;
+        if (archive->readFile(file, rawData, archive->options.maximumCatalogSize()) != LoadOptions::NoError) {
+            return {};
+        }
     }
-
-    std::unique_ptr<QIODevice> dev(file->createDevice());
-    const auto rawData = dev->readAll();
+    KPKPASS_TRACE_SIZE(parseTrace, rawData.size());
     if (rawData.size() < 4) {
-        return false;
+        return {};
     }
+    const auto rawSize = rawData.size();
     // this should be UTF-16BE, but that doesn't stop Eurowings from using UTF-8,
     // so do a primitive auto-detection here. UTF-16's first byte would either be the BOM
     // or \0.
@@ -136,6 +281,7 @@ bool PassPrivate::parseMessages(const QString &lang)
         catalog = codec(rawData);
     }
 
+    QHash<QString, QString> messages;
     int idx = 0;
     while (idx < catalog.size()) {
         // key
@@ -158,50 +304,132 @@ bool PassPrivate::parseMessages(const QString &lang)
             break;
         }
 
-        const auto key = catalog.mid(keyBegin, keyEnd - keyBegin);
-        const auto value = unquote(QStringView(catalog).mid(valueBegin, valueEnd - valueBegin));
+        // catalog content is largely identical across passes from the same issuer
+        const auto key = StringPool::intern(QStringView(catalog).mid(keyBegin, keyEnd - keyBegin));
+        const auto value = StringPool::intern(unquote(QStringView(catalog).mid(valueBegin, valueEnd - valueBegin)));
         messages.insert(key, value);
         idx = valueEnd + 1; // there's at least the linebreak and/or a ';'
     }
 
-    return !messages.isEmpty();
+    QMutexLocker locker(&archive->mutex);
+    archive->count(&LoadCounters::catalogCount, 1);
+    archive->count(&LoadCounters::catalogSize, rawSize);
+    archive->count(&LoadCounters::catalogEntryCount, messages.size());
+    return messages;
 }
 
-QList<Field> PassPrivate::fields(QLatin1StringView fieldType, const Pass *q, int row) const
+PassStyle PassPrivate::style() const
 {
-    const auto a = passData().value(fieldType).toArray();
-    QList<Field> f;
-    f.reserve(a.size());
-    for (const auto &v : a) {
-        Field fld{v.toObject(), q};
-        if (row >= 0 && fld.row() != row) {
+    if (!m_style) {
+        m_style = PassStylePrivate::create(passObj, archive->imageBaseNames());
+    }
+    return PassStyle(std::shared_ptr(m_style));
+}
+
+SemanticTags PassPrivate::semantics(const Pass *q) const
+{
+    const auto catalog = activeCatalog();
+    if (!m_semantics || m_semanticsCatalog != catalog) {
+        m_semantics = SemanticTagsPrivate::create(this, passObj.value("semantics"_L1).toObject(), elements(q).seats);
+        m_semanticsCatalog = catalog;
+    }
+    return *m_semantics;
+}
+
+const PassElements &PassPrivate::elements(const Pass *q) const
+{
+    if (!m_elements) {
+        m_elements.emplace(PassStorage::create(this, q));
+    }
+    return *m_elements;
+}
+
+static void hashArchiveFiles(PassArchive *archive, QHash<QString, QString> &hashes)
+{
+    const auto &files = archive->reader->files();
+    for (qsizetype i = 0; i < (qsizetype)files.size(); ++i) {
+        const auto &path = files[i].path;
+        if (path == "manifest.json"_L1 || path == "signature"_L1) {
+            continue;
+        }
+        QByteArray data;
+        if (archive->readFile(i, data) != LoadOptions::NoError) {
             continue;
         }
-        f.push_back(std::move(fld));
+        hashes.insert(path, QString::fromLatin1(QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex()));
     }
-    return f;
 }
 
-Pass *PassPrivate::fromData(std::unique_ptr<QIODevice> device, QObject *parent)
+QHash<QString, QString> PassPrivate::assetHashes() const
+{
+    QHash<QString, QString> hashes;
+    QMutexLocker locker(&archive->mutex);
+    if (!archive->ensureOpen()) {
+        return hashes;
+    }
+    if (const auto file = archive->reader->indexOf(u"manifest.json"); file >= 0) {
+        QByteArray data;
+        (void)archive->readFile(file, data);
+        const auto manifest = QJsonDocument::fromJson(data).object();
+        for (auto it = manifest.begin(); it != manifest.end(); ++it) {
+            hashes.insert(it.key(), it.value().toString());
+        }
+        if (!hashes.isEmpty()) {
+            return hashes;
+        }
+    }
+
+    hashArchiveFiles(archive.get(), hashes);
+    return hashes;
+}
+
+Pass *PassPrivate::fromData(std::unique_ptr<QIODevice> device, const LoadOptions &options, LoadOptions::Error *loadError, QObject *parent)
 {
-    std::unique_ptr<KZip> zip(new KZip(device.get()));
-    if (!zip->open(QIODevice::ReadOnly)) {
-        qCWarning(Log) << "Failed to open ZIP file" << zip->errorString();
+    const auto fail = [loadError](LoadOptions::Error e) -> Pass * {
+        if (loadError) {
+            *loadError = e;
+        }
         return nullptr;
+    };
+
+    auto archive = std::make_shared<PassArchive>();
+    archive->options = options;
+    KPKPASS_TRACE_SCOPE(loadTrace, PassLoad, archive.get());
+    KPKPASS_TRACE_SIZE(loadTrace, device->size());
+    {
+        KPKPASS_TRACE_SCOPE(openTrace, ArchiveOpen, archive.get());
+        KPKPASS_TRACE_SIZE(openTrace, device->size());
+        if (const auto res = archive->open(std::move(device)); res != LoadOptions::NoError) {
+            return fail(res);
+        }
     }
 
     // extract pass.json
-    auto file = zip->directory()->file(QStringLiteral("pass.json"));
-    if (!file) {
+    const auto file = archive->reader->indexOf(u"pass.json");
+    if (file < 0) {
         qCWarning(Log) << "Cannot find pass.json file";
-        return nullptr;
+        return fail(LoadOptions::InvalidPassJson);
     }
-    std::unique_ptr<QIODevice> dev(file->createDevice());
+    QByteArray data;
+    {
+        KPKPASS_TRACE_SCOPE(extractTrace, PassJsonExtract, archive.get());
+        if (const auto res = archive->readFile(file, data); res != LoadOptions::NoError) {
+            return fail(res);
+        }
+        KPKPASS_TRACE_SIZE(extractTrace, data.size());
+    }
+    archive->count(&LoadCounters::passJsonSize, data.size());
     QJsonParseError error;
-    const auto data = dev->readAll();
-    auto passObj = QJsonDocument::fromJson(data, &error).object();
+    QJsonObject passObj;
+    {
+        KPKPASS_TRACE_SCOPE(parseTrace, JsonParse, archive.get());
+        KPKPASS_TRACE_SIZE(parseTrace, data.size());
+        passObj = QJsonDocument::fromJson(data, &error).object();
+    }
     if (error.error != QJsonParseError::NoError) {
         qCWarning(Log) << "Error parsing pass.json:" << error.errorString() << error.offset;
+        KPKPASS_TRACE_SCOPE(repairTrace, JsonRepair, archive.get());
+        KPKPASS_TRACE_SIZE(repairTrace, data.size());
 
         // try to fix some known JSON syntax errors
         auto s = QString::fromUtf8(data);
@@ -210,12 +438,13 @@ Pass *PassPrivate::fromData(std::unique_ptr<QIODevice> device, QObject *parent)
         passObj = QJsonDocument::fromJson(s.toUtf8(), &error).object();
         if (error.error != QJsonParseError::NoError) {
             qCWarning(Log) << "JSON syntax workarounds didn't help either:" << error.errorString() << error.offset;
-            return nullptr;
+            return fail(LoadOptions::InvalidPassJson);
         }
+        archive->count(&LoadCounters::jsonRepairCount, 1);
     }
     if (passObj.value(QLatin1StringView("formatVersion")).toInt() > 1) {
         qCWarning(Log) << "pass.json has unsupported format version!";
-        return nullptr;
+        return fail(LoadOptions::UnsupportedPass);
     }
 
     // determine pass type
@@ -228,24 +457,29 @@ Pass *PassPrivate::fromData(std::unique_ptr<QIODevice> device, QObject *parent)
     }
     if (passTypeIdx < 0) {
         qCWarning(Log) << "pkpass file has no pass data structure!";
-        return nullptr;
+        return fail(LoadOptions::UnsupportedPass);
+    }
+
+    archive->count(&LoadCounters::passCount, 1);
+    archive->commitStatistics();
+    auto pass = create(static_cast<Pass::Type>(passTypeIdx), parent);
+    pass->d->archive = std::move(archive);
+    pass->d->passObj = passObj;
+    pass->d->indexCatalogs();
+    if (loadError) {
+        *loadError = LoadOptions::NoError;
     }
+    return pass;
+}
 
-    Pass *pass = nullptr;
-    switch (passTypeIdx) {
+Pass *PassPrivate::create(Pass::Type type, QObject *parent)
+{
+    switch (type) {
     case Pass::BoardingPass:
-        pass = new KPkPass::BoardingPass(parent);
-        break;
+        return new KPkPass::BoardingPass(parent);
     default:
-        pass = new Pass(static_cast<Pass::Type>(passTypeIdx), parent);
-        break;
+        return new Pass(type, parent);
     }
-
-    pass->d->buffer = std::move(device);
-    pass->d->zip = std::move(zip);
-    pass->d->passObj = passObj;
-    pass->d->parse();
-    return pass;
 }
 
 Pass::Pass(Type passType, QObject *parent)
@@ -294,14 +528,7 @@ bool Pass::isVoided() const
 
 QList<Location> Pass::locations() const
 {
-    QList<Location> locs;
-    const auto a = d->passObj.value(QLatin1StringView("locations")).toArray();
-    locs.reserve(a.size());
-    for (const auto &loc : a) {
-        locs.push_back(Location(loc.toObject()));
-    }
-
-    return locs;
+    return d->elements(this).locations;
 }
 
 int Pass::maximumDistance() const
@@ -314,48 +541,29 @@ QDateTime Pass::relevantDate() const
     return QDateTime::fromString(d->passObj.value(QLatin1StringView("relevantDate")).toString(), Qt::ISODate);
 }
 
-static QColor parseColor(QStringView s)
-{
-    if (s.startsWith("rgb("_L1, Qt::CaseInsensitive)) {
-        const auto l = s.mid(4, s.length() - 5).split(','_L1);
-        if (l.size() != 3) {
-            return {};
-        }
-        return QColor(l[0].trimmed().toInt(), l[1].trimmed().toInt(), l[2].trimmed().toInt());
-    }
-    if (s.startsWith("rgba("_L1, Qt::CaseInsensitive)) {
-        const auto l = s.mid(5, s.length() - 6).split(','_L1);
-        if (l.size() != 4) {
-            return {};
-        }
-        return QColor(l[0].trimmed().toInt(), l[1].trimmed().toInt(), l[2].trimmed().toInt(), l[3].trimmed().toDouble() * 255.0);
-    }
-    return QColor(s);
-}
-
 bool Pass::hasBackgroundColor() const
 {
-    return d->passObj.value("backgroundColor"_L1).isString();
+    return d->style().hasBackgroundColor();
 }
 
 bool Pass::hasForegroundColor() const
 {
-    return d->passObj.value("foregroundColor"_L1).isString();
+    return d->style().hasForegroundColor();
 }
 
 bool Pass::hasLabelColor() const
 {
-    return d->passObj.value("labelColor"_L1).isString() || hasForegroundColor();
+    return d->style().hasLabelColor();
 }
 
 QColor Pass::backgroundColor() const
 {
-    return parseColor(d->passObj.value("backgroundColor"_L1).toString());
+    return d->style().backgroundColor();
 }
 
 QColor Pass::foregroundColor() const
 {
-    return parseColor(d->passObj.value("foregroundColor"_L1).toString());
+    return d->style().foregroundColor();
 }
 
 QString Pass::groupingIdentifier() const
@@ -365,11 +573,7 @@ QString Pass::groupingIdentifier() const
 
 QColor Pass::labelColor() const
 {
-    const auto c = parseColor(d->passObj.value("labelColor"_L1).toString());
-    if (c.isValid()) {
-        return c;
-    }
-    return foregroundColor();
+    return d->style().labelColor();
 }
 
 QString Pass::logoText() const
@@ -379,113 +583,67 @@ QString Pass::logoText() const
 
 bool Pass::hasImage(const QString &baseName) const
 {
-    const auto entries = d->zip->directory()->entries();
-    for (const auto &entry : entries) {
-        if (entry.startsWith(baseName)
-            && (QStringView(entry).mid(baseName.size()).startsWith('@'_L1) || QStringView(entry).mid(baseName.size()).startsWith('.'_L1))
-            && entry.endsWith(".png"_L1)) {
-            return true;
-        }
-    }
-    return false;
+    return d->archive->hasImage(baseName);
 }
 
 bool Pass::hasIcon() const
 {
-    return hasImage(QStringLiteral("icon"));
+    return d->style().hasImage(PassStyle::Icon);
 }
 
 bool Pass::hasLogo() const
 {
-    return hasImage(QStringLiteral("logo"));
+    return d->style().hasImage(PassStyle::Logo);
 }
 
 bool Pass::hasPrimaryLogo() const
 {
-    return hasImage(u"primaryLogo"_s);
+    return d->style().hasImage(PassStyle::PrimaryLogo);
 }
 
 bool Pass::hasSecondaryLogo() const
 {
-    return hasImage(u"secondaryLogo"_s);
+    return d->style().hasImage(PassStyle::SecondaryLogo);
 }
 
 bool Pass::hasStrip() const
 {
-    return hasImage(QStringLiteral("strip"));
+    return d->style().hasImage(PassStyle::Strip);
 }
 
 bool Pass::hasBackground() const
 {
-    return hasImage(QStringLiteral("background"));
+    return d->style().hasImage(PassStyle::Background);
 }
 
 bool Pass::hasArtwork() const
 {
-    return hasImage(u"artwork"_s);
+    return d->style().hasImage(PassStyle::Artwork);
 }
 
 bool Pass::hasFooter() const
 {
-    return hasImage(QStringLiteral("footer"));
+    return d->style().hasImage(PassStyle::Footer);
 }
 
 bool Pass::hasThumbnail() const
 {
-    return hasImage(QStringLiteral("thumbnail"));
+    return d->style().hasImage(PassStyle::Thumbnail);
 }
 
 QImage Pass::image(const QString &baseName, unsigned int devicePixelRatio) const
 {
-    const KArchiveFile *file = nullptr;
-    QImage img;
-
-    auto dpr = devicePixelRatio;
-    for (; dpr > 0; --dpr) {
-        const auto it = d->m_images.find(ImageCacheKey{baseName, dpr});
-        if (it != d->m_images.end()) {
-            img = (*it).second;
-            break;
-        }
-        if (dpr > 1) {
-            file = d->zip->directory()->file(baseName + '@'_L1 + QString::number(dpr) + "x.png"_L1);
-        } else {
-            file = d->zip->directory()->file(baseName + ".png"_L1);
-        }
-        if (file) {
-            break;
-        }
-    }
-    if (!img.isNull()) { // cache hit
-        return img;
-    }
-
-    // no hit, check if there is any variant at all (happens in passes only containing eg. a 3x variant)
-    // (matches what hasImage does)
-    if (!file) {
-        const auto entries = d->zip->directory()->entries();
-        for (const auto &entry : entries) {
-            if (entry.startsWith(baseName)
-                && (QStringView(entry).mid(baseName.size()).startsWith('@'_L1) || QStringView(entry).mid(baseName.size()).startsWith('.'_L1))
-                && entry.endsWith(".png"_L1)) {
-                file = d->zip->directory()->file(entry);
-                break;
-            }
-        }
-    }
+    return d->archive->image(baseName, devicePixelRatio);
+}
 
-    if (!file) {
-        return {};
-    }
+PassStyle Pass::style() const
+{
+    return d->style();
+}
 
-    std::unique_ptr<QIODevice> dev(file->createDevice());
-    img = QImage::fromData(dev->readAll());
-    img.setDevicePixelRatio(dpr);
-    d->m_images[ImageCacheKey{baseName, dpr}] = img;
-    if (dpr != devicePixelRatio) {
-        d->m_images[ImageCacheKey{baseName, devicePixelRatio}] = img;
-    }
-    return img;
+PassAssets Pass::assets() const
+{
+    return PassAssets(d->archive);
 }
 
 QImage Pass::icon(unsigned int devicePixelRatio) const
@@ -540,13 +698,7 @@ QString Pass::authenticationToken() const
 
 QStringList Pass::preferredStyleSchemes() const
 {
-    const auto styleArray = d->passObj.value("preferredStyleSchemes"_L1).toArray();
-    QStringList l;
-    l.reserve(styleArray.size());
-    std::ranges::transform(styleArray, std::back_inserter(l), [](const auto &v) {
-        return v.toString();
-    });
-    return l;
+    return d->style().preferredStyleSchemes();
 }
 
 QUrl Pass::webServiceUrl() const
@@ -571,101 +723,66 @@ bool Pass::hasBarcode() const
 
 QList<Barcode> Pass::barcodes() const
 {
-    QList<Barcode> codes;
-
-    // barcodes array
-    const auto a = d->passObj.value("barcodes"_L1).toArray();
-    codes.reserve(a.size());
-    for (const auto &bc : a) {
-        codes.push_back(Barcode(bc.toObject(), this));
-    }
-
-    // just a single barcode
-    if (codes.isEmpty()) {
-        const auto bc = d->passObj.value("barcode"_L1).toObject();
-        if (!bc.isEmpty()) {
-            codes.push_back(Barcode(bc, this));
-        }
-    }
-
-    return codes;
+    return d->elements(this).barcodes;
 }
 
-static const char *const fieldNames[] = {"auxiliaryFields", "backFields", "headerFields", "primaryFields", "secondaryFields"};
-static const auto fieldNameCount = sizeof(fieldNames) / sizeof(fieldNames[0]);
-
 int Pass::auxiliaryFieldsRowCount() const
 {
-    int maxRow = 0;
-    const auto auxFields = d->passData().value(QLatin1StringView(fieldNames[0])).toArray();
-    for (const auto &v : auxFields) {
-        const auto auxField = v.toObject();
-        maxRow = std::max(maxRow, auxField.value("row"_L1).toInt(0));
-    }
-    return maxRow + 1;
+    return d->elements(this).auxiliaryFieldsRowCount;
 }
 
 QList<Field> Pass::auxiliaryFields() const
 {
-    return d->fields(QLatin1StringView(fieldNames[0]), this);
+    return d->elements(this).sections[PassStorage::AuxiliaryFields];
 }
 
 QList<Field> Pass::backFields() const
 {
-    return d->fields(QLatin1StringView(fieldNames[1]), this);
+    return d->elements(this).sections[PassStorage::BackFields];
 }
 
 QList<Field> Pass::headerFields() const
 {
-    return d->fields(QLatin1StringView(fieldNames[2]), this);
+    return d->elements(this).sections[PassStorage::HeaderFields];
 }
 
 QList<Field> Pass::primaryFields() const
 {
-    return d->fields(QLatin1StringView(fieldNames[3]), this);
+    return d->elements(this).sections[PassStorage::PrimaryFields];
 }
 
 QList<Field> Pass::secondaryFields() const
 {
-    return d->fields(QLatin1StringView(fieldNames[4]), this);
+    return d->elements(this).sections[PassStorage::SecondaryFields];
 }
 
 QList<Field> Pass::auxiliaryFieldsInRow(int row) const
 {
-    return d->fields(QLatin1StringView(fieldNames[0]), this, row);
+    const auto &fields = d->elements(this).sections[PassStorage::AuxiliaryFields];
+    QList<Field> f;
+    std::copy_if(fields.begin(), fields.end(), std::back_inserter(f), [row](const auto &field) {
+        return row < 0 || field.row() == row;
+    });
+    return f;
 }
 
 Field Pass::field(const QString &key) const
 {
-    for (unsigned int i = 0; i < fieldNameCount; ++i) {
-        const auto fs = d->fields(QLatin1StringView(fieldNames[i]), this);
-        for (const auto &f : fs) {
-            if (f.key() == key) {
-                return f;
-            }
-        }
-    }
-    return {};
+    const auto &fields = d->elements(this).fields;
+    const auto it = std::find_if(fields.begin(), fields.end(), [&key](const auto &f) {
+        return f.key() == key;
+    });
+    return it != fields.end() ? *it : Field();
 }
 
 QList<Field> Pass::fields() const
 {
-    QList<Field> fs;
-    for (unsigned int i = 0; i < fieldNameCount; ++i) {
-        fs += d->fields(QLatin1StringView(fieldNames[i]), this);
-    }
-    return fs;
+    return d->elements(this).fields;
 }
 
 QList<Seat> Pass::seats() const
 {
-    const auto a = semanticTags().value("seats"_L1).toArray();
-    QList<Seat> seats;
-    seats.reserve(a.size());
-    std::ranges::transform(a, std::back_inserter(seats), [this](const QJsonValue &v) {
-        return Seat(v.toObject(), this);
-    });
-    return seats;
+    return d->elements(this).seats;
 }
 
 QJsonObject Pass::semanticTags() const
@@ -673,11 +790,61 @@ QJsonObject Pass::semanticTags() const
     return d->passObj.value("semantics"_L1).toObject();
 }
 
+SemanticTags Pass::semantics() const
+{
+    return d->semantics(this);
+}
+
 QString Pass::lookupMessage(const QString &msg) const
 {
     return d->message(msg);
 }
 
+QString Pass::lookupMessage(const QString &msg, const QString &language) const
+{
+    if (language.isEmpty()) {
+        return d->message(msg);
+    }
+    return d->message(msg, language);
+}
+
+QStringList Pass::languages() const
+{
+    return d->languages;
+}
+
+QString Pass::language() const
+{
+    QMutexLocker locker(&d->archive->mutex);
+    return d->language;
+}
+
+void Pass::setLanguage(const QString &language)
+{
+    {
+        QMutexLocker locker(&d->archive->mutex);
+        if (d->language == language) {
+            return;
+        }
+        d->language = language;
+        d->currentCatalogGeneration = -1;
+    }
+    Q_EMIT languageChanged();
+}
+
+QString Pass::defaultLanguage()
+{
+    QReadLocker locker(&s_defaultLanguage->lock);
+    return s_defaultLanguage->language;
+}
+
+void Pass::setDefaultLanguage(const QString &language)
+{
+    QWriteLocker locker(&s_defaultLanguage->lock);
+    s_defaultLanguage->language = language;
+    ++s_defaultLanguage->generation;
+}
+
 QJsonValue Pass::rawValue(const QString &key) const
 {
     return d->passObj.value(key);
@@ -693,20 +860,42 @@ QJsonValue Pass::rawValue(QLatin1StringView key) const
 }
 
 Pass *Pass::fromData(const QByteArray &data, QObject *parent)
+{
+    return fromData(data, LoadOptions(), nullptr, parent);
+}
+
+Pass *Pass::fromData(const QByteArray &data, const LoadOptions &options, LoadOptions::Error *error, QObject *parent)
 {
     std::unique_ptr<QBuffer> buffer(new QBuffer);
     buffer->setData(data);
     buffer->open(QBuffer::ReadOnly);
-    return PassPrivate::fromData(std::move(buffer), parent);
+    return PassPrivate::fromData(std::move(buffer), options, error, parent);
 }
 
 Pass *Pass::fromFile(const QString &fileName, QObject *parent)
+{
+    return fromFile(fileName, LoadOptions(), nullptr, parent);
+}
+
+Pass *Pass::fromFile(const QString &fileName, const LoadOptions &options, LoadOptions::Error *error, QObject *parent)
 {
     std::unique_ptr<QFile> file(new QFile(fileName));
     if (file->open(QFile::ReadOnly)) {
-        return PassPrivate::fromData(std::move(file), parent);
+        // what we actually read, for stamping cache files written later
+        const auto size = file->size();
+        const auto lastModified = file->fileTime(QFileDevice::FileModificationTime).toMSecsSinceEpoch();
+        auto pass = PassPrivate::fromData(std::move(file), options, error, parent);
+        if (pass) {
+            pass->d->archive->fileName = fileName;
+            pass->d->archive->expectedSize = size;
+            pass->d->archive->expectedLastModified = lastModified;
+        }
+        return pass;
     }
     qCWarning(Log) << "Failed to open" << fileName << ":" << file->errorString();
+    if (error) {
+        *error = LoadOptions::FileError;
+    }
     return nullptr;
 }
 
@@ -722,11 +911,22 @@ QVariantMap Pass::fieldsVariantMap() const
 
 QByteArray Pass::rawData() const
 {
-    const auto prevPos = d->buffer->pos();
-    d->buffer->seek(0);
-    const auto data = d->buffer->readAll();
-    d->buffer->seek(prevPos);
+    QMutexLocker locker(&d->archive->mutex);
+    if (!d->archive->ensureOpen()) {
+        return {};
+    }
+    const auto &buffer = d->archive->buffer;
+    const auto prevPos = buffer->pos();
+    buffer->seek(0);
+    const auto data = buffer->readAll();
+    buffer->seek(prevPos);
     return data;
 }
 
+LoadStatistics Pass::loadStatistics() const
+{
+    QMutexLocker locker(&d->archive->mutex);
+    return LoadStatisticsPrivate::create(d->archive->statistics, d->archive->catalogLanguage);
+}
+
 #include "moc_pass.cpp"
@@ -8,15 +8,18 @@
 
 #include "field.h"
 #include "kpkpass_export.h"
+#include "loadoptions.h"
 
 #include <QList>
 #include <QObject>
+#include <QSize>
 
 #include <memory>
 
 class QByteArray;
 class QColor;
 class QDateTime;
+class QIODevice;
 class QString;
 class QUrl;
 class QVariant;
@@ -25,8 +28,12 @@ namespace KPkPass
 {
 class Barcode;
 class Location;
+class LoadStatistics;
+class PassAssets;
+class PassStyle;
 class PassPrivate;
 class Seat;
+class SemanticTags;
 
 /*!
  * \sa https://developer.apple.com/library/archive/documentation/UserExperience/Conceptual/PassKit_PG/index.html
@@ -41,8 +48,8 @@ class KPKPASS_EXPORT Pass : public QObject
     Q_OBJECT
     Q_PROPERTY(Type type READ type CONSTANT)
 
-    Q_PROPERTY(QString description READ description CONSTANT)
-    Q_PROPERTY(QString organizationName READ organizationName CONSTANT)
+    Q_PROPERTY(QString description READ description NOTIFY languageChanged)
+    Q_PROPERTY(QString organizationName READ organizationName NOTIFY languageChanged)
     Q_PROPERTY(QString passTypeIdentifier READ passTypeIdentifier CONSTANT)
     Q_PROPERTY(QString serialNumber READ serialNumber CONSTANT)
 
@@ -59,7 +66,7 @@ class KPKPASS_EXPORT Pass : public QObject
     Q_PROPERTY(QColor foregroundColor READ foregroundColor CONSTANT)
     Q_PROPERTY(QString groupingIdentifier READ groupingIdentifier CONSTANT)
     Q_PROPERTY(QColor labelColor READ labelColor CONSTANT)
-    Q_PROPERTY(QString logoText READ logoText CONSTANT)
+    Q_PROPERTY(QString logoText READ logoText NOTIFY languageChanged)
 
     Q_PROPERTY(bool hasIcon READ hasIcon CONSTANT)
     Q_PROPERTY(bool hasLogo READ hasLogo CONSTANT)
@@ -72,22 +79,26 @@ class KPKPASS_EXPORT Pass : public QObject
     Q_PROPERTY(bool hasThumbnail READ hasThumbnail CONSTANT)
 
     Q_PROPERTY(QStringList preferredStyleSchemes READ preferredStyleSchemes CONSTANT)
+    Q_PROPERTY(KPkPass::PassStyle style READ style CONSTANT)
 
     Q_PROPERTY(bool hasBarcode READ hasBarcode CONSTANT)
-    Q_PROPERTY(QList<KPkPass::Barcode> barcodes READ barcodes CONSTANT)
+    Q_PROPERTY(QList<KPkPass::Barcode> barcodes READ barcodes NOTIFY languageChanged)
 
     Q_PROPERTY(int auxiliaryFieldsRowCount READ auxiliaryFieldsRowCount CONSTANT)
-    Q_PROPERTY(QList<KPkPass::Field> auxiliaryFields READ auxiliaryFields CONSTANT)
-    Q_PROPERTY(QList<KPkPass::Field> backFields READ backFields CONSTANT)
-    Q_PROPERTY(QList<KPkPass::Field> headerFields READ headerFields CONSTANT)
-    Q_PROPERTY(QList<KPkPass::Field> primaryFields READ primaryFields CONSTANT)
-    Q_PROPERTY(QList<KPkPass::Field> secondaryFields READ secondaryFields CONSTANT)
-    Q_PROPERTY(QList<KPkPass::Location> locations READ locations CONSTANT)
-    Q_PROPERTY(QVariantMap field READ fieldsVariantMap CONSTANT)
+    Q_PROPERTY(QList<KPkPass::Field> auxiliaryFields READ auxiliaryFields NOTIFY languageChanged)
+    Q_PROPERTY(QList<KPkPass::Field> backFields READ backFields NOTIFY languageChanged)
+    Q_PROPERTY(QList<KPkPass::Field> headerFields READ headerFields NOTIFY languageChanged)
+    Q_PROPERTY(QList<KPkPass::Field> primaryFields READ primaryFields NOTIFY languageChanged)
+    Q_PROPERTY(QList<KPkPass::Field> secondaryFields READ secondaryFields NOTIFY languageChanged)
+    Q_PROPERTY(QList<KPkPass::Location> locations READ locations NOTIFY languageChanged)
+    Q_PROPERTY(QVariantMap field READ fieldsVariantMap NOTIFY languageChanged)
 
     Q_PROPERTY(QList<KPkPass::Seat> seats READ seats CONSTANT)
 
     Q_PROPERTY(QJsonObject semanticTags READ semanticTags CONSTANT)
+    Q_PROPERTY(KPkPass::SemanticTags semantics READ semantics NOTIFY languageChanged)
+
+    Q_PROPERTY(QString language READ language WRITE setLanguage NOTIFY languageChanged)
 
 public:
     ~Pass() override;
@@ -103,6 +114,59 @@ public:
     Q_ENUM(Type)
     [[nodiscard]] Type type() const;
 
+    /*!
+     * \brief Result of Pass::probe().
+     * \since 26.08
+     */
+    struct ProbeResult {
+        /*! \c true if the input looks like a pass we can load. */
+        bool isValid = false;
+        /*! The pass type, only meaningful if isValid is \c true. */
+        Type type = Generic;
+        /*! The format version declared in pass.json, \c 0 if missing. */
+        int formatVersion = 0;
+    };
+
+    /*! Checks whether \a data is a pass file and determines its type, without loading it.
+     *
+     *  This only reads the ZIP central directory and scans pass.json until
+     *  the format version and the pass type are found, and is therefore
+     *  much cheaper than fromData(). It's meant for e.g. content type detection,
+     *  a valid result does not guarantee that fromData() will succeed.
+     *  At most 512 KiB of pass.json are scanned, inputs needing more than
+     *  that are considered invalid.
+     *  \since 26.08
+     */
+    [[nodiscard]] static ProbeResult probe(const QByteArray &data);
+    /*! Same as above, for a seekable and already opened \a device. */
+    [[nodiscard]] static ProbeResult probe(QIODevice *device);
+    /*! Same as above, for the file \a fileName. */
+    [[nodiscard]] static ProbeResult probeFile(const QString &fileName);
+
+    /*! Reads a single image asset from the pass file \a data, without loading the pass.
+     *
+     *  The image variant is selected the same way as by image(), and only
+     *  that archive entry is decompressed and decoded. This is meant for
+     *  e.g. thumbnailers, which don't need pass.json or translations.
+     *
+     *  \a baseName The name of the asset, without the file name extension.
+     *  \a devicePixelRatio The device pixel ratio, for selecting highdpi assets.
+     *  \a size If valid, the image is scaled down during decoding to fit into this size (in device-independent pixels).
+     *  \a options Resource limits applied to reading the image.
+     *  \since 26.08
+     */
+    [[nodiscard]] static QImage imageFromData(const QByteArray &data,
+                                              const QString &baseName,
+                                              unsigned int devicePixelRatio = 1,
+                                              const QSize &size = {},
+                                              const LoadOptions &options = {});
+    /*! Same as above, for the file \a fileName. */
+    [[nodiscard]] static QImage imageFromFile(const QString &fileName,
+                                              const QString &baseName,
+                                              unsigned int devicePixelRatio = 1,
+                                              const QSize &size = {},
+                                              const LoadOptions &options = {});
+
     // standard keys
     [[nodiscard]] QString description() const;
     [[nodiscard]] QString organizationName() const;
@@ -155,6 +219,10 @@ public:
      *  \a devicePixelRatio The device pixel ration, for loading highdpi assets.
      */
     [[nodiscard]] QImage image(const QString &baseName, unsigned int devicePixelRatio = 1) const;
+    /*! Returns a handle for thread-safe access to the image assets of this pass.
+     *  \since 26.08
+     */
+    [[nodiscard]] PassAssets assets() const;
     /*! Returns the pass icon. */
     Q_INVOKABLE [[nodiscard]] QImage icon(unsigned int devicePixelRatio = 1) const;
     /*! Returns the pass logo. */
@@ -185,6 +253,11 @@ public:
      */
     [[nodiscard]] QStringList preferredStyleSchemes() const;
 
+    /*! All visual appearance properties of this pass, resolved once.
+     *  \since 26.08
+     */
+    [[nodiscard]] PassStyle style() const;
+
     // web service keys
     [[nodiscard]] QString authenticationToken() const;
     [[nodiscard]] QUrl webServiceUrl() const;
@@ -204,7 +277,7 @@ public:
     [[nodiscard]] QList<Field> primaryFields() const;
     [[nodiscard]] QList<Field> secondaryFields() const;
 
-    /*! Returns only those auxiliary fields in \p row.
+    /*! Returns only those auxiliary fields in \p row, or all of them for a negative \p row.
      *  \since 26.08
      */
     Q_INVOKABLE [[nodiscard]] QList<Field> auxiliaryFieldsInRow(int row) const;
@@ -224,12 +297,57 @@ public:
      */
     [[nodiscard]] QJsonObject semanticTags() const;
 
+    /*! Returns the semantic tags as typed, localized values.
+     *  This is parsed once and cached, unlike semanticTags().
+     *  \since 26.08
+     */
+    [[nodiscard]] SemanticTags semantics() const;
+
     /*! Lookup a message in the passes translation catalog.
      *  This is mainly necessary for semantic tags or raw values of
      *  type localized string, other properties already do this internally.
      *  \since 26.08
      */
     Q_INVOKABLE [[nodiscard]] QString lookupMessage(const QString &msg) const;
+    /*! Lookup a message in the translation catalog for \a language,
+     *  falling back to English, independent of the language selected for this pass.
+     *  This is safe to call from multiple threads concurrently, e.g. for
+     *  rendering one loaded pass for several users in different languages.
+     *  \sa setLanguage()
+     *  \since 26.08
+     */
+    Q_INVOKABLE [[nodiscard]] QString lookupMessage(const QString &msg, const QString &language) const;
+
+    /*! Languages this pass has translation catalogs for.
+     *  \since 26.08
+     */
+    [[nodiscard]] QStringList languages() const;
+    /*! The language explicitly selected for this pass, if any.
+     *  \since 26.08
+     */
+    [[nodiscard]] QString language() const;
+    /*! Selects the language used for localized content of this pass.
+     *  Translation catalogs are only parsed on first use, switching back
+     *  and forth between languages doesn't require reloading the pass.
+     *  An empty \a language resets this to defaultLanguage().
+     *
+     *  The selected language is state of this pass shared by everything
+     *  accessing it, such as fields() or description(). For using one pass
+     *  in several languages at the same time, use lookupMessage() with an
+     *  explicit language on the raw values instead.
+     *  \since 26.08
+     */
+    void setLanguage(const QString &language);
+
+    /*! The language used by passes without an explicitly selected language.
+     *  Empty by default, which means following QLocale::uiLanguages().
+     *  \since 26.08
+     */
+    [[nodiscard]] static QString defaultLanguage();
+    /*! Sets the default language for all passes.
+     *  \since 26.08
+     */
+    static void setDefaultLanguage(const QString &language);
 
     /*! Returns a raw entry from this pass' \c pass.json.
      *  Useful e.g. for semi-standardized additional flight information values.
@@ -243,6 +361,45 @@ public:
     static Pass *fromData(const QByteArray &data, QObject *parent = nullptr);
     /*! Create a appropriate sub-class based on the pkpass file type. */
     static Pass *fromFile(const QString &fileName, QObject *parent = nullptr);
+    /*! Create a appropriate sub-class based on the pkpass file type,
+     *  enforcing the resource limits in \a options.
+     *  If loading fails and \a error is not \c nullptr, the reason is stored there.
+     *  \since 26.08
+     */
+    static Pass *fromData(const QByteArray &data, const LoadOptions &options, LoadOptions::Error *error = nullptr, QObject *parent = nullptr);
+    /*! Create a appropriate sub-class based on the pkpass file type,
+     *  enforcing the resource limits in \a options.
+     *  If loading fails and \a error is not \c nullptr, the reason is stored there.
+     *  \since 26.08
+     */
+    static Pass *fromFile(const QString &fileName, const LoadOptions &options, LoadOptions::Error *error = nullptr, QObject *parent = nullptr);
+
+    /*! Load the pass file \a fileName, using the cache file \a cacheFileName.
+     *  If the cache is missing, unreadable or older than \a fileName, this
+     *  loads \a fileName like fromFile() and (re)writes the cache.
+     *  Passes restored from the cache only open \a fileName when
+     *  image assets or rawData() are accessed.
+     *  \sa writeCache()
+     *  \since 26.08
+     */
+    static Pass *fromFileCached(const QString &fileName, const QString &cacheFileName, QObject *parent = nullptr);
+    /*! Same as above, enforcing the resource limits in \a options.
+     *  \since 26.08
+     */
+    static Pass *fromFileCached(const QString &fileName,
+                                const QString &cacheFileName,
+                                const LoadOptions &options,
+                                LoadOptions::Error *error = nullptr,
+                                QObject *parent = nullptr);
+    /*! Writes the parsed state of this pass to \a cacheFileName.
+     *  That contains the pass metadata, all translation catalogs and the
+     *  archive index, and is tied to the pass file this was loaded from.
+     *  Returns \c false if writing failed or if this pass wasn't loaded
+     *  from a file.
+     *  \sa fromFileCached()
+     *  \since 26.08
+     */
+    bool writeCache(const QString &cacheFileName) const;
 
     /*! The raw data of this pass.
      *  That is the binary representation of the ZIP archive which contains
@@ -251,10 +408,26 @@ public:
      */
     [[nodiscard]] QByteArray rawData() const;
 
+    /*! Counters describing the work done for loading this pass so far,
+     *  including lazily parsed translation catalogs and decoded images.
+     *  \sa LoadStatistics::global()
+     *  \since 26.08
+     */
+    [[nodiscard]] LoadStatistics loadStatistics() const;
+
+Q_SIGNALS:
+    /*! Emitted when the language selected with setLanguage() changes,
+     *  and with it all properties depending on the translation catalogs.
+     *  Changes of the defaultLanguage() are not notified.
+     *  \since 26.08
+     */
+    void languageChanged();
+
 protected:
     ///\\ond internal
     friend class Barcode;
     friend class Field;
+    friend class PassDiffPrivate;
     friend class PassPrivate;
     friend class Seat;
     explicit Pass(Type passType, QObject *parent = nullptr);
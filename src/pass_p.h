@@ -7,57 +7,89 @@
 #pragma once
 
 #include "pass.h"
+#include "passarchive_p.h"
+#include "passstyle.h"
+#include "semantictags.h"
+#include "passstorage_p.h"
 
 #include <QHash>
-#include <QImage>
 #include <QJsonObject>
 #include <QString>
 
 #include <memory>
+#include <optional>
 #include <unordered_map>
 
-class KZip;
-class QIODevice;
-
 namespace KPkPass
 {
-struct ImageCacheKey {
-    QString name;
-    unsigned int dpr;
-    bool operator==(const ImageCacheKey &) const = default;
-};
-}
+class PassStylePrivate;
 
-template<>
-struct std::hash<KPkPass::ImageCacheKey> {
-    std::size_t operator()(const KPkPass::ImageCacheKey &key) const noexcept
-    {
-        return std::hash<QString>{}(key.name) ^ std::hash<unsigned int>{}(key.dpr);
-    }
-};
-
-namespace KPkPass
-{
 class PassPrivate
 {
 public:
     /** The pass data structure of the pass.json file. */
     [[nodiscard]] QJsonObject passData() const;
-    /** Localized message for the given key. */
+    /** The key of the pass data structure in the pass.json file. */
+    [[nodiscard]] QLatin1StringView passDataKey() const;
+    /** Checks whether @p key is the key of any of the pass data structures. */
+    [[nodiscard]] static bool isPassDataKey(QStringView key);
+    /** The Pass::Type corresponding to the pass data structure @p key, -1 if @p key isn't one. */
+    [[nodiscard]] static int passTypeIndex(QLatin1StringView key);
+    /** Localized message for the given key, in the currently selected language. */
     [[nodiscard]] QString message(const QString &key) const;
+    /** Localized message for the given key in @p language, independent of the selected language. Thread-safe. */
+    [[nodiscard]] QString message(const QString &key, const QString &language) const;
+    /** Looks up @p key in @p messages, @p key itself if it isn't found. */
+    [[nodiscard]] static QString lookupMessage(const QString &key, const QHash<QString, QString> *messages);
+
+    /** Determine the available translation catalogs. */
+    void indexCatalogs();
+    /** The parsed catalog for the lproj directory @p lang, parsed on first use. Thread-safe. */
+    [[nodiscard]] const QHash<QString, QString> *parsedCatalog(const QString &lang) const;
+    /** The translation catalog for @p lang, parsed on first use. @c nullptr if there is none.
+     *  @p catalogLanguage is set to the lproj name of the catalog that was found. Thread-safe.
+     */
+    [[nodiscard]] const QHash<QString, QString> *catalog(const QString &lang, QString *catalogLanguage = nullptr) const;
+    /** The translation catalog for the currently selected language. */
+    [[nodiscard]] const QHash<QString, QString> *activeCatalog() const;
+    [[nodiscard]] QHash<QString, QString> parseMessages(const QString &lang) const;
+
+    /** Resolved style properties, created on first use. */
+    [[nodiscard]] PassStyle style() const;
+
+    /** Typed semantic tags, created on first use and after language changes. */
+    [[nodiscard]] SemanticTags semantics(const Pass *q) const;
+
+    /** Parsed fields, barcodes, locations and seats, created on first use. */
+    [[nodiscard]] const PassElements &elements(const Pass *q) const;
 
-    void parse();
-    bool parseMessages(const QString &lang);
+    /** SHA-1 hashes of all assets, as listed in manifest.json or computed from the archive content if there is none. */
+    [[nodiscard]] QHash<QString, QString> assetHashes() const;
 
-    [[nodiscard]] QList<Field> fields(QLatin1StringView fieldType, const Pass *q, int row = -1) const;
+    static Pass *fromData(std::unique_ptr<QIODevice> device, const LoadOptions &options, LoadOptions::Error *loadError, QObject *parent);
+    /** Creates the Pass sub-class for @p type. */
+    static Pass *create(Pass::Type type, QObject *parent);
 
-    static Pass *fromData(std::unique_ptr<QIODevice> device, QObject *parent);
+    /** Serializes the parsed state for Pass::writeCache(). */
+    [[nodiscard]] bool writeCache(QIODevice *device) const;
+    /** Restores a pass from the cache content @p data, if that is valid for source file @p fileName. */
+    static Pass *fromCache(const QByteArray &data, const QString &fileName, const LoadOptions &options, QObject *parent);
 
-    std::unique_ptr<QIODevice> buffer;
-    std::unique_ptr<KZip> zip;
+    /** Shared with PassAssets handles, see there. */
+    std::shared_ptr<PassArchive> archive;
     QJsonObject passObj;
-    QHash<QString, QString> messages;
+    QStringList languages;
+    // the members below are guarded by archive->mutex
+    QString language;
+    // lproj name -> parsed catalog, lazily populated, never removed
+    mutable std::unordered_map<QString, QHash<QString, QString>> catalogs;
+    mutable const QHash<QString, QString> *currentCatalog = nullptr;
+    mutable int currentCatalogGeneration = -1;
     Pass::Type passType;
-    std::unordered_map<ImageCacheKey, QImage> m_images;
+    mutable std::optional<PassElements> m_elements;
+    mutable std::shared_ptr<const PassStylePrivate> m_style;
+    mutable std::optional<SemanticTags> m_semantics;
+    // the catalog m_semantics was localized with
+    mutable const QHash<QString, QString> *m_semanticsCatalog = nullptr;
 };
 }
@@ -0,0 +1,267 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passarchive_p.h"
+#include "logging.h"
+#include "trace_p.h"
+#include "zipdirectory_p.h"
+
+#include <QBuffer>
+#include <QDateTime>
+#include <QFile>
+#include <QImageReader>
+#include <QIODevice>
+#include <QMutexLocker>
+
+#include <algorithm>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+PassArchive::~PassArchive() = default;
+
+static bool exceedsLimit(qint64 size, qint64 limit)
+{
+    return limit > 0 && size > limit;
+}
+
+LoadOptions::Error PassArchive::open(std::unique_ptr<QIODevice> &&device)
+{
+    const auto maxEntries = options.maximumEntryCount();
+    // this allows to reject archives with too many entries before the reader processes all of them
+    const auto eocd = ZipDirectory::findEndOfCentralDirectory(device.get());
+    device->seek(0);
+    if (eocd && exceedsLimit(eocd->entryCount, maxEntries)) {
+        qCWarning(Log) << "ZIP file exceeds the maximum entry count";
+        return LoadOptions::ResourceLimitExceeded;
+    }
+
+    buffer = std::move(device);
+    reader = ArchiveReader::create(options.archiveBackend());
+    if (!reader->open(buffer.get())) {
+        if (options.archiveBackend() != LoadOptions::BuiltinBackend) {
+            reader.reset();
+            return LoadOptions::InvalidArchive;
+        }
+        // ZIP64 or damaged archives KArchive might still be able to handle
+        qCDebug(Log) << "Falling back to KArchive for reading the pass archive";
+        buffer->seek(0);
+        reader = ArchiveReader::create(LoadOptions::KArchiveBackend);
+        if (!reader->open(buffer.get())) {
+            reader.reset();
+            return LoadOptions::InvalidArchive;
+        }
+    }
+    const auto entryCount = reader->entryCount();
+    if (exceedsLimit(entryCount, maxEntries)) {
+        qCWarning(Log) << "ZIP file exceeds the maximum entry count";
+        reader.reset();
+        return LoadOptions::ResourceLimitExceeded;
+    }
+    entries = reader->topLevelEntries();
+    count(&LoadCounters::archiveSize, buffer->size());
+    count(&LoadCounters::entryCount, entryCount);
+    return LoadOptions::NoError;
+}
+
+bool PassArchive::ensureOpen()
+{
+    if (reader) {
+        return true;
+    }
+    if (fileName.isEmpty()) {
+        return false;
+    }
+    std::unique_ptr<QFile> file(new QFile(fileName));
+    if (!file->open(QFile::ReadOnly)) {
+        qCWarning(Log) << "Failed to open" << fileName << ":" << file->errorString();
+        return false;
+    }
+    // content restored from a cache must not be mixed with a different archive
+    if (expectedSize >= 0
+        && (file->size() != expectedSize || file->fileTime(QFileDevice::FileModificationTime).toMSecsSinceEpoch() != expectedLastModified)) {
+        qCWarning(Log) << fileName << "changed since the pass was loaded from the cache";
+        return false;
+    }
+    if (open(std::move(file)) != LoadOptions::NoError) {
+        reader.reset();
+        buffer.reset();
+        return false;
+    }
+    return true;
+}
+
+LoadOptions::Error PassArchive::readFile(const QString &path, QByteArray &data, qint64 limit)
+{
+    const auto index = reader->indexOf(path);
+    if (index < 0) {
+        data.clear();
+        return LoadOptions::InvalidArchive;
+    }
+    return readFile(index, data, limit);
+}
+
+LoadOptions::Error PassArchive::readFile(qsizetype index, QByteArray &data, qint64 limit)
+{
+    if (limit <= 0 || exceedsLimit(limit, options.maximumEntrySize())) {
+        limit = options.maximumEntrySize();
+    }
+    // entries read repeatedly (e.g. for hashing) only count once towards the total
+    const auto counted = inflatedEntries.contains(index);
+    auto maximumSize = limit > 0 ? limit : -1;
+    if (!counted && options.maximumTotalSize() > 0) {
+        const auto remaining = std::max<qint64>(options.maximumTotalSize() - inflatedSize, 0);
+        maximumSize = maximumSize < 0 ? remaining : std::min(maximumSize, remaining);
+    }
+
+    if (const auto res = reader->read(index, data, maximumSize); res != LoadOptions::NoError) {
+        if (res == LoadOptions::ResourceLimitExceeded) {
+            qCWarning(Log) << "Archive entry" << reader->files()[index].path << "exceeds resource limits";
+        }
+        return res;
+    }
+
+    if (!counted) {
+        inflatedSize += data.size();
+        inflatedEntries.insert(index);
+        count(&LoadCounters::inflatedSize, data.size());
+    }
+    return LoadOptions::NoError;
+}
+
+void PassArchive::count(qint64 LoadCounters::*counter, qint64 value)
+{
+    statistics.*counter += value;
+    if (statisticsCommitted) {
+        LoadStatisticsPrivate::countGlobal(counter, value);
+    }
+}
+
+void PassArchive::commitStatistics()
+{
+    LoadStatisticsPrivate::countGlobal(statistics);
+    statisticsCommitted = true;
+}
+
+static bool isImageVariant(const QString &entry, const QString &baseName)
+{
+    return entry.startsWith(baseName)
+        && (QStringView(entry).mid(baseName.size()).startsWith('@'_L1) || QStringView(entry).mid(baseName.size()).startsWith('.'_L1))
+        && entry.endsWith(".png"_L1);
+}
+
+bool PassArchive::hasImage(const QString &baseName)
+{
+    QMutexLocker locker(&mutex);
+    return std::any_of(entries.begin(), entries.end(), [&baseName](const auto &entry) {
+        return isImageVariant(entry, baseName);
+    });
+}
+
+QStringList PassArchive::imageBaseNames()
+{
+    QMutexLocker locker(&mutex);
+    QStringList names;
+    for (const auto &entry : entries) {
+        if (!entry.endsWith(".png"_L1)) {
+            continue;
+        }
+        // same base name rules as for isImageVariant(), ie. "logo.dark.png" is a variant of "logo"
+        const auto it = std::find_if(entry.begin(), entry.end(), [](QChar c) {
+            return c == '@'_L1 || c == '.'_L1;
+        });
+        auto name = entry.left(std::distance(entry.begin(), it));
+        if (!name.isEmpty() && !names.contains(name)) {
+            names.push_back(std::move(name));
+        }
+    }
+    return names;
+}
+
+std::optional<PassArchive::ImageVariant> PassArchive::selectImageVariant(const QStringList &archiveEntries, const QString &baseName, unsigned int devicePixelRatio)
+{
+    for (auto dpr = devicePixelRatio; dpr > 0; --dpr) {
+        auto name = dpr > 1 ? QString(baseName + '@'_L1 + QString::number(dpr) + "x.png"_L1) : QString(baseName + ".png"_L1);
+        if (archiveEntries.contains(name)) {
+            return ImageVariant{std::move(name), dpr};
+        }
+    }
+
+    // no hit, check if there is any variant at all (happens in passes only containing eg. a 3x variant)
+    // (matches what hasImage does)
+    const auto it = std::find_if(archiveEntries.begin(), archiveEntries.end(), [&baseName](const auto &entry) {
+        return isImageVariant(entry, baseName);
+    });
+    if (it == archiveEntries.end()) {
+        return {};
+    }
+    const auto suffix = QStringView(*it).mid(baseName.size());
+    const auto dpr = suffix.startsWith('@'_L1) ? suffix.mid(1, suffix.indexOf('x'_L1) - 1).toUInt() : 1u;
+    return ImageVariant{*it, std::max(dpr, 1u)};
+}
+
+QImage PassArchive::decodeImage(const QByteArray &data, const LoadOptions &options, const QSize &size)
+{
+    QBuffer imageData;
+    imageData.setData(data);
+    imageData.open(QIODevice::ReadOnly);
+    QImageReader reader(&imageData);
+    const auto imageSize = reader.size();
+    if (options.maximumImagePixels() > 0 && (!imageSize.isValid() || exceedsLimit((qint64)imageSize.width() * imageSize.height(), options.maximumImagePixels()))) {
+        qCWarning(Log) << "Image exceeds the maximum pixel count" << imageSize;
+        return {};
+    }
+    if (size.isValid() && imageSize.isValid() && (imageSize.width() > size.width() || imageSize.height() > size.height())) {
+        reader.setScaledSize(imageSize.scaled(size, Qt::KeepAspectRatio));
+    }
+    return reader.read();
+}
+
+QImage PassArchive::image(const QString &baseName, unsigned int devicePixelRatio)
+{
+    std::optional<ImageVariant> variant;
+    QByteArray data;
+    {
+        QMutexLocker locker(&mutex);
+        if (const auto it = images.find(ImageCacheKey{baseName, devicePixelRatio}); it != images.end()) {
+            KPKPASS_TRACE_INSTANT(ImageCacheHit, this, (*it).second.sizeInBytes());
+            count(&LoadCounters::imageCacheHitCount, 1);
+            return (*it).second;
+        }
+        variant = selectImageVariant(entries, baseName, devicePixelRatio);
+        if (!variant) {
+            return {};
+        }
+        if (const auto it = images.find(ImageCacheKey{baseName, variant->devicePixelRatio}); it != images.end()) {
+            KPKPASS_TRACE_INSTANT(ImageCacheHit, this, (*it).second.sizeInBytes());
+            count(&LoadCounters::imageCacheHitCount, 1);
+            images[ImageCacheKey{baseName, devicePixelRatio}] = (*it).second;
+            return (*it).second;
+        }
+        if (!ensureOpen()) {
+            return {};
+        }
+        if (readFile(variant->entryName, data) != LoadOptions::NoError) {
+            return {};
+        }
+    }
+
+    // decode without holding the lock, so other threads can access the archive meanwhile
+    QImage img;
+    {
+        KPKPASS_TRACE_SCOPE(decodeTrace, ImageDecode, this);
+        KPKPASS_TRACE_SIZE(decodeTrace, data.size());
+        img = decodeImage(data, options);
+    }
+    img.setDevicePixelRatio(variant->devicePixelRatio);
+
+    QMutexLocker locker(&mutex);
+    count(&LoadCounters::imageDecodeCount, 1);
+    images[ImageCacheKey{baseName, variant->devicePixelRatio}] = img;
+    if (variant->devicePixelRatio != devicePixelRatio) {
+        images[ImageCacheKey{baseName, devicePixelRatio}] = img;
+    }
+    return img;
+}
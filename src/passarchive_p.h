@@ -0,0 +1,123 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSARCHIVE_P_H
+#define KPKPASS_PASSARCHIVE_P_H
+
+#include "archivereader_p.h"
+#include "loadoptions.h"
+#include "loadstatistics_p.h"
+
+#include <QImage>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+class QIODevice;
+
+namespace KPkPass
+{
+struct ImageCacheKey {
+    QString name;
+    unsigned int dpr;
+    bool operator==(const ImageCacheKey &) const = default;
+};
+}
+
+template<>
+struct std::hash<KPkPass::ImageCacheKey> {
+    std::size_t operator()(const KPkPass::ImageCacheKey &key) const noexcept
+    {
+        return std::hash<QString>{}(key.name) ^ std::hash<unsigned int>{}(key.dpr);
+    }
+};
+
+namespace KPkPass
+{
+
+/** The archive of a pass and the image cache based on it.
+ *  This is shared between a pass and its PassAssets handles, which might be used
+ *  from other threads. All access to the archive needs to hold mutex therefore.
+ */
+class PassArchive
+{
+public:
+    ~PassArchive();
+
+    /** Opens the archive in @p device, checking the entry count limit. */
+    [[nodiscard]] LoadOptions::Error open(std::unique_ptr<QIODevice> &&device);
+    /** Opens the archive from fileName if that hasn't happened yet.
+     *  This is the case for passes restored from a cache. The caller needs to hold mutex.
+     */
+    [[nodiscard]] bool ensureOpen();
+    /** Decompresses the file at @p path into @p data, enforcing the configured size limits
+     *  and @p limit in addition to those. The caller needs to hold mutex.
+     */
+    [[nodiscard]] LoadOptions::Error readFile(const QString &path, QByteArray &data, qint64 limit = 0);
+    /** Same as the above, for file @p index of reader. */
+    [[nodiscard]] LoadOptions::Error readFile(qsizetype index, QByteArray &data, qint64 limit = 0);
+
+    /** Checks whether an image asset with @p baseName exists. */
+    [[nodiscard]] bool hasImage(const QString &baseName);
+    /** Base names of all image assets, without the high dpi and file type extensions. */
+    [[nodiscard]] QStringList imageBaseNames();
+    /** Returns the image asset @p baseName, cached after the first decoding. */
+    [[nodiscard]] QImage image(const QString &baseName, unsigned int devicePixelRatio);
+
+    struct ImageVariant {
+        QString entryName;
+        unsigned int devicePixelRatio;
+    };
+    /** Selects the archive entry to use for image @p baseName at @p devicePixelRatio
+     *  from the top-level archive entries @p archiveEntries. This is the matching used by Pass::image().
+     */
+    [[nodiscard]] static std::optional<ImageVariant> selectImageVariant(const QStringList &archiveEntries, const QString &baseName, unsigned int devicePixelRatio);
+    /** Decodes the image in @p data, enforcing the pixel limit of @p options.
+     *  If @p size is valid, the image is scaled down to fit into that during decoding.
+     */
+    [[nodiscard]] static QImage decodeImage(const QByteArray &data, const LoadOptions &options, const QSize &size = {});
+
+    /** Adds @p value to @p counter of the statistics of this pass,
+     *  and of the global ones once commitStatistics() has been called.
+     *  The caller needs to hold mutex, unless the archive isn't shared yet.
+     */
+    void count(qint64 LoadCounters::*counter, qint64 value);
+    /** Adds the statistics collected while loading to the global ones, to be called once loading succeeded. */
+    void commitStatistics();
+
+    QMutex mutex;
+    /** Source file, for opening the archive on demand. */
+    QString fileName;
+    /** Size and modification time (ms since epoch, UTC) fileName had when the pass was loaded
+     *  from it or restored from a cache. The archive is only opened on demand and cache files
+     *  are only written if it still matches those. Negative size if not loaded from a file.
+     */
+    qint64 expectedSize = -1;
+    qint64 expectedLastModified = 0;
+    /** Top-level archive entries, available even when the archive hasn't been opened. */
+    QStringList entries;
+    std::unique_ptr<QIODevice> buffer;
+    std::unique_ptr<ArchiveReader> reader;
+    std::unordered_map<ImageCacheKey, QImage> images;
+
+    LoadOptions options;
+    /** Decompressed size of all entries read so far, each counted only once. */
+    qint64 inflatedSize = 0;
+    std::unordered_set<qsizetype> inflatedEntries;
+
+    LoadCounters statistics;
+    bool statisticsCommitted = false;
+    /** The currently used translation catalog, for LoadStatistics. */
+    QString catalogLanguage;
+};
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passassets.h"
+#include "passarchive_p.h"
+
+#include <QImage>
+
+using namespace KPkPass;
+
+PassAssets::PassAssets() = default;
+PassAssets::PassAssets(const PassAssets &) = default;
+PassAssets::PassAssets(PassAssets &&) noexcept = default;
+PassAssets::~PassAssets() = default;
+PassAssets &PassAssets::operator=(const PassAssets &) = default;
+PassAssets &PassAssets::operator=(PassAssets &&) noexcept = default;
+
+PassAssets::PassAssets(const std::shared_ptr<PassArchive> &archive)
+    : d(archive)
+{
+}
+
+bool PassAssets::isValid() const
+{
+    return d != nullptr;
+}
+
+bool PassAssets::hasImage(const QString &baseName) const
+{
+    return d && d->hasImage(baseName);
+}
+
+QImage PassAssets::image(const QString &baseName, unsigned int devicePixelRatio) const
+{
+    return d ? d->image(baseName, devicePixelRatio) : QImage();
+}
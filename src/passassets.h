@@ -0,0 +1,61 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSASSETS_H
+#define KPKPASS_PASSASSETS_H
+
+#include "kpkpass_export.h"
+
+#include <QString>
+
+#include <memory>
+
+class QImage;
+
+namespace KPkPass
+{
+
+class PassArchive;
+
+/*!
+ * \brief Thread-safe access to the image assets of a pass.
+ *
+ * This shares the archive and the image cache with the pass it was
+ * obtained from, and remains valid after that pass has been deleted.
+ * It can be used from any thread, e.g. for decoding images off the GUI thread.
+ *
+ * \sa Pass::assets()
+ * \class KPkPass::PassAssets
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassAssets
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassAssets
+{
+public:
+    PassAssets();
+    PassAssets(const PassAssets &);
+    PassAssets(PassAssets &&) noexcept;
+    ~PassAssets();
+    PassAssets &operator=(const PassAssets &);
+    PassAssets &operator=(PassAssets &&) noexcept;
+
+    /*! Returns \c true if this refers to the assets of a pass. */
+    [[nodiscard]] bool isValid() const;
+
+    /*! Same as Pass::hasImage(). */
+    [[nodiscard]] bool hasImage(const QString &baseName) const;
+    /*! Same as Pass::image(). */
+    [[nodiscard]] QImage image(const QString &baseName, unsigned int devicePixelRatio = 1) const;
+
+private:
+    friend class Pass;
+    explicit PassAssets(const std::shared_ptr<PassArchive> &archive);
+    std::shared_ptr<PassArchive> d;
+};
+
+}
+
+#endif
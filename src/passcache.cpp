@@ -0,0 +1,196 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "logging.h"
+#include "pass.h"
+#include "pass_p.h"
+#include "trace_p.h"
+
+#include <QCborValue>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTimeZone>
+
+#include <vector>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+// Cache file layout, all in QDataStream encoding:
+// - magic, format version
+// - size and modification time of the source file, for invalidation
+// - pass type
+// - pass.json as CBOR, which is considerably faster to parse than JSON
+// - available languages and top-level archive entries
+// - all translation catalogs, keyed by language
+enum : quint32 {
+    CacheMagic = 0x4b505043, // "KPPC"
+    CacheVersion = 1,
+};
+static constexpr auto CacheStreamVersion = QDataStream::Qt_6_0;
+
+namespace
+{
+struct SourceInfo {
+    qint64 size = -1;
+    qint64 lastModified = 0;
+};
+}
+
+static SourceInfo sourceInfo(const QString &fileName)
+{
+    const QFileInfo fi(fileName);
+    if (!fi.exists()) {
+        return {};
+    }
+    return {fi.size(), fi.lastModified(QTimeZone::UTC).toMSecsSinceEpoch()};
+}
+
+bool PassPrivate::writeCache(QIODevice *device) const
+{
+    // stamp the cache with the file we actually loaded, not what might have replaced it since
+    const SourceInfo source{archive->expectedSize, archive->expectedLastModified};
+    if (source.size < 0) {
+        return false;
+    }
+    const auto current = sourceInfo(archive->fileName);
+    if (current.size != source.size || current.lastModified != source.lastModified) {
+        qCWarning(Log) << archive->fileName << "changed since the pass was loaded, not writing cache";
+        return false;
+    }
+
+    // make sure all catalogs are parsed, so loading from the cache never needs the archive for them
+    std::vector<const QHash<QString, QString> *> messages;
+    messages.reserve(languages.size());
+    for (const auto &lang : languages) {
+        messages.push_back(parsedCatalog(lang));
+    }
+
+    QDataStream stream(device);
+    stream.setVersion(CacheStreamVersion);
+    stream << quint32(CacheMagic) << quint32(CacheVersion);
+    stream << source.size << source.lastModified;
+    stream << qint32(passType);
+    stream << QCborValue::fromJsonValue(passObj).toCbor();
+    stream << languages << archive->entries;
+    stream << quint32(languages.size());
+    for (qsizetype i = 0; i < languages.size(); ++i) {
+        stream << languages[i] << *messages[i];
+    }
+    return stream.status() == QDataStream::Ok;
+}
+
+Pass *PassPrivate::fromCache(const QByteArray &data, const QString &fileName, const LoadOptions &options, QObject *parent)
+{
+    auto archive = std::make_shared<PassArchive>();
+    KPKPASS_TRACE_SCOPE(cacheTrace, CacheLoad, archive.get());
+    KPKPASS_TRACE_SIZE(cacheTrace, data.size());
+
+    QDataStream stream(data);
+    stream.setVersion(CacheStreamVersion);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion) {
+        return nullptr;
+    }
+
+    SourceInfo cached;
+    stream >> cached.size >> cached.lastModified;
+    const auto source = sourceInfo(fileName);
+    if (source.size != cached.size || source.lastModified != cached.lastModified) {
+        return nullptr;
+    }
+
+    qint32 passType = -1;
+    QByteArray passJson;
+    QStringList languages;
+    QStringList entries;
+    quint32 catalogCount = 0;
+    stream >> passType >> passJson >> languages >> entries >> catalogCount;
+    if (stream.status() != QDataStream::Ok || passType < Pass::BoardingPass || passType > Pass::StoreCard
+        || catalogCount != static_cast<quint32>(languages.size())) {
+        return nullptr;
+    }
+    std::unordered_map<QString, QHash<QString, QString>> catalogs;
+    for (quint32 i = 0; i < catalogCount; ++i) {
+        QString lang;
+        QHash<QString, QString> catalog;
+        stream >> lang >> catalog;
+        catalogs.emplace(std::move(lang), std::move(catalog));
+    }
+    const auto passObj = QCborValue::fromCbor(passJson).toJsonValue().toObject();
+    if (stream.status() != QDataStream::Ok || passObj.isEmpty()) {
+        return nullptr;
+    }
+
+    archive->options = options;
+    archive->fileName = fileName;
+    archive->expectedSize = source.size;
+    archive->expectedLastModified = source.lastModified;
+    archive->entries = std::move(entries);
+    archive->count(&LoadCounters::passCount, 1);
+    archive->count(&LoadCounters::cachedPassCount, 1);
+    archive->commitStatistics();
+
+    auto pass = create(static_cast<Pass::Type>(passType), parent);
+    pass->d->archive = std::move(archive);
+    pass->d->passObj = passObj;
+    pass->d->languages = std::move(languages);
+    pass->d->catalogs = std::move(catalogs);
+    return pass;
+}
+
+Pass *Pass::fromFileCached(const QString &fileName, const QString &cacheFileName, QObject *parent)
+{
+    return fromFileCached(fileName, cacheFileName, LoadOptions(), nullptr, parent);
+}
+
+Pass *Pass::fromFileCached(const QString &fileName, const QString &cacheFileName, const LoadOptions &options, LoadOptions::Error *error, QObject *parent)
+{
+    QFile cacheFile(cacheFileName);
+    if (cacheFile.open(QFile::ReadOnly)) {
+        // map the cache file rather than reading it, everything we need is copied out of it while deserializing
+        const auto size = cacheFile.size();
+        if (const auto mapped = size > 0 ? cacheFile.map(0, size) : nullptr) {
+            auto pass = PassPrivate::fromCache(QByteArray::fromRawData(reinterpret_cast<const char *>(mapped), size), fileName, options, parent);
+            cacheFile.unmap(mapped);
+            if (pass) {
+                if (error) {
+                    *error = LoadOptions::NoError;
+                }
+                return pass;
+            }
+        }
+        cacheFile.close();
+        qCDebug(Log) << "Discarding outdated or invalid pass cache" << cacheFileName;
+    }
+
+    auto pass = fromFile(fileName, options, error, parent);
+    if (pass) {
+        (void)pass->writeCache(cacheFileName);
+    }
+    return pass;
+}
+
+bool Pass::writeCache(const QString &cacheFileName) const
+{
+    if (d->archive->fileName.isEmpty()) {
+        return false;
+    }
+    QSaveFile file(cacheFileName);
+    if (!file.open(QFile::WriteOnly)) {
+        qCWarning(Log) << "Failed to open pass cache" << cacheFileName << file.errorString();
+        return false;
+    }
+    if (!d->writeCache(&file)) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
@@ -0,0 +1,227 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passcollection.h"
+#include "locationindex.h"
+#include "pass.h"
+#include "stringpool_p.h"
+
+#include <QDateTime>
+
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace KPkPass;
+
+namespace
+{
+struct PassKey {
+    QString passTypeIdentifier;
+    QString serialNumber;
+    bool operator==(const PassKey &) const = default;
+};
+
+struct PassKeyHash {
+    std::size_t operator()(const PassKey &key) const noexcept
+    {
+        return qHashMulti(0, key.passTypeIdentifier, key.serialNumber);
+    }
+};
+
+using DateIndex = std::multimap<QDateTime, Pass *>;
+
+struct Entry {
+    std::unique_ptr<Pass> pass;
+    QString groupingIdentifier;
+    std::optional<DateIndex::iterator> relevantDateIt;
+    std::optional<DateIndex::iterator> expirationDateIt;
+};
+}
+
+namespace KPkPass
+{
+class PassCollectionPrivate
+{
+public:
+    void addToIndexes(Entry &entry);
+    void removeFromIndexes(Entry &entry);
+    [[nodiscard]] static QList<Pass *> range(const DateIndex &index, const QDateTime &begin, const QDateTime &end);
+
+    std::unordered_map<PassKey, Entry, PassKeyHash> m_passes;
+    std::unordered_map<QString, std::unordered_set<Pass *>> m_groups;
+    DateIndex m_relevantDates;
+    DateIndex m_expirationDates;
+    LocationIndex m_locations;
+};
+}
+
+void PassCollectionPrivate::addToIndexes(Entry &entry)
+{
+    auto pass = entry.pass.get();
+    entry.groupingIdentifier = StringPool::intern(pass->groupingIdentifier());
+    if (!entry.groupingIdentifier.isEmpty()) {
+        m_groups[entry.groupingIdentifier].insert(pass);
+    }
+
+    // dates are parsed once here, so removal doesn't need to do that again
+    if (const auto dt = pass->relevantDate(); dt.isValid()) {
+        entry.relevantDateIt = m_relevantDates.emplace(dt, pass);
+    }
+    if (const auto dt = pass->expirationDate(); dt.isValid()) {
+        entry.expirationDateIt = m_expirationDates.emplace(dt, pass);
+    }
+    m_locations.insert(pass);
+}
+
+void PassCollectionPrivate::removeFromIndexes(Entry &entry)
+{
+    if (!entry.groupingIdentifier.isEmpty()) {
+        const auto it = m_groups.find(entry.groupingIdentifier);
+        if (it != m_groups.end()) {
+            (*it).second.erase(entry.pass.get());
+            if ((*it).second.empty()) {
+                m_groups.erase(it);
+            }
+        }
+    }
+    if (entry.relevantDateIt) {
+        m_relevantDates.erase(*entry.relevantDateIt);
+        entry.relevantDateIt.reset();
+    }
+    if (entry.expirationDateIt) {
+        m_expirationDates.erase(*entry.expirationDateIt);
+        entry.expirationDateIt.reset();
+    }
+    m_locations.remove(entry.pass.get());
+}
+
+QList<Pass *> PassCollectionPrivate::range(const DateIndex &index, const QDateTime &begin, const QDateTime &end)
+{
+    if (begin.isValid() && end.isValid() && end <= begin) {
+        return {};
+    }
+
+    const auto beginIt = begin.isValid() ? index.lower_bound(begin) : index.begin();
+    const auto endIt = end.isValid() ? index.lower_bound(end) : index.end();
+
+    QList<Pass *> result;
+    std::transform(beginIt, endIt, std::back_inserter(result), [](const auto &entry) {
+        return entry.second;
+    });
+    return result;
+}
+
+PassCollection::PassCollection()
+    : d(std::make_unique<PassCollectionPrivate>())
+{
+}
+
+PassCollection::PassCollection(PassCollection &&) noexcept = default;
+PassCollection::~PassCollection() = default;
+PassCollection &PassCollection::operator=(PassCollection &&) noexcept = default;
+
+qsizetype PassCollection::size() const
+{
+    return static_cast<qsizetype>(d->m_passes.size());
+}
+
+bool PassCollection::isEmpty() const
+{
+    return d->m_passes.empty();
+}
+
+bool PassCollection::insert(std::unique_ptr<Pass> &&pass)
+{
+    if (!pass) {
+        return false;
+    }
+
+    PassKey key{StringPool::intern(pass->passTypeIdentifier()), pass->serialNumber()};
+    auto it = d->m_passes.find(key);
+    const auto replaced = it != d->m_passes.end();
+    if (replaced) {
+        d->removeFromIndexes((*it).second);
+        (*it).second.pass = std::move(pass);
+    } else {
+        it = d->m_passes.emplace(std::move(key), Entry{std::move(pass), {}, {}, {}}).first;
+    }
+    d->addToIndexes((*it).second);
+    return replaced;
+}
+
+bool PassCollection::remove(const QString &passTypeIdentifier, const QString &serialNumber)
+{
+    return take(passTypeIdentifier, serialNumber) != nullptr;
+}
+
+std::unique_ptr<Pass> PassCollection::take(const QString &passTypeIdentifier, const QString &serialNumber)
+{
+    const auto it = d->m_passes.find(PassKey{passTypeIdentifier, serialNumber});
+    if (it == d->m_passes.end()) {
+        return {};
+    }
+
+    d->removeFromIndexes((*it).second);
+    auto pass = std::move((*it).second.pass);
+    d->m_passes.erase(it);
+    return pass;
+}
+
+void PassCollection::clear()
+{
+    d->m_groups.clear();
+    d->m_relevantDates.clear();
+    d->m_expirationDates.clear();
+    d->m_locations.clear();
+    d->m_passes.clear();
+}
+
+Pass *PassCollection::pass(const QString &passTypeIdentifier, const QString &serialNumber) const
+{
+    const auto it = d->m_passes.find(PassKey{passTypeIdentifier, serialNumber});
+    return it != d->m_passes.end() ? (*it).second.pass.get() : nullptr;
+}
+
+bool PassCollection::contains(const QString &passTypeIdentifier, const QString &serialNumber) const
+{
+    return d->m_passes.find(PassKey{passTypeIdentifier, serialNumber}) != d->m_passes.end();
+}
+
+QList<Pass *> PassCollection::passes() const
+{
+    QList<Pass *> result;
+    result.reserve(size());
+    for (const auto &[key, entry] : d->m_passes) {
+        result.push_back(entry.pass.get());
+    }
+    return result;
+}
+
+QList<Pass *> PassCollection::passesInGroup(const QString &groupingIdentifier) const
+{
+    const auto it = d->m_groups.find(groupingIdentifier);
+    if (it == d->m_groups.end()) {
+        return {};
+    }
+    return QList<Pass *>((*it).second.begin(), (*it).second.end());
+}
+
+QList<Pass *> PassCollection::passesByRelevantDate(const QDateTime &begin, const QDateTime &end) const
+{
+    return PassCollectionPrivate::range(d->m_relevantDates, begin, end);
+}
+
+QList<Pass *> PassCollection::passesByExpirationDate(const QDateTime &begin, const QDateTime &end) const
+{
+    return PassCollectionPrivate::range(d->m_expirationDates, begin, end);
+}
+
+QList<Pass *> PassCollection::passesNear(double latitude, double longitude) const
+{
+    return d->m_locations.passesNear(latitude, longitude);
+}
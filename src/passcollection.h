@@ -0,0 +1,101 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSCOLLECTION_H
+#define KPKPASS_PASSCOLLECTION_H
+
+#include "kpkpass_export.h"
+
+#include <QList>
+
+#include <memory>
+
+class QDateTime;
+class QString;
+
+namespace KPkPass
+{
+
+class Pass;
+class PassCollectionPrivate;
+
+/*!
+ * \brief A set of passes, indexed for fast lookup.
+ *
+ * Passes are identified by their pass type identifier and serial number,
+ * adding a pass with the same identity as an already contained one replaces
+ * the existing pass.
+ *
+ * Lookups by identity and grouping identifier are done in constant time,
+ * range queries on the relevant and expiration dates in logarithmic time,
+ * as are insertions and removals. Relevant locations are kept in a
+ * LocationIndex.
+ *
+ * \class KPkPass::PassCollection
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassCollection
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassCollection
+{
+public:
+    PassCollection();
+    PassCollection(PassCollection &&) noexcept;
+    ~PassCollection();
+    PassCollection &operator=(PassCollection &&) noexcept;
+
+    /*! Number of passes in this collection. */
+    [[nodiscard]] qsizetype size() const;
+    [[nodiscard]] bool isEmpty() const;
+
+    /*! Adds \a pass to this collection, taking ownership of it.
+     *  An existing pass with the same pass type identifier and serial number
+     *  is replaced and deleted.
+     *  Returns \c true if an existing pass was replaced.
+     */
+    bool insert(std::unique_ptr<Pass> &&pass);
+    /*! Removes and deletes the pass identified by \a passTypeIdentifier and \a serialNumber.
+     *  Returns \c false if no such pass is in this collection.
+     */
+    bool remove(const QString &passTypeIdentifier, const QString &serialNumber);
+    /*! Removes the pass identified by \a passTypeIdentifier and \a serialNumber
+     *  from this collection, and transfers ownership of it to the caller.
+     */
+    [[nodiscard]] std::unique_ptr<Pass> take(const QString &passTypeIdentifier, const QString &serialNumber);
+    /*! Removes and deletes all passes. */
+    void clear();
+
+    /*! Returns the pass identified by \a passTypeIdentifier and \a serialNumber, if present. */
+    [[nodiscard]] Pass *pass(const QString &passTypeIdentifier, const QString &serialNumber) const;
+    [[nodiscard]] bool contains(const QString &passTypeIdentifier, const QString &serialNumber) const;
+
+    /*! All passes in this collection, in no particular order. */
+    [[nodiscard]] QList<Pass *> passes() const;
+    /*! All passes with the grouping identifier \a groupingIdentifier. */
+    [[nodiscard]] QList<Pass *> passesInGroup(const QString &groupingIdentifier) const;
+
+    /*! Passes with a relevant date in the range [\a begin, \a end), sorted by relevant date.
+     *  An invalid \a begin or \a end leaves the corresponding side of the range open.
+     *  Passes without a relevant date are not included.
+     */
+    [[nodiscard]] QList<Pass *> passesByRelevantDate(const QDateTime &begin, const QDateTime &end) const;
+    /*! Passes with an expiration date in the range [\a begin, \a end), sorted by expiration date.
+     *  An invalid \a begin or \a end leaves the corresponding side of the range open.
+     *  Passes without an expiration date are not included.
+     */
+    [[nodiscard]] QList<Pass *> passesByExpirationDate(const QDateTime &begin, const QDateTime &end) const;
+
+    /*! Passes relevant at the position given by \a latitude and \a longitude.
+     *  \sa LocationIndex::passesNear()
+     */
+    [[nodiscard]] QList<Pass *> passesNear(double latitude, double longitude) const;
+
+private:
+    std::unique_ptr<PassCollectionPrivate> d;
+};
+
+}
+
+#endif
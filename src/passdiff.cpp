@@ -0,0 +1,208 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passdiff.h"
+#include "pass.h"
+#include "pass_p.h"
+
+#include <QJsonObject>
+
+#include <vector>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+namespace KPkPass
+{
+class PassDiffPrivate
+{
+public:
+    void compareFields(const Pass *oldPass, const Pass *newPass);
+    void compareKeys(const Pass *oldPass, const Pass *newPass);
+    void compareAssets(const Pass *oldPass, const Pass *newPass);
+
+    QList<Field> m_addedFields;
+    QList<Field> m_removedFields;
+    QList<Field> m_changedFields;
+    QStringList m_changedKeys;
+    QStringList m_changedAssets;
+    bool m_barcodesChanged = false;
+};
+}
+
+static bool isFieldKey(QStringView key)
+{
+    return key == "auxiliaryFields"_L1 || key == "backFields"_L1 || key == "headerFields"_L1 || key == "primaryFields"_L1 || key == "secondaryFields"_L1;
+}
+
+static bool isBarcodeKey(QStringView key)
+{
+    return key == "barcode"_L1 || key == "barcodes"_L1;
+}
+
+// keys present in only one of the objects or with different values, in both cases reported with prefix
+static void diffObjects(const QJsonObject &oldObj, const QJsonObject &newObj, const QString &prefix, QStringList &changed, bool (*ignore)(QStringView))
+{
+    for (auto it = oldObj.begin(); it != oldObj.end(); ++it) {
+        if (ignore(it.key())) {
+            continue;
+        }
+        const auto newIt = newObj.constFind(it.key());
+        if (newIt == newObj.constEnd() || newIt.value() != it.value()) {
+            changed.push_back(prefix + it.key());
+        }
+    }
+    for (auto it = newObj.begin(); it != newObj.end(); ++it) {
+        if (!ignore(it.key()) && !oldObj.contains(it.key())) {
+            changed.push_back(prefix + it.key());
+        }
+    }
+}
+
+void PassDiffPrivate::compareFields(const Pass *oldPass, const Pass *newPass)
+{
+    const auto oldFields = oldPass->fields();
+    QHash<QString, qsizetype> oldIndex;
+    oldIndex.reserve(oldFields.size());
+    for (qsizetype i = 0; i < oldFields.size(); ++i) {
+        oldIndex.insert(oldFields[i].key(), i);
+    }
+
+    std::vector<bool> matched(oldFields.size(), false);
+    const auto newFields = newPass->fields();
+    for (const auto &newField : newFields) {
+        const auto it = oldIndex.constFind(newField.key());
+        if (it == oldIndex.constEnd()) {
+            m_addedFields.push_back(newField);
+            continue;
+        }
+        matched[it.value()] = true;
+        const auto &oldField = oldFields[it.value()];
+        if (oldField.value() != newField.value() || oldField.label() != newField.label()) {
+            m_changedFields.push_back(newField);
+        }
+    }
+
+    for (qsizetype i = 0; i < oldFields.size(); ++i) {
+        if (!matched[i]) {
+            m_removedFields.push_back(oldFields[i]);
+        }
+    }
+}
+
+void PassDiffPrivate::compareKeys(const Pass *oldPass, const Pass *newPass)
+{
+    const auto &oldObj = oldPass->d->passObj;
+    const auto &newObj = newPass->d->passObj;
+
+    const auto oldDataKey = oldPass->d->passDataKey();
+    const auto newDataKey = newPass->d->passDataKey();
+    const auto isPassDataOrBarcodeKey = [](QStringView key) {
+        return isBarcodeKey(key) || PassPrivate::isPassDataKey(key);
+    };
+    diffObjects(oldObj, newObj, QString(), m_changedKeys, isPassDataOrBarcodeKey);
+
+    if (oldDataKey != newDataKey) {
+        m_changedKeys.push_back(QString(oldDataKey));
+        m_changedKeys.push_back(QString(newDataKey));
+    } else {
+        diffObjects(oldPass->d->passData(), newPass->d->passData(), QString(oldDataKey) + u'.', m_changedKeys, isFieldKey);
+    }
+
+    m_barcodesChanged = oldObj.value("barcodes"_L1) != newObj.value("barcodes"_L1) || oldObj.value("barcode"_L1) != newObj.value("barcode"_L1);
+}
+
+void PassDiffPrivate::compareAssets(const Pass *oldPass, const Pass *newPass)
+{
+    auto oldHashes = oldPass->d->assetHashes();
+    const auto newHashes = newPass->d->assetHashes();
+    oldHashes.remove(u"pass.json"_s);
+    for (auto it = newHashes.begin(); it != newHashes.end(); ++it) {
+        if (it.key() == "pass.json"_L1) {
+            continue;
+        }
+        const auto oldIt = oldHashes.constFind(it.key());
+        if (oldIt == oldHashes.constEnd() || oldIt.value() != it.value()) {
+            m_changedAssets.push_back(it.key());
+        }
+        if (oldIt != oldHashes.constEnd()) {
+            oldHashes.erase(oldIt);
+        }
+    }
+    for (auto it = oldHashes.begin(); it != oldHashes.end(); ++it) {
+        m_changedAssets.push_back(it.key());
+    }
+    m_changedAssets.sort();
+}
+
+PassDiff::PassDiff()
+    : d(std::make_unique<PassDiffPrivate>())
+{
+}
+
+PassDiff::PassDiff(const PassDiff &other)
+    : d(std::make_unique<PassDiffPrivate>(*other.d))
+{
+}
+
+PassDiff::PassDiff(PassDiff &&) noexcept = default;
+PassDiff::~PassDiff() = default;
+
+PassDiff &PassDiff::operator=(const PassDiff &other)
+{
+    *d = *other.d;
+    return *this;
+}
+
+PassDiff &PassDiff::operator=(PassDiff &&) noexcept = default;
+
+PassDiff PassDiff::compare(const Pass *oldPass, const Pass *newPass)
+{
+    PassDiff diff;
+    if (!oldPass || !newPass) {
+        return diff;
+    }
+
+    diff.d->compareFields(oldPass, newPass);
+    diff.d->compareKeys(oldPass, newPass);
+    diff.d->compareAssets(oldPass, newPass);
+    return diff;
+}
+
+bool PassDiff::isEmpty() const
+{
+    return d->m_addedFields.isEmpty() && d->m_removedFields.isEmpty() && d->m_changedFields.isEmpty() && d->m_changedKeys.isEmpty() && !d->m_barcodesChanged
+        && d->m_changedAssets.isEmpty();
+}
+
+QList<Field> PassDiff::addedFields() const
+{
+    return d->m_addedFields;
+}
+
+QList<Field> PassDiff::removedFields() const
+{
+    return d->m_removedFields;
+}
+
+QList<Field> PassDiff::changedFields() const
+{
+    return d->m_changedFields;
+}
+
+QStringList PassDiff::changedKeys() const
+{
+    return d->m_changedKeys;
+}
+
+bool PassDiff::barcodesChanged() const
+{
+    return d->m_barcodesChanged;
+}
+
+QStringList PassDiff::changedAssets() const
+{
+    return d->m_changedAssets;
+}
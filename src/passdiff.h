@@ -0,0 +1,80 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSDIFF_H
+#define KPKPASS_PASSDIFF_H
+
+#include "field.h"
+#include "kpkpass_export.h"
+
+#include <QList>
+#include <QStringList>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class Pass;
+class PassDiffPrivate;
+
+/*!
+ * \brief Structural difference between two versions of a pass.
+ *
+ * Fields are matched by their key, and compared by their resolved
+ * (ie. localized) value and label. This allows to e.g. only show
+ * the Field::changeMessage() of fields that actually changed when
+ * a pass update is received.
+ *
+ * \class KPkPass::PassDiff
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassDiff
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassDiff
+{
+public:
+    PassDiff();
+    PassDiff(const PassDiff &);
+    PassDiff(PassDiff &&) noexcept;
+    ~PassDiff();
+    PassDiff &operator=(const PassDiff &);
+    PassDiff &operator=(PassDiff &&) noexcept;
+
+    /*! Computes the difference between \a oldPass and \a newPass. */
+    [[nodiscard]] static PassDiff compare(const Pass *oldPass, const Pass *newPass);
+
+    /*! Returns \c true if no differences were found. */
+    [[nodiscard]] bool isEmpty() const;
+
+    /*! Fields only present in the new pass. */
+    [[nodiscard]] QList<Field> addedFields() const;
+    /*! Fields only present in the old pass. */
+    [[nodiscard]] QList<Field> removedFields() const;
+    /*! Fields present in both passes, with a different value or label.
+     *  The returned fields are those of the new pass.
+     */
+    [[nodiscard]] QList<Field> changedFields() const;
+
+    /*! Top-level pass.json keys that were added, removed or changed.
+     *  Fields and barcodes are not included here, other keys of the pass
+     *  data structure are reported as e.g. \c boardingPass.transitType.
+     */
+    [[nodiscard]] QStringList changedKeys() const;
+    /*! Returns \c true if the barcodes changed. */
+    [[nodiscard]] bool barcodesChanged() const;
+    /*! Names of archive entries (such as images or translation catalogs)
+     *  that were added, removed or whose content changed, based on the
+     *  hashes in the pass manifest.
+     */
+    [[nodiscard]] QStringList changedAssets() const;
+
+private:
+    std::unique_ptr<PassDiffPrivate> d;
+};
+
+}
+
+#endif
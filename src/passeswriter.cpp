@@ -0,0 +1,185 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passeswriter.h"
+#include "logging.h"
+#include "passwriter.h"
+
+#include <KZip>
+
+#include <QBuffer>
+#include <QJsonObject>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+namespace
+{
+struct MemberResult {
+    QByteArray data;
+    QString error;
+};
+
+struct Member {
+    QString name;
+    std::future<MemberResult> result;
+};
+}
+
+namespace KPkPass
+{
+class PassesWriterPrivate
+{
+public:
+    explicit PassesWriterPrivate(QIODevice *device);
+    void waitForMembers();
+    bool fail(const QString &error);
+
+    KZip m_zip;
+    QThreadPool *m_threadPool = nullptr;
+    std::vector<Member> m_members;
+    QString m_error;
+    bool m_finished = false;
+};
+}
+
+PassesWriterPrivate::PassesWriterPrivate(QIODevice *device)
+    : m_zip(device)
+    , m_threadPool(QThreadPool::globalInstance())
+{
+}
+
+void PassesWriterPrivate::waitForMembers()
+{
+    for (const auto &member : m_members) {
+        if (member.result.valid()) {
+            member.result.wait();
+        }
+    }
+}
+
+bool PassesWriterPrivate::fail(const QString &error)
+{
+    qCWarning(Log) << error;
+    m_error = error;
+    return false;
+}
+
+static MemberResult buildPass(const QJsonObject &passJson, const QHash<QString, QByteArray> &files)
+{
+    MemberResult result;
+    QBuffer buffer(&result.data);
+    buffer.open(QIODevice::WriteOnly);
+    PassWriter writer(&buffer);
+    bool success = writer.writePassJson(passJson);
+    for (auto it = files.begin(); success && it != files.end(); ++it) {
+        success = writer.writeFile(it.key(), it.value());
+    }
+    if (!success || !writer.finish()) {
+        result.data.clear();
+        result.error = writer.errorString();
+    }
+    return result;
+}
+
+PassesWriter::PassesWriter(QIODevice *device)
+    : d(std::make_unique<PassesWriterPrivate>(device))
+{
+}
+
+PassesWriter::~PassesWriter()
+{
+    // tasks still running on the thread pool only reference their own data, but we
+    // must not return before they are done as the caller might unload us
+    d->waitForMembers();
+}
+
+void PassesWriter::setThreadPool(QThreadPool *threadPool)
+{
+    d->m_threadPool = threadPool;
+}
+
+bool PassesWriter::addPass(const QString &name, const QJsonObject &passJson, const QHash<QString, QByteArray> &files)
+{
+    if (d->m_finished || std::any_of(d->m_members.begin(), d->m_members.end(), [&name](const auto &m) {
+            return m.name == name;
+        })) {
+        return d->fail(u"Invalid or duplicate member name: %1"_s.arg(name));
+    }
+
+    if (!d->m_threadPool) {
+        std::promise<MemberResult> promise;
+        promise.set_value(buildPass(passJson, files));
+        d->m_members.push_back({name, promise.get_future()});
+        return true;
+    }
+
+    auto task = std::make_shared<std::packaged_task<MemberResult()>>([passJson, files]() {
+        return buildPass(passJson, files);
+    });
+    d->m_members.push_back({name, task->get_future()});
+    d->m_threadPool->start([task]() {
+        (*task)();
+    });
+    return true;
+}
+
+bool PassesWriter::addPassData(const QString &name, const QByteArray &pkpassData)
+{
+    if (d->m_finished || std::any_of(d->m_members.begin(), d->m_members.end(), [&name](const auto &m) {
+            return m.name == name;
+        })) {
+        return d->fail(u"Invalid or duplicate member name: %1"_s.arg(name));
+    }
+
+    std::promise<MemberResult> promise;
+    promise.set_value(MemberResult{pkpassData, {}});
+    d->m_members.push_back({name, promise.get_future()});
+    return true;
+}
+
+bool PassesWriter::finish()
+{
+    if (d->m_finished) {
+        return d->fail(u"Bundle has already been finished."_s);
+    }
+    d->m_finished = true;
+
+    if (!d->m_zip.open(QIODevice::WriteOnly)) {
+        d->waitForMembers();
+        return d->fail(d->m_zip.errorString());
+    }
+    // members are ZIP files already, compressing them again gains nothing
+    d->m_zip.setCompression(KZip::NoCompression);
+
+    bool success = true;
+    for (auto &member : d->m_members) {
+        // write in insertion order, the futures of members that are done already return immediately
+        const auto result = member.result.get();
+        if (!result.error.isEmpty()) {
+            success = d->fail(u"Failed to build %1: %2"_s.arg(member.name, result.error));
+            continue;
+        }
+        if (success && !d->m_zip.writeFile(member.name, result.data)) {
+            success = d->fail(d->m_zip.errorString());
+        }
+    }
+    d->m_members.clear();
+
+    if (!d->m_zip.close()) {
+        return d->fail(d->m_zip.errorString());
+    }
+    return success;
+}
+
+QString PassesWriter::errorString() const
+{
+    return d->m_error;
+}
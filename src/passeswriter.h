@@ -0,0 +1,83 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSESWRITER_H
+#define KPKPASS_PASSESWRITER_H
+
+#include "kpkpass_export.h"
+
+#include <QHash>
+#include <QString>
+
+#include <memory>
+
+class QIODevice;
+class QJsonObject;
+class QThreadPool;
+
+namespace KPkPass
+{
+
+class PassesWriterPrivate;
+
+/*!
+ * \brief Writes .pkpasses multi-pass bundles.
+ *
+ * Member passes are built and compressed concurrently on a thread pool as
+ * soon as they are added. finish() then assembles the bundle with the
+ * members in the order they were added, independent of the order in which
+ * their compression completed.
+ *
+ * Member passes are stored uncompressed in the bundle, as they are ZIP
+ * archives themselves already.
+ *
+ * \sa Passes, PassWriter
+ * \class KPkPass::PassesWriter
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassesWriter
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassesWriter
+{
+public:
+    /*! Creates a writer for \a device.
+     *  \a device is opened for writing if it isn't open already. It is not owned by the writer.
+     */
+    explicit PassesWriter(QIODevice *device);
+    /*! Waits for pending member passes, but doesn't finalize the bundle. */
+    ~PassesWriter();
+
+    /*! Sets the thread pool member passes are built on.
+     *  Default is the global thread pool. When set to \c nullptr, member
+     *  passes are built synchronously in addPass().
+     *  This needs to be set before adding passes.
+     */
+    void setThreadPool(QThreadPool *threadPool);
+
+    /*! Adds a member pass \a name consisting of \a passJson and the additional archive
+     *  entries \a files (such as images or translation catalogs).
+     *  Returns \c false if \a name is already used.
+     */
+    bool addPass(const QString &name, const QJsonObject &passJson, const QHash<QString, QByteArray> &files = {});
+    /*! Adds the already complete .pkpass archive \a pkpassData as member \a name.
+     *  The data is written to the bundle as-is.
+     */
+    bool addPassData(const QString &name, const QByteArray &pkpassData);
+
+    /*! Waits for all member passes to be built and writes the bundle.
+     *  Returns \c false if any of the member passes could not be built.
+     */
+    bool finish();
+
+    /*! Human readable description of the last error. */
+    [[nodiscard]] QString errorString() const;
+
+private:
+    std::unique_ptr<PassesWriterPrivate> d;
+};
+
+}
+
+#endif
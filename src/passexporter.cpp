@@ -0,0 +1,523 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passexporter.h"
+#include "barcode.h"
+#include "field.h"
+#include "loadoptions.h"
+#include "location.h"
+#include "logging.h"
+#include "pass.h"
+
+#include <QCborStreamWriter>
+#include <QDateTime>
+#include <QIODevice>
+#include <QLocale>
+#include <QMetaEnum>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <future>
+#include <vector>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+namespace
+{
+/** Minimal streaming JSON writer, producing a single line of compact JSON. */
+class JsonRecordWriter
+{
+public:
+    explicit JsonRecordWriter(QByteArray &out)
+        : m_out(out)
+    {
+    }
+
+    void startMap()
+    {
+        separator();
+        m_out += '{';
+        m_first.push_back(true);
+    }
+    void endMap()
+    {
+        m_out += '}';
+        m_first.pop_back();
+    }
+    void startArray()
+    {
+        separator();
+        m_out += '[';
+        m_first.push_back(true);
+    }
+    void endArray()
+    {
+        m_out += ']';
+        m_first.pop_back();
+    }
+    void key(QLatin1StringView key)
+    {
+        separator();
+        m_out += '"';
+        m_out.append(key.data(), key.size());
+        m_out += "\":";
+        m_afterKey = true;
+    }
+    void value(QStringView value)
+    {
+        separator();
+        writeString(value);
+    }
+    void value(double value)
+    {
+        separator();
+        if (std::isfinite(value)) {
+            m_out += QByteArray::number(value, 'g', QLocale::FloatingPointShortest);
+        } else {
+            m_out += "null";
+        }
+    }
+    void value(bool value)
+    {
+        separator();
+        m_out += value ? "true" : "false";
+    }
+    void finish()
+    {
+        m_out += '\n';
+    }
+
+private:
+    void separator()
+    {
+        if (m_afterKey) {
+            m_afterKey = false;
+            return;
+        }
+        if (!m_first.empty()) {
+            if (!m_first.back()) {
+                m_out += ',';
+            }
+            m_first.back() = false;
+        }
+    }
+
+    void writeString(QStringView str)
+    {
+        static constexpr const char hexDigits[] = "0123456789abcdef";
+        m_out += '"';
+        for (const auto c : str.toUtf8()) {
+            switch (c) {
+            case '"':
+                m_out += "\\\"";
+                break;
+            case '\\':
+                m_out += "\\\\";
+                break;
+            case '\n':
+                m_out += "\\n";
+                break;
+            case '\r':
+                m_out += "\\r";
+                break;
+            case '\t':
+                m_out += "\\t";
+                break;
+            default:
+                if (static_cast<uchar>(c) < 0x20) {
+                    m_out += "\\u00";
+                    m_out += hexDigits[(c >> 4) & 0xf];
+                    m_out += hexDigits[c & 0xf];
+                } else {
+                    m_out += c;
+                }
+            }
+        }
+        m_out += '"';
+    }
+
+    QByteArray &m_out;
+    std::vector<bool> m_first;
+    bool m_afterKey = false;
+};
+
+/** Same interface as JsonRecordWriter, for CBOR output. */
+class CborRecordWriter
+{
+public:
+    explicit CborRecordWriter(QByteArray &out)
+        : m_writer(&out)
+    {
+    }
+
+    void startMap()
+    {
+        m_writer.startMap();
+    }
+    void endMap()
+    {
+        m_writer.endMap();
+    }
+    void startArray()
+    {
+        m_writer.startArray();
+    }
+    void endArray()
+    {
+        m_writer.endArray();
+    }
+    void key(QLatin1StringView key)
+    {
+        m_writer.append(key);
+    }
+    void value(QStringView value)
+    {
+        m_writer.append(value);
+    }
+    void value(double value)
+    {
+        // keep integral values compact, as most numeric field values are integers
+        double integral = 0.0;
+        if (std::modf(value, &integral) == 0.0 && std::abs(integral) < 9007199254740992.0) {
+            m_writer.append(static_cast<qint64>(integral));
+        } else {
+            m_writer.append(value);
+        }
+    }
+    void value(bool value)
+    {
+        m_writer.append(value);
+    }
+    void finish()
+    {
+    }
+
+private:
+    QCborStreamWriter m_writer;
+};
+
+template<typename Writer>
+void writeString(Writer &writer, QLatin1StringView key, const QString &value)
+{
+    if (!value.isEmpty()) {
+        writer.key(key);
+        writer.value(QStringView(value));
+    }
+}
+
+template<typename Writer>
+void writeDate(Writer &writer, QLatin1StringView key, const QDateTime &value)
+{
+    if (value.isValid()) {
+        writer.key(key);
+        writer.value(QStringView(value.toString(Qt::ISODate)));
+    }
+}
+
+template<typename Writer>
+void writeFields(Writer &writer, QLatin1StringView section, const QList<Field> &fields)
+{
+    for (const auto &field : fields) {
+        writer.startMap();
+        writer.key("section"_L1);
+        writer.value(QStringView(QString(section)));
+        writeString(writer, "key"_L1, field.key());
+        writeString(writer, "label"_L1, field.label());
+        const auto value = field.value();
+        switch (value.typeId()) {
+        case QMetaType::Double:
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+            writer.key("value"_L1);
+            writer.value(value.toDouble());
+            break;
+        case QMetaType::QDateTime:
+            writeDate(writer, "value"_L1, value.toDateTime());
+            break;
+        default:
+            writeString(writer, "value"_L1, value.toString());
+        }
+        writer.endMap();
+    }
+}
+
+template<typename Writer>
+void writePass(Writer &writer, const Pass *pass)
+{
+    writer.key("type"_L1);
+    writer.value(QStringView(QString::fromLatin1(QMetaEnum::fromType<Pass::Type>().valueToKey(pass->type()))));
+    writeString(writer, "passTypeIdentifier"_L1, pass->passTypeIdentifier());
+    writeString(writer, "serialNumber"_L1, pass->serialNumber());
+    writeString(writer, "organizationName"_L1, pass->organizationName());
+    writeString(writer, "description"_L1, pass->description());
+    writeString(writer, "logoText"_L1, pass->logoText());
+    writeDate(writer, "relevantDate"_L1, pass->relevantDate());
+    writeDate(writer, "expirationDate"_L1, pass->expirationDate());
+    writer.key("voided"_L1);
+    writer.value(pass->isVoided());
+
+    writer.key("fields"_L1);
+    writer.startArray();
+    writeFields(writer, "header"_L1, pass->headerFields());
+    writeFields(writer, "primary"_L1, pass->primaryFields());
+    writeFields(writer, "secondary"_L1, pass->secondaryFields());
+    writeFields(writer, "auxiliary"_L1, pass->auxiliaryFields());
+    writeFields(writer, "back"_L1, pass->backFields());
+    writer.endArray();
+
+    writer.key("barcodes"_L1);
+    writer.startArray();
+    for (const auto &barcode : pass->barcodes()) {
+        writer.startMap();
+        writer.key("format"_L1);
+        writer.value(QStringView(QString::fromLatin1(QMetaEnum::fromType<Barcode::Format>().valueToKey(barcode.format()))));
+        writeString(writer, "message"_L1, barcode.message());
+        writeString(writer, "alternativeText"_L1, barcode.alternativeText());
+        writer.endMap();
+    }
+    writer.endArray();
+
+    writer.key("locations"_L1);
+    writer.startArray();
+    for (const auto &location : pass->locations()) {
+        writer.startMap();
+        writer.key("latitude"_L1);
+        writer.value(location.latitude());
+        writer.key("longitude"_L1);
+        writer.value(location.longitude());
+        if (!std::isnan(location.altitude())) {
+            writer.key("altitude"_L1);
+            writer.value(location.altitude());
+        }
+        writeString(writer, "relevantText"_L1, location.relevantText());
+        writer.endMap();
+    }
+    writer.endArray();
+}
+
+QLatin1StringView errorName(LoadOptions::Error error)
+{
+    switch (error) {
+    case LoadOptions::NoError:
+        break;
+    case LoadOptions::FileError:
+        return "FileError"_L1;
+    case LoadOptions::InvalidArchive:
+        return "InvalidArchive"_L1;
+    case LoadOptions::InvalidPassJson:
+        return "InvalidPassJson"_L1;
+    case LoadOptions::UnsupportedPass:
+        return "UnsupportedPass"_L1;
+    case LoadOptions::ResourceLimitExceeded:
+        return "ResourceLimitExceeded"_L1;
+    }
+    return "UnknownError"_L1;
+}
+
+template<typename Writer>
+QByteArray encodeRecord(const QString &source, const Pass *pass, LoadOptions::Error error)
+{
+    QByteArray record;
+    {
+        Writer writer(record);
+        writer.startMap();
+        writeString(writer, "source"_L1, source);
+        if (pass) {
+            writePass(writer, pass);
+        } else {
+            writer.key("error"_L1);
+            writer.value(QStringView(QString(errorName(error))));
+        }
+        writer.endMap();
+        writer.finish();
+    }
+    return record;
+}
+}
+
+namespace KPkPass
+{
+class PassExporterPrivate
+{
+public:
+    [[nodiscard]] QByteArray encode(const QString &source, const Pass *pass, LoadOptions::Error error) const;
+    bool enqueue(std::function<QByteArray()> &&task);
+    void enqueueReady(QByteArray &&record);
+    /** Writes the oldest pending record, waiting for it if necessary. */
+    void writeFront();
+    /** Writes all leading pending records that are done already. */
+    void writeReady();
+    void writeAll();
+    [[nodiscard]] int maximumPending() const;
+
+    QIODevice *m_device = nullptr;
+    PassExporter::Format m_format = PassExporter::JsonLines;
+    QThreadPool *m_threadPool = nullptr;
+    LoadOptions m_options;
+    std::deque<std::future<QByteArray>> m_pending;
+    int m_maximumPending = 0;
+    int m_recordCount = 0;
+    QString m_error;
+    bool m_finished = false;
+};
+}
+
+QByteArray PassExporterPrivate::encode(const QString &source, const Pass *pass, LoadOptions::Error error) const
+{
+    return m_format == PassExporter::Cbor ? encodeRecord<CborRecordWriter>(source, pass, error) : encodeRecord<JsonRecordWriter>(source, pass, error);
+}
+
+int PassExporterPrivate::maximumPending() const
+{
+    if (m_maximumPending > 0) {
+        return m_maximumPending;
+    }
+    return m_threadPool ? std::max(2 * m_threadPool->maxThreadCount(), 1) : 1;
+}
+
+bool PassExporterPrivate::enqueue(std::function<QByteArray()> &&task)
+{
+    if (m_finished) {
+        m_error = u"Export has already been finished."_s;
+        return false;
+    }
+    if (!m_threadPool) {
+        enqueueReady(task());
+        return true;
+    }
+
+    while (m_pending.size() >= static_cast<std::size_t>(maximumPending())) {
+        writeFront();
+    }
+    auto packagedTask = std::make_shared<std::packaged_task<QByteArray()>>(std::move(task));
+    m_pending.push_back(packagedTask->get_future());
+    m_threadPool->start([packagedTask]() {
+        (*packagedTask)();
+    });
+    writeReady();
+    return true;
+}
+
+void PassExporterPrivate::enqueueReady(QByteArray &&record)
+{
+    std::promise<QByteArray> promise;
+    promise.set_value(std::move(record));
+    m_pending.push_back(promise.get_future());
+    writeReady();
+}
+
+void PassExporterPrivate::writeFront()
+{
+    const auto record = m_pending.front().get();
+    m_pending.pop_front();
+    if (!m_error.isEmpty()) {
+        return;
+    }
+    if (m_device->write(record) != record.size()) {
+        m_error = m_device->errorString();
+        qCWarning(Log) << "Failed to write export record:" << m_error;
+        return;
+    }
+    ++m_recordCount;
+}
+
+void PassExporterPrivate::writeReady()
+{
+    while (!m_pending.empty() && m_pending.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        writeFront();
+    }
+}
+
+void PassExporterPrivate::writeAll()
+{
+    while (!m_pending.empty()) {
+        writeFront();
+    }
+}
+
+PassExporter::PassExporter(QIODevice *device, Format format)
+    : d(std::make_unique<PassExporterPrivate>())
+{
+    d->m_device = device;
+    d->m_format = format;
+    d->m_threadPool = QThreadPool::globalInstance();
+    if (!device->isOpen() && !device->open(QIODevice::WriteOnly)) {
+        d->m_error = device->errorString();
+    }
+}
+
+PassExporter::~PassExporter()
+{
+    if (!d->m_finished) {
+        finish();
+    }
+}
+
+void PassExporter::setThreadPool(QThreadPool *threadPool)
+{
+    d->m_threadPool = threadPool;
+}
+
+void PassExporter::setMaximumPendingRecords(int count)
+{
+    d->m_maximumPending = count;
+}
+
+void PassExporter::setLoadOptions(const LoadOptions &options)
+{
+    d->m_options = options;
+}
+
+bool PassExporter::addFile(const QString &fileName)
+{
+    return d->enqueue([d = d.get(), fileName, options = d->m_options]() {
+        auto error = LoadOptions::NoError;
+        std::unique_ptr<Pass> pass(Pass::fromFile(fileName, options, &error));
+        return d->encode(fileName, pass.get(), error);
+    });
+}
+
+bool PassExporter::addData(const QByteArray &data, const QString &source)
+{
+    return d->enqueue([d = d.get(), data, source, options = d->m_options]() {
+        auto error = LoadOptions::NoError;
+        std::unique_ptr<Pass> pass(Pass::fromData(data, options, &error));
+        return d->encode(source, pass.get(), error);
+    });
+}
+
+bool PassExporter::addPass(const Pass *pass, const QString &source)
+{
+    if (d->m_finished) {
+        d->m_error = u"Export has already been finished."_s;
+        return false;
+    }
+    d->enqueueReady(d->encode(source, pass, LoadOptions::InvalidPassJson));
+    return true;
+}
+
+bool PassExporter::finish()
+{
+    if (d->m_finished) {
+        return d->m_error.isEmpty();
+    }
+    d->m_finished = true;
+    d->writeAll();
+    return d->m_error.isEmpty();
+}
+
+int PassExporter::recordCount() const
+{
+    return d->m_recordCount;
+}
+
+QString PassExporter::errorString() const
+{
+    return d->m_error;
+}
@@ -0,0 +1,102 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSEXPORTER_H
+#define KPKPASS_PASSEXPORTER_H
+
+#include "kpkpass_export.h"
+
+#include <QString>
+
+#include <memory>
+
+class QByteArray;
+class QIODevice;
+class QThreadPool;
+
+namespace KPkPass
+{
+
+class LoadOptions;
+class Pass;
+class PassExporterPrivate;
+
+/*!
+ * \brief Streaming export of normalized pass data.
+ *
+ * Writes one record per pass, containing its metadata, fields, barcodes
+ * and locations, either as JSON Lines or as a sequence of CBOR maps.
+ * Records of passes that failed to load contain the source and an \c error
+ * entry instead, so that every input produces exactly one record.
+ *
+ * Passes added as files or raw data are loaded and encoded concurrently on
+ * a thread pool. Records are written in the order the passes were added,
+ * independent of the order in which they complete. The number of passes in
+ * flight is bounded, so memory use doesn't depend on the number of inputs.
+ *
+ * \class KPkPass::PassExporter
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassExporter
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassExporter
+{
+public:
+    /*!
+     * \value JsonLines One compact JSON object per line.
+     * \value Cbor A sequence of CBOR maps (RFC 8742).
+     */
+    enum Format {
+        JsonLines,
+        Cbor,
+    };
+
+    /*! Creates an exporter writing \a format to \a device.
+     *  \a device is opened for writing if it isn't open already. It is not owned by the exporter.
+     */
+    explicit PassExporter(QIODevice *device, Format format = JsonLines);
+    /*! Waits for and writes all pending records. */
+    ~PassExporter();
+
+    /*! Sets the thread pool passes are loaded and encoded on.
+     *  Default is the global thread pool. When set to \c nullptr, passes
+     *  are processed synchronously when added.
+     *  This needs to be set before adding passes.
+     */
+    void setThreadPool(QThreadPool *threadPool);
+    /*! Sets the maximum number of passes in flight.
+     *  Adding more passes than that blocks until the oldest one is written.
+     *  Default is twice the maximum thread count of the thread pool.
+     */
+    void setMaximumPendingRecords(int count);
+    /*! Sets the resource limits for loading passes, see LoadOptions. */
+    void setLoadOptions(const LoadOptions &options);
+
+    /*! Adds the pass file \a fileName, which is also used as the record source. */
+    bool addFile(const QString &fileName);
+    /*! Adds the .pkpass archive \a data, with \a source as the record source. */
+    bool addData(const QByteArray &data, const QString &source = {});
+    /*! Adds the already loaded \a pass.
+     *  The record is encoded immediately, \a pass doesn't need to remain valid after this returns.
+     */
+    bool addPass(const Pass *pass, const QString &source = {});
+
+    /*! Waits for all pending records and writes them.
+     *  Returns \c false if writing to the output device failed.
+     */
+    bool finish();
+
+    /*! Number of records written so far. */
+    [[nodiscard]] int recordCount() const;
+    /*! Human readable description of the last error. */
+    [[nodiscard]] QString errorString() const;
+
+private:
+    std::unique_ptr<PassExporterPrivate> d;
+};
+
+}
+
+#endif
@@ -0,0 +1,269 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pass.h"
+#include "pass_p.h"
+#include "passarchive_p.h"
+#include "zipdirectory_p.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QImage>
+
+#include <algorithm>
+
+using namespace KPkPass;
+
+namespace
+{
+/** Incremental scanner for the top-level keys of pass.json.
+ *  This only tracks string and nesting state, without building any DOM.
+ */
+class PassJsonScanner
+{
+public:
+    /** Feeds the next chunk of data, returns @c false once no more input is needed. */
+    bool scan(const char *data, qsizetype size);
+
+    int passType = -1;
+    int formatVersion = -1;
+    bool broken = false;
+
+private:
+    void keyFound();
+
+    QByteArray m_key;
+    QByteArray m_currentKey;
+    int m_depth = 0;
+    bool m_inString = false;
+    bool m_escape = false;
+    bool m_expectKey = false;
+    bool m_inFormatVersion = false;
+    bool m_done = false;
+};
+}
+
+// longest key we are interested in, anything longer can be discarded while scanning
+static constexpr qsizetype MaximumKeyLength = 16;
+// amount of pass.json we scan at most, this is far beyond any real-world pass.json
+// but bounds the work a deflate bomb can cause
+static constexpr qsizetype MaximumScanSize = 512 * 1024;
+
+void PassJsonScanner::keyFound()
+{
+    if (m_key == "formatVersion") {
+        m_inFormatVersion = true;
+        formatVersion = 0;
+    } else if (const auto idx = PassPrivate::passTypeIndex(QLatin1StringView(m_key)); idx >= 0 && (passType < 0 || idx < passType)) {
+        // PassPrivate::fromData picks the first pass type in passTypes order, not in document order
+        passType = idx;
+    }
+}
+
+bool PassJsonScanner::scan(const char *data, qsizetype size)
+{
+    for (qsizetype i = 0; i < size && !m_done; ++i) {
+        const auto c = data[i];
+        if (m_inString) {
+            if (m_escape) {
+                m_escape = false;
+            } else if (c == '\\') {
+                m_escape = true;
+            } else if (c == '"') {
+                m_inString = false;
+                if (m_depth == 1 && m_expectKey) {
+                    m_expectKey = false;
+                    std::swap(m_key, m_currentKey);
+                }
+                continue;
+            }
+            if (m_depth == 1 && m_expectKey && m_currentKey.size() <= MaximumKeyLength) {
+                m_currentKey.append(c);
+            }
+            continue;
+        }
+
+        if (m_inFormatVersion) {
+            if (c >= '0' && c <= '9') {
+                formatVersion = formatVersion * 10 + (c - '0');
+                if (formatVersion > 1000) {
+                    m_inFormatVersion = false;
+                }
+                continue;
+            }
+            if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+                m_inFormatVersion = false;
+            }
+        }
+
+        switch (c) {
+        case '"':
+            m_inString = true;
+            m_currentKey.clear();
+            break;
+        case '{':
+        case '[':
+            if (m_depth == 0 && c != '{') {
+                broken = true;
+                return false;
+            }
+            ++m_depth;
+            m_expectKey = m_depth == 1;
+            break;
+        case '}':
+        case ']':
+            if (--m_depth <= 0) {
+                m_done = true;
+            }
+            break;
+        case ',':
+            m_expectKey = m_depth == 1;
+            break;
+        case ':':
+            if (m_depth == 1) {
+                keyFound();
+            }
+            break;
+        default:
+            break;
+        }
+
+        // formatVersion is typically the first key, later keys can only change the pass type
+        // if we haven't found the one with the highest priority yet
+        if (passType == 0 && formatVersion >= 0 && !m_inFormatVersion) {
+            m_done = true;
+        }
+    }
+    return !m_done;
+}
+
+Pass::ProbeResult Pass::probe(QIODevice *device)
+{
+    ProbeResult result;
+    if (!device || !device->isOpen() || device->isSequential()) {
+        return result;
+    }
+
+    const auto eocd = ZipDirectory::findEndOfCentralDirectory(device);
+    if (!eocd) {
+        return result;
+    }
+    const auto entry = ZipDirectory::findEntry(device, *eocd, "pass.json");
+    if (!entry) {
+        return result;
+    }
+    PassJsonScanner scanner;
+    qsizetype scanned = 0;
+    bool exceeded = false;
+    if (!ZipDirectory::readData(device, *entry, [&](QByteArrayView data) {
+            const auto n = std::min<qsizetype>(data.size(), MaximumScanSize - scanned);
+            scanned += n;
+            if (!scanner.scan(data.data(), n)) {
+                return false;
+            }
+            // not done within the budget
+            exceeded = n < data.size() || scanned >= MaximumScanSize;
+            return !exceeded;
+        })
+        || exceeded) {
+        return result;
+    }
+
+    // same conditions as PassPrivate::fromData
+    if (scanner.broken || scanner.passType < 0 || scanner.formatVersion > 1) {
+        return result;
+    }
+    result.isValid = true;
+    result.type = static_cast<Type>(scanner.passType);
+    result.formatVersion = std::max(scanner.formatVersion, 0);
+    return result;
+}
+
+Pass::ProbeResult Pass::probe(const QByteArray &data)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return probe(&buffer);
+}
+
+Pass::ProbeResult Pass::probeFile(const QString &fileName)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        return {};
+    }
+    return probe(&file);
+}
+
+static QImage readImage(QIODevice *device, const QString &baseName, unsigned int devicePixelRatio, const QSize &size, const LoadOptions &options)
+{
+    if (!device->isOpen() || device->isSequential()) {
+        return {};
+    }
+    const auto eocd = ZipDirectory::findEndOfCentralDirectory(device);
+    if (!eocd || (options.maximumEntryCount() > 0 && eocd->entryCount > options.maximumEntryCount())) {
+        return {};
+    }
+
+    const auto entries = ZipDirectory::entries(device, *eocd);
+    QStringList names;
+    names.reserve((qsizetype)entries.size());
+    for (const auto &entry : entries) {
+        if (!entry.name.contains('/')) {
+            names.push_back(QString::fromUtf8(entry.name));
+        }
+    }
+    const auto variant = PassArchive::selectImageVariant(names, baseName, std::max(devicePixelRatio, 1u));
+    if (!variant) {
+        return {};
+    }
+    const auto entry = std::ranges::find_if(entries, [&variant](const auto &e) {
+        return e.name == variant->entryName.toUtf8();
+    });
+
+    // same checks as in ZipReader::read
+    const auto maxSize = options.maximumEntrySize();
+    if ((maxSize > 0 && entry->size > maxSize) || !ZipDirectory::hasPlausibleSize(*entry) || (entry->flags & ZipDirectory::Encrypted)) {
+        return {};
+    }
+    QByteArray data;
+    data.reserve(maxSize > 0 ? std::min(entry->size, maxSize) : entry->size);
+    bool exceeded = false;
+    if (!ZipDirectory::readData(device, *entry, [&](QByteArrayView chunk) {
+            // never inflate more than declared, that's what the limits were checked against
+            exceeded = data.size() + chunk.size() > entry->size;
+            if (!exceeded) {
+                data.append(chunk);
+            }
+            return !exceeded;
+        })
+        || exceeded || data.size() != entry->size || !ZipDirectory::verifyChecksum(*entry, data)) {
+        return {};
+    }
+
+    const auto targetSize = size.isValid() ? size * std::max(devicePixelRatio, 1u) : QSize();
+    auto img = PassArchive::decodeImage(data, options, targetSize);
+    const auto scaled = targetSize.isValid() && (img.width() == targetSize.width() || img.height() == targetSize.height());
+    img.setDevicePixelRatio(scaled ? std::max(devicePixelRatio, 1u) : variant->devicePixelRatio);
+    return img;
+}
+
+QImage Pass::imageFromData(const QByteArray &data, const QString &baseName, unsigned int devicePixelRatio, const QSize &size, const LoadOptions &options)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    return readImage(&buffer, baseName, devicePixelRatio, size, options);
+}
+
+QImage Pass::imageFromFile(const QString &fileName, const QString &baseName, unsigned int devicePixelRatio, const QSize &size, const LoadOptions &options)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly)) {
+        return {};
+    }
+    return readImage(&file, baseName, devicePixelRatio, size, options);
+}
@@ -0,0 +1,216 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passscheduler.h"
+#include "pass.h"
+
+#include <QDateTime>
+#include <QTimer>
+
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace KPkPass;
+
+namespace
+{
+enum class EventType {
+    BecomesRelevant,
+    StopsBeingRelevant,
+    Expires,
+};
+
+struct Event {
+    Pass *pass;
+    EventType type;
+};
+
+// trigger time in msecs since epoch -> event
+using EventQueue = std::multimap<qint64, Event>;
+
+struct Entry {
+    std::vector<EventQueue::iterator> events;
+    QMetaObject::Connection destroyedConnection;
+    bool relevant = false;
+};
+
+// QTimer can't handle arbitrarily long intervals, for events further in the future we re-arm the timer
+constexpr inline auto MaximumTimerInterval = std::chrono::milliseconds(24h);
+}
+
+namespace KPkPass
+{
+class PassSchedulerPrivate
+{
+public:
+    void schedule(Pass *pass, Entry &entry, qint64 time, EventType type);
+    void unschedule(Entry &entry);
+    void rearmTimer();
+    void processEvents();
+
+    PassScheduler *q = nullptr;
+    QTimer m_timer;
+    EventQueue m_queue;
+    std::unordered_map<const Pass *, Entry> m_passes;
+    std::chrono::seconds m_leadTime = 2h;
+    std::chrono::seconds m_trailTime = 1h;
+};
+}
+
+void PassSchedulerPrivate::schedule(Pass *pass, Entry &entry, qint64 time, EventType type)
+{
+    entry.events.push_back(m_queue.emplace(time, Event{pass, type}));
+}
+
+void PassSchedulerPrivate::unschedule(Entry &entry)
+{
+    for (const auto &it : entry.events) {
+        m_queue.erase(it);
+    }
+    entry.events.clear();
+}
+
+void PassSchedulerPrivate::rearmTimer()
+{
+    if (m_queue.empty()) {
+        m_timer.stop();
+        return;
+    }
+
+    const auto now = QDateTime::currentMSecsSinceEpoch();
+    const auto interval = std::chrono::milliseconds(std::max<qint64>(0, (*m_queue.begin()).first - now));
+    m_timer.start(std::min(interval, MaximumTimerInterval));
+}
+
+void PassSchedulerPrivate::processEvents()
+{
+    const auto now = QDateTime::currentMSecsSinceEpoch();
+    while (!m_queue.empty() && (*m_queue.begin()).first <= now) {
+        const auto it = m_queue.begin();
+        const auto ev = (*it).second;
+        auto &entry = m_passes[ev.pass];
+        std::erase(entry.events, it);
+        m_queue.erase(it);
+
+        // signal handlers might modify the queue, so we can't hold on to any iterator here
+        switch (ev.type) {
+        case EventType::BecomesRelevant:
+            entry.relevant = true;
+            Q_EMIT q->passBecameRelevant(ev.pass);
+            break;
+        case EventType::StopsBeingRelevant:
+            entry.relevant = false;
+            Q_EMIT q->passNoLongerRelevant(ev.pass);
+            break;
+        case EventType::Expires:
+            Q_EMIT q->passExpired(ev.pass);
+            break;
+        }
+    }
+    rearmTimer();
+}
+
+PassScheduler::PassScheduler(QObject *parent)
+    : QObject(parent)
+    , d(std::make_unique<PassSchedulerPrivate>())
+{
+    d->q = this;
+    d->m_timer.setSingleShot(true);
+    connect(&d->m_timer, &QTimer::timeout, this, [this]() {
+        d->processEvents();
+    });
+}
+
+PassScheduler::~PassScheduler()
+{
+    clear();
+}
+
+std::chrono::seconds PassScheduler::relevanceLeadTime() const
+{
+    return d->m_leadTime;
+}
+
+std::chrono::seconds PassScheduler::relevanceTrailTime() const
+{
+    return d->m_trailTime;
+}
+
+void PassScheduler::setRelevanceInterval(std::chrono::seconds leadTime, std::chrono::seconds trailTime)
+{
+    d->m_leadTime = leadTime;
+    d->m_trailTime = trailTime;
+}
+
+void PassScheduler::addPass(Pass *pass)
+{
+    if (!pass || d->m_passes.contains(pass)) {
+        return;
+    }
+
+    auto &entry = d->m_passes[pass];
+    entry.destroyedConnection = connect(pass, &QObject::destroyed, this, [this, pass]() {
+        removePass(pass);
+    });
+
+    const auto now = QDateTime::currentMSecsSinceEpoch();
+    auto expiration = std::numeric_limits<qint64>::max();
+    if (pass->isVoided()) {
+        expiration = now;
+    } else if (const auto dt = pass->expirationDate(); dt.isValid()) {
+        expiration = dt.toMSecsSinceEpoch();
+    }
+    if (expiration != std::numeric_limits<qint64>::max()) {
+        d->schedule(pass, entry, expiration, EventType::Expires);
+    }
+
+    if (const auto dt = pass->relevantDate(); dt.isValid()) {
+        const auto relevant = dt.toMSecsSinceEpoch();
+        const auto begin = relevant - std::chrono::milliseconds(d->m_leadTime).count();
+        const auto end = std::min(relevant + std::chrono::milliseconds(d->m_trailTime).count(), expiration);
+        // relevance intervals completely in the past are of no interest
+        if (end > now && begin < end) {
+            d->schedule(pass, entry, begin, EventType::BecomesRelevant);
+            d->schedule(pass, entry, end, EventType::StopsBeingRelevant);
+        }
+    }
+
+    d->rearmTimer();
+}
+
+void PassScheduler::removePass(Pass *pass)
+{
+    const auto it = d->m_passes.find(pass);
+    if (it == d->m_passes.end()) {
+        return;
+    }
+
+    d->unschedule((*it).second);
+    disconnect((*it).second.destroyedConnection);
+    d->m_passes.erase(it);
+    d->rearmTimer();
+}
+
+void PassScheduler::clear()
+{
+    for (auto &[pass, entry] : d->m_passes) {
+        disconnect(entry.destroyedConnection);
+    }
+    d->m_passes.clear();
+    d->m_queue.clear();
+    d->m_timer.stop();
+}
+
+bool PassScheduler::isRelevant(const Pass *pass) const
+{
+    const auto it = d->m_passes.find(pass);
+    return it != d->m_passes.end() && (*it).second.relevant;
+}
+
+#include "moc_passscheduler.cpp"
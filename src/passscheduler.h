@@ -0,0 +1,84 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSSCHEDULER_H
+#define KPKPASS_PASSSCHEDULER_H
+
+#include "kpkpass_export.h"
+
+#include <QObject>
+
+#include <chrono>
+#include <memory>
+
+namespace KPkPass
+{
+
+class Pass;
+class PassSchedulerPrivate;
+
+/*!
+ * \brief Notifies about time-based relevance and expiration changes of passes.
+ *
+ * Passes are registered once, their relevant and expiration dates are
+ * evaluated on registration and the resulting trigger times are kept
+ * in a time-ordered queue. A single timer is armed for the next pending
+ * event, so no periodic polling of all passes is needed.
+ *
+ * A pass is considered relevant from relevanceLeadTime() before its
+ * relevant date until relevanceTrailTime() after it, or until it expires
+ * if that happens earlier. Voided passes are considered expired.
+ *
+ * Passes are not owned by the scheduler, deleted passes are removed automatically.
+ *
+ * \class KPkPass::PassScheduler
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassScheduler
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassScheduler : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PassScheduler(QObject *parent = nullptr);
+    ~PassScheduler() override;
+
+    /*! Time before the relevant date a pass becomes relevant. Default is two hours. */
+    [[nodiscard]] std::chrono::seconds relevanceLeadTime() const;
+    /*! Time after the relevant date a pass stops being relevant. Default is one hour. */
+    [[nodiscard]] std::chrono::seconds relevanceTrailTime() const;
+    /*! Sets the relevance interval around the relevant date.
+     *  This only affects passes added afterwards.
+     */
+    void setRelevanceInterval(std::chrono::seconds leadTime, std::chrono::seconds trailTime);
+
+    /*! Registers \a pass.
+     *  Notifications for events that are already due are emitted from the event loop.
+     */
+    void addPass(KPkPass::Pass *pass);
+    /*! Unregisters \a pass, no further notifications for it will be emitted. */
+    void removePass(KPkPass::Pass *pass);
+    /*! Unregisters all passes. */
+    void clear();
+
+    /*! Returns whether \a pass is currently within its relevance interval. */
+    [[nodiscard]] bool isRelevant(const KPkPass::Pass *pass) const;
+
+Q_SIGNALS:
+    /*! Emitted when \a pass enters its relevance interval. */
+    void passBecameRelevant(KPkPass::Pass *pass);
+    /*! Emitted when \a pass leaves its relevance interval. */
+    void passNoLongerRelevant(KPkPass::Pass *pass);
+    /*! Emitted when \a pass reaches its expiration date, or when a voided pass is added. */
+    void passExpired(KPkPass::Pass *pass);
+
+private:
+    friend class PassSchedulerPrivate;
+    std::unique_ptr<PassSchedulerPrivate> d;
+};
+
+}
+
+#endif
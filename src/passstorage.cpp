@@ -0,0 +1,102 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passstorage_p.h"
+#include "pass_p.h"
+#include "stringpool_p.h"
+
+#include <QJsonArray>
+
+#include <algorithm>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+static constexpr const char *const fieldSectionNames[] = {"auxiliaryFields", "backFields", "headerFields", "primaryFields", "secondaryFields"};
+static_assert(std::size(fieldSectionNames) == PassStorage::FieldSectionCount);
+
+std::shared_ptr<PassStorage> PassStorage::create(const PassPrivate *d, const Pass *q)
+{
+    auto storage = std::make_shared<PassStorage>();
+
+    const auto passData = d->passData();
+    QJsonArray sections[FieldSectionCount];
+    qsizetype fieldCount = 0;
+    for (int i = 0; i < FieldSectionCount; ++i) {
+        sections[i] = passData.value(QLatin1StringView(fieldSectionNames[i])).toArray();
+        fieldCount += sections[i].size();
+    }
+
+    // sizes are known upfront, so element addresses are stable
+    storage->fields.reserve(fieldCount);
+    for (int i = 0; i < FieldSectionCount; ++i) {
+        storage->sectionBegin[i] = (qsizetype)storage->fields.size();
+        for (const auto &v : std::as_const(sections[i])) {
+            FieldPrivate field;
+            field.pass = q;
+            field.obj = v.toObject();
+            field.key = StringPool::intern(field.obj.value("key"_L1).toString());
+            field.row = field.obj.value("row"_L1).toInt(0);
+            if (i == AuxiliaryFields) {
+                storage->auxiliaryFieldsRowCount = std::max(storage->auxiliaryFieldsRowCount, field.row + 1);
+            }
+            storage->fields.push_back(std::move(field));
+        }
+    }
+    storage->sectionBegin[FieldSectionCount] = (qsizetype)storage->fields.size();
+
+    const auto barcodes = d->passObj.value("barcodes"_L1).toArray();
+    storage->barcodes.reserve(barcodes.size());
+    for (const auto &bc : barcodes) {
+        storage->barcodes.push_back(BarcodePrivate{q, bc.toObject()});
+    }
+    // just a single barcode
+    if (storage->barcodes.empty()) {
+        const auto bc = d->passObj.value("barcode"_L1).toObject();
+        if (!bc.isEmpty()) {
+            storage->barcodes.push_back(BarcodePrivate{q, bc});
+        }
+    }
+
+    const auto locations = d->passObj.value("locations"_L1).toArray();
+    storage->locations.reserve(locations.size());
+    for (const auto &v : locations) {
+        const auto obj = v.toObject();
+        storage->locations.push_back(LocationPrivate{
+            obj,
+            obj.value("latitude"_L1).toDouble(NAN),
+            obj.value("longitude"_L1).toDouble(NAN),
+            obj.value("altitude"_L1).toDouble(NAN),
+        });
+    }
+
+    const auto seats = q->semanticTags().value("seats"_L1).toArray();
+    storage->seats.reserve(seats.size());
+    for (const auto &v : seats) {
+        storage->seats.push_back(SeatPrivate{q, v.toObject()});
+    }
+
+    return storage;
+}
+
+PassElements::PassElements(const std::shared_ptr<PassStorage> &storage)
+    : auxiliaryFieldsRowCount(storage->auxiliaryFieldsRowCount)
+{
+    // handles share ownership of storage, without an allocation of their own
+    const auto makeHandles = [&storage]<typename T, typename Private>(QList<T> &handles, const std::vector<Private> &data) {
+        handles.reserve((qsizetype)data.size());
+        for (const auto &elem : data) {
+            handles.push_back(T(std::shared_ptr<const Private>(storage, &elem)));
+        }
+    };
+
+    makeHandles(fields, storage->fields);
+    for (int i = 0; i < PassStorage::FieldSectionCount; ++i) {
+        sections[i] = fields.mid(storage->sectionBegin[i], storage->sectionBegin[i + 1] - storage->sectionBegin[i]);
+    }
+    makeHandles(barcodes, storage->barcodes);
+    makeHandles(locations, storage->locations);
+    makeHandles(seats, storage->seats);
+}
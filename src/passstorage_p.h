@@ -0,0 +1,108 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSSTORAGE_P_H
+#define KPKPASS_PASSSTORAGE_P_H
+
+#include "barcode.h"
+#include "field.h"
+#include "location.h"
+#include "seat.h"
+
+#include <QJsonObject>
+#include <QList>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace KPkPass
+{
+
+class Pass;
+class PassPrivate;
+
+class FieldPrivate
+{
+public:
+    const Pass *pass = nullptr;
+    QJsonObject obj;
+    QString key;
+    int row = 0;
+};
+
+class BarcodePrivate
+{
+public:
+    const Pass *pass = nullptr;
+    QJsonObject obj;
+};
+
+class LocationPrivate
+{
+public:
+    QJsonObject obj;
+    double latitude = NAN;
+    double longitude = NAN;
+    double altitude = NAN;
+};
+
+class SeatPrivate
+{
+public:
+    const Pass *pass = nullptr;
+    QJsonObject obj;
+};
+
+/** Field, barcode, location and seat data of a pass, parsed once.
+ *  The public value types are handles into this, using aliasing shared
+ *  pointers. So they need no allocation of their own, and this stays
+ *  alive as long as any handle into it exists.
+ *  This must not be modified after handles have been created.
+ */
+class PassStorage
+{
+public:
+    /** Field sections, in the order fields are reported by Pass::fields(). */
+    enum FieldSection {
+        AuxiliaryFields,
+        BackFields,
+        HeaderFields,
+        PrimaryFields,
+        SecondaryFields,
+        FieldSectionCount,
+    };
+
+    [[nodiscard]] static std::shared_ptr<PassStorage> create(const PassPrivate *d, const Pass *q);
+
+    /** All fields, grouped by section. */
+    std::vector<FieldPrivate> fields;
+    /** Offset of each section in fields. */
+    qsizetype sectionBegin[FieldSectionCount + 1] = {};
+    std::vector<BarcodePrivate> barcodes;
+    std::vector<LocationPrivate> locations;
+    std::vector<SeatPrivate> seats;
+    int auxiliaryFieldsRowCount = 1;
+};
+
+/** Cached handle lists of a pass.
+ *  Held by the pass rather than by PassStorage, as that would be a reference cycle.
+ */
+class PassElements
+{
+public:
+    explicit PassElements(const std::shared_ptr<PassStorage> &storage);
+
+    QList<Field> sections[PassStorage::FieldSectionCount];
+    QList<Field> fields;
+    QList<Barcode> barcodes;
+    QList<Location> locations;
+    QList<Seat> seats;
+    int auxiliaryFieldsRowCount = 1;
+};
+
+}
+
+#endif
@@ -0,0 +1,149 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passstyle.h"
+#include "passstyle_p.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <algorithm>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+struct ImageSlotName {
+    const char *name;
+    PassStyle::ImageSlot slot;
+};
+static constexpr const ImageSlotName image_slot_names[] = {
+    {"icon", PassStyle::Icon},
+    {"logo", PassStyle::Logo},
+    {"primaryLogo", PassStyle::PrimaryLogo},
+    {"secondaryLogo", PassStyle::SecondaryLogo},
+    {"strip", PassStyle::Strip},
+    {"background", PassStyle::Background},
+    {"artwork", PassStyle::Artwork},
+    {"footer", PassStyle::Footer},
+    {"thumbnail", PassStyle::Thumbnail},
+};
+
+static QColor parseColor(QStringView s)
+{
+    if (s.startsWith("rgb("_L1, Qt::CaseInsensitive)) {
+        const auto l = s.mid(4, s.length() - 5).split(','_L1);
+        if (l.size() != 3) {
+            return {};
+        }
+        return QColor(l[0].trimmed().toInt(), l[1].trimmed().toInt(), l[2].trimmed().toInt());
+    }
+    if (s.startsWith("rgba("_L1, Qt::CaseInsensitive)) {
+        const auto l = s.mid(5, s.length() - 6).split(','_L1);
+        if (l.size() != 4) {
+            return {};
+        }
+        return QColor(l[0].trimmed().toInt(), l[1].trimmed().toInt(), l[2].trimmed().toInt(), l[3].trimmed().toDouble() * 255.0);
+    }
+    return QColor(s);
+}
+
+std::shared_ptr<const PassStylePrivate> PassStylePrivate::create(const QJsonObject &passObj, const QStringList &imageNames)
+{
+    auto style = std::make_shared<PassStylePrivate>();
+
+    const auto bg = passObj.value("backgroundColor"_L1);
+    style->hasBackgroundColor = bg.isString();
+    style->backgroundColor = parseColor(bg.toString());
+    const auto fg = passObj.value("foregroundColor"_L1);
+    style->hasForegroundColor = fg.isString();
+    style->foregroundColor = parseColor(fg.toString());
+    const auto label = passObj.value("labelColor"_L1);
+    style->hasLabelColor = label.isString() || style->hasForegroundColor;
+    style->labelColor = parseColor(label.toString());
+    if (!style->labelColor.isValid()) {
+        style->labelColor = style->foregroundColor;
+    }
+
+    const auto styleArray = passObj.value("preferredStyleSchemes"_L1).toArray();
+    style->preferredStyleSchemes.reserve(styleArray.size());
+    std::ranges::transform(styleArray, std::back_inserter(style->preferredStyleSchemes), [](const auto &v) {
+        return v.toString();
+    });
+
+    for (const auto &slot : image_slot_names) {
+        if (imageNames.contains(QLatin1StringView(slot.name))) {
+            style->images |= slot.slot;
+        }
+    }
+    return style;
+}
+
+PassStyle::PassStyle()
+{
+    static const std::shared_ptr<const PassStylePrivate> s_empty = std::make_shared<PassStylePrivate>();
+    d = s_empty;
+}
+
+PassStyle::PassStyle(std::shared_ptr<const PassStylePrivate> &&dd)
+    : d(std::move(dd))
+{
+}
+
+PassStyle::~PassStyle() = default;
+
+bool PassStyle::hasBackgroundColor() const
+{
+    return d->hasBackgroundColor;
+}
+
+bool PassStyle::hasForegroundColor() const
+{
+    return d->hasForegroundColor;
+}
+
+bool PassStyle::hasLabelColor() const
+{
+    return d->hasLabelColor;
+}
+
+QColor PassStyle::backgroundColor() const
+{
+    return d->backgroundColor;
+}
+
+QColor PassStyle::foregroundColor() const
+{
+    return d->foregroundColor;
+}
+
+QColor PassStyle::labelColor() const
+{
+    return d->labelColor;
+}
+
+QStringList PassStyle::preferredStyleSchemes() const
+{
+    return d->preferredStyleSchemes;
+}
+
+PassStyle::ImageSlots PassStyle::images() const
+{
+    return d->images;
+}
+
+bool PassStyle::hasImage(ImageSlot slot) const
+{
+    return slot != NoImage && d->images.testFlag(slot);
+}
+
+QString PassStyle::imageName(ImageSlot slot)
+{
+    const auto it = std::ranges::find_if(image_slot_names, [slot](const auto &s) {
+        return s.slot == slot;
+    });
+    return it != std::end(image_slot_names) ? QString::fromLatin1(it->name) : QString();
+}
+
+#include "moc_passstyle.cpp"
@@ -0,0 +1,107 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSSTYLE_H
+#define KPKPASS_PASSSTYLE_H
+
+#include "kpkpass_export.h"
+
+#include <QColor>
+#include <QMetaType>
+#include <QStringList>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class PassStylePrivate;
+
+/*!
+ * \brief The visual appearance properties of a pass.
+ *
+ * This is computed once per pass, with colors already parsed and
+ * fallbacks (such as the label color falling back to the foreground color)
+ * applied. Copies are cheap and share the same data.
+ *
+ * \sa Pass::style()
+ * \class KPkPass::PassStyle
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassStyle
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassStyle
+{
+    Q_GADGET
+    Q_PROPERTY(bool hasBackgroundColor READ hasBackgroundColor CONSTANT)
+    Q_PROPERTY(bool hasForegroundColor READ hasForegroundColor CONSTANT)
+    Q_PROPERTY(bool hasLabelColor READ hasLabelColor CONSTANT)
+    Q_PROPERTY(QColor backgroundColor READ backgroundColor CONSTANT)
+    Q_PROPERTY(QColor foregroundColor READ foregroundColor CONSTANT)
+    Q_PROPERTY(QColor labelColor READ labelColor CONSTANT)
+    Q_PROPERTY(QStringList preferredStyleSchemes READ preferredStyleSchemes CONSTANT)
+    Q_PROPERTY(KPkPass::PassStyle::ImageSlots images READ images CONSTANT)
+
+public:
+    /*!
+     * \value Icon
+     * \value Logo
+     * \value PrimaryLogo
+     * \value SecondaryLogo
+     * \value Strip
+     * \value Background
+     * \value Artwork
+     * \value Footer
+     * \value Thumbnail
+     */
+    enum ImageSlot {
+        NoImage = 0,
+        Icon = 1,
+        Logo = 2,
+        PrimaryLogo = 4,
+        SecondaryLogo = 8,
+        Strip = 16,
+        Background = 32,
+        Artwork = 64,
+        Footer = 128,
+        Thumbnail = 256,
+    };
+    Q_DECLARE_FLAGS(ImageSlots, ImageSlot)
+    Q_FLAG(ImageSlots)
+
+    PassStyle();
+    ~PassStyle();
+
+    [[nodiscard]] bool hasBackgroundColor() const;
+    [[nodiscard]] bool hasForegroundColor() const;
+    /*! Returns \c true if there is a label color, or a foreground color to fall back to. */
+    [[nodiscard]] bool hasLabelColor() const;
+
+    [[nodiscard]] QColor backgroundColor() const;
+    [[nodiscard]] QColor foregroundColor() const;
+    /*! Returns the label color, or the foreground color if the pass has no valid label color. */
+    [[nodiscard]] QColor labelColor() const;
+
+    /*! Preferred style schemes. */
+    [[nodiscard]] QStringList preferredStyleSchemes() const;
+
+    /*! The image slots for which the pass contains an image asset. */
+    [[nodiscard]] ImageSlots images() const;
+    /*! Returns \c true if the pass contains an image for \a slot. */
+    [[nodiscard]] bool hasImage(ImageSlot slot) const;
+    /*! The asset base name of \a slot, as used by Pass::image(). */
+    [[nodiscard]] static QString imageName(ImageSlot slot);
+
+private:
+    friend class PassPrivate;
+    explicit PassStyle(std::shared_ptr<const PassStylePrivate> &&dd);
+    std::shared_ptr<const PassStylePrivate> d;
+};
+
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(KPkPass::PassStyle::ImageSlots)
+
+#endif
@@ -0,0 +1,34 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSSTYLE_P_H
+#define KPKPASS_PASSSTYLE_P_H
+
+#include "passstyle.h"
+
+#include <memory>
+
+class QJsonObject;
+
+namespace KPkPass
+{
+class PassStylePrivate
+{
+public:
+    /** Resolves the style of a pass from its pass.json content and the base names of its image assets. */
+    [[nodiscard]] static std::shared_ptr<const PassStylePrivate> create(const QJsonObject &passObj, const QStringList &imageNames);
+
+    QColor backgroundColor;
+    QColor foregroundColor;
+    QColor labelColor;
+    QStringList preferredStyleSchemes;
+    PassStyle::ImageSlots images;
+    bool hasBackgroundColor = false;
+    bool hasForegroundColor = false;
+    bool hasLabelColor = false;
+};
+}
+
+#endif
@@ -0,0 +1,229 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passupdater.h"
+#include "logging.h"
+#include "pass.h"
+
+#include <QDateTime>
+#include <QNetworkAccessManager>
+#include <QNetworkReply>
+#include <QNetworkRequest>
+#include <QPointer>
+#include <QTimer>
+
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+namespace
+{
+struct Request {
+    QPointer<Pass> pass;
+    QDateTime lastModified;
+    QByteArray etag;
+};
+}
+
+namespace KPkPass
+{
+class PassUpdaterPrivate
+{
+public:
+    QNetworkAccessManager *nam();
+    void scheduleProcessing();
+    void processQueue();
+    void start(const Request &req);
+    void replyFinished(QNetworkReply *reply, const QPointer<Pass> &pass);
+
+    PassUpdater *q = nullptr;
+    QPointer<QNetworkAccessManager> m_nam;
+    std::deque<Request> m_queue;
+    std::vector<QNetworkReply *> m_running;
+    int m_maxConcurrent = 6;
+    bool m_processingScheduled = false;
+    bool m_active = false;
+};
+}
+
+QNetworkAccessManager *PassUpdaterPrivate::nam()
+{
+    if (!m_nam) {
+        m_nam = new QNetworkAccessManager(q);
+    }
+    return m_nam;
+}
+
+void PassUpdaterPrivate::scheduleProcessing()
+{
+    if (m_processingScheduled) {
+        return;
+    }
+    m_processingScheduled = true;
+    QMetaObject::invokeMethod(
+        q,
+        [this]() {
+            m_processingScheduled = false;
+            processQueue();
+        },
+        Qt::QueuedConnection);
+}
+
+void PassUpdaterPrivate::processQueue()
+{
+    while (!m_queue.empty() && (int)m_running.size() < m_maxConcurrent) {
+        const auto req = m_queue.front();
+        m_queue.pop_front();
+        start(req);
+    }
+
+    if (m_active && m_queue.empty() && m_running.empty()) {
+        m_active = false;
+        Q_EMIT q->finished();
+    }
+}
+
+void PassUpdaterPrivate::start(const Request &req)
+{
+    // pass deleted while queued
+    if (!req.pass) {
+        return;
+    }
+
+    const auto url = req.pass->passUpdateUrl();
+    if (!url.isValid() || (url.scheme() != "https"_L1 && url.scheme() != "http"_L1)) {
+        Q_EMIT q->updateFailed(req.pass, u"Pass has no valid web service URL."_s);
+        return;
+    }
+
+    QNetworkRequest netReq(url);
+    netReq.setRawHeader("Authorization", "ApplePass " + req.pass->authenticationToken().toUtf8());
+    if (req.lastModified.isValid()) {
+        netReq.setHeader(QNetworkRequest::IfModifiedSinceHeader, req.lastModified);
+    }
+    if (!req.etag.isEmpty()) {
+        netReq.setHeader(QNetworkRequest::IfNoneMatchHeader, QList<QByteArray>{req.etag});
+    }
+    // we handle HTTP caching ourselves via the conditional request headers
+    netReq.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+    netReq.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
+
+    auto reply = nam()->get(netReq);
+    m_running.push_back(reply);
+    QObject::connect(reply, &QNetworkReply::finished, q, [this, reply, pass = req.pass]() {
+        replyFinished(reply, pass);
+    });
+}
+
+void PassUpdaterPrivate::replyFinished(QNetworkReply *reply, const QPointer<Pass> &pass)
+{
+    reply->deleteLater();
+    std::erase(m_running, reply);
+
+    if (pass) {
+        const auto status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (status == 304) {
+            Q_EMIT q->passUnchanged(pass);
+        } else if (reply->error() != QNetworkReply::NoError) {
+            Q_EMIT q->updateFailed(pass, reply->errorString());
+        } else if (status != 200) {
+            Q_EMIT q->updateFailed(pass, u"Unexpected HTTP status code %1."_s.arg(status));
+        } else {
+            // KZip needs random access, so the data has to be fully received here anyway
+            auto updatedPass = Pass::fromData(reply->readAll(), q);
+            if (!updatedPass) {
+                Q_EMIT q->updateFailed(pass, u"Received invalid pass data."_s);
+            } else if (updatedPass->passTypeIdentifier() != pass->passTypeIdentifier() || updatedPass->serialNumber() != pass->serialNumber()) {
+                // a web service must not be able to replace a pass by a different one
+                qCWarning(Log) << "Pass update changed pass identity:" << pass->passUpdateUrl();
+                delete updatedPass;
+                Q_EMIT q->updateFailed(pass, u"Received a different pass."_s);
+            } else {
+                const auto lastModified = reply->header(QNetworkRequest::LastModifiedHeader).toDateTime();
+                const auto etag = reply->rawHeader("ETag");
+                Q_EMIT q->passUpdated(pass, updatedPass, lastModified, etag);
+                if (updatedPass->parent() == q) {
+                    updatedPass->deleteLater();
+                }
+            }
+        }
+    }
+
+    processQueue();
+}
+
+PassUpdater::PassUpdater(QObject *parent)
+    : QObject(parent)
+    , d(std::make_unique<PassUpdaterPrivate>())
+{
+    d->q = this;
+}
+
+PassUpdater::~PassUpdater()
+{
+    cancel();
+}
+
+void PassUpdater::setNetworkAccessManager(QNetworkAccessManager *nam)
+{
+    // running replies are owned by the current network access manager
+    if (!d->m_running.empty()) {
+        qCWarning(Log) << "Can't change the network access manager while requests are running";
+        return;
+    }
+    if (d->m_nam && d->m_nam->parent() == this) {
+        d->m_nam->deleteLater();
+    }
+    d->m_nam = nam;
+}
+
+int PassUpdater::maximumConcurrentRequests() const
+{
+    return d->m_maxConcurrent;
+}
+
+void PassUpdater::setMaximumConcurrentRequests(int count)
+{
+    d->m_maxConcurrent = std::max(1, count);
+    d->scheduleProcessing();
+}
+
+void PassUpdater::addPass(Pass *pass, const QDateTime &lastModified, const QByteArray &etag)
+{
+    if (!pass) {
+        return;
+    }
+    d->m_queue.push_back(Request{pass, lastModified, etag});
+    d->m_active = true;
+    d->scheduleProcessing();
+}
+
+void PassUpdater::addPass(Pass *pass)
+{
+    addPass(pass, QDateTime());
+}
+
+int PassUpdater::pendingCount() const
+{
+    return (int)(d->m_queue.size() + d->m_running.size());
+}
+
+void PassUpdater::cancel()
+{
+    d->m_active = false;
+    d->m_queue.clear();
+    const auto running = std::move(d->m_running);
+    d->m_running.clear();
+    for (auto reply : running) {
+        disconnect(reply, nullptr, this, nullptr);
+        reply->abort();
+        reply->deleteLater();
+    }
+}
+
+#include "moc_passupdater.cpp"
@@ -0,0 +1,94 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSUPDATER_H
+#define KPKPASS_PASSUPDATER_H
+
+#include "kpkpass_export.h"
+
+#include <QObject>
+
+#include <memory>
+
+class QDateTime;
+class QNetworkAccessManager;
+
+namespace KPkPass
+{
+
+class Pass;
+class PassUpdaterPrivate;
+
+/*!
+ * \brief Fetches updated versions of passes from their PassKit web service.
+ *
+ * Passes are queued with addPass(), together with the Last-Modified date and
+ * ETag of the version currently held, if known. Requests are then issued
+ * concurrently, up to maximumConcurrentRequests() at a time, sharing one
+ * QNetworkAccessManager so connections to the same web service are reused.
+ *
+ * Passes the web service reports as unchanged (HTTP 304) are not downloaded,
+ * only passUnchanged() is emitted for them.
+ *
+ * \class KPkPass::PassUpdater
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassUpdater
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassUpdater : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PassUpdater(QObject *parent = nullptr);
+    ~PassUpdater() override;
+
+    /*! Sets the network access manager used for requests.
+     *  If none is set, an internal one is created on first use.
+     *  The network access manager is not owned by the updater.
+     *  This is ignored while requests are running.
+     */
+    void setNetworkAccessManager(QNetworkAccessManager *nam);
+
+    /*! Maximum number of requests in flight at the same time. Default is 6. */
+    [[nodiscard]] int maximumConcurrentRequests() const;
+    /*! Sets the maximum number of concurrent requests. */
+    void setMaximumConcurrentRequests(int count);
+
+    /*! Queues \a pass for updating.
+     *  \a lastModified and \a etag describe the version currently held, as
+     *  previously reported by passUpdated(), and are used for conditional requests.
+     *  The request is issued from the event loop.
+     */
+    void addPass(KPkPass::Pass *pass, const QDateTime &lastModified, const QByteArray &etag = {});
+    /*! Same as above, without information about the currently held version. */
+    void addPass(KPkPass::Pass *pass);
+
+    /*! Number of queued or running requests. */
+    [[nodiscard]] int pendingCount() const;
+    /*! Aborts all queued and running requests, without emitting further signals. */
+    void cancel();
+
+Q_SIGNALS:
+    /*! Emitted when a new version of \a pass was received.
+     *  \a updatedPass is owned by the updater, and deleted after this signal
+     *  has been handled unless the receiver reparents it.
+     *  \a lastModified and \a etag identify the new version.
+     */
+    void passUpdated(KPkPass::Pass *pass, KPkPass::Pass *updatedPass, const QDateTime &lastModified, const QByteArray &etag);
+    /*! Emitted when the web service reports \a pass as unchanged. */
+    void passUnchanged(KPkPass::Pass *pass);
+    /*! Emitted when updating \a pass failed. */
+    void updateFailed(KPkPass::Pass *pass, const QString &errorMessage);
+    /*! Emitted when all queued requests have been processed. */
+    void finished();
+
+private:
+    friend class PassUpdaterPrivate;
+    std::unique_ptr<PassUpdaterPrivate> d;
+};
+
+}
+
+#endif
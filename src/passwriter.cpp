@@ -0,0 +1,248 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "passwriter.h"
+#include "logging.h"
+
+#include <KZip>
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QImage>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringEncoder>
+
+#include <algorithm>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+// amount of data used to estimate how well an entry compresses
+constexpr inline qsizetype CompressionSampleSize = 16 * 1024;
+// below this deflate overhead outweighs any gains
+constexpr inline qsizetype MinimumCompressionSize = 128;
+constexpr inline qsizetype ChunkSize = 64 * 1024;
+
+namespace KPkPass
+{
+class PassWriterPrivate
+{
+public:
+    explicit PassWriterPrivate(QIODevice *device);
+
+    bool beginEntry(const QString &path, PassWriter::Compression compression, QByteArrayView sample);
+    bool writeChunk(QByteArrayView data);
+    bool endEntry();
+    bool fail(const QString &error);
+
+    KZip m_zip;
+    QCryptographicHash m_hash;
+    QJsonObject m_manifest;
+    QString m_currentPath;
+    qint64 m_currentSize = 0;
+    QDateTime m_timestamp;
+    QString m_error;
+    bool m_finished = false;
+};
+}
+
+PassWriterPrivate::PassWriterPrivate(QIODevice *device)
+    : m_zip(device)
+    , m_hash(QCryptographicHash::Sha1)
+    , m_timestamp(QDateTime::currentDateTime())
+{
+}
+
+static bool isCompressible(QStringView path, QByteArrayView sample)
+{
+    // formats that are compressed already
+    static constexpr const char *compressedSuffixes[] = {".png", ".jpg", ".jpeg", ".gif", ".webp", ".zip", ".pkpass"};
+    if (std::any_of(std::begin(compressedSuffixes), std::end(compressedSuffixes), [path](const char *suffix) {
+            return path.endsWith(QLatin1StringView(suffix), Qt::CaseInsensitive);
+        })) {
+        return false;
+    }
+
+    if (sample.size() < MinimumCompressionSize) {
+        return false;
+    }
+
+    // try a fast compression of the beginning of the data, and only deflate if that saves at least 10%
+    sample = sample.first(std::min(sample.size(), CompressionSampleSize));
+    const auto compressed = qCompress(reinterpret_cast<const uchar *>(sample.data()), sample.size(), 1);
+    return compressed.size() - 4 < sample.size() * 9 / 10; // qCompress prepends the uncompressed size
+}
+
+bool PassWriterPrivate::beginEntry(const QString &path, PassWriter::Compression compression, QByteArrayView sample)
+{
+    if (m_finished) {
+        return fail(u"Archive has already been finished."_s);
+    }
+    if (path.isEmpty() || path == "manifest.json"_L1 || path == "signature"_L1 || m_manifest.contains(path)) {
+        return fail(u"Invalid or duplicate entry name: %1"_s.arg(path));
+    }
+    if (!m_zip.isOpen() && !m_zip.open(QIODevice::WriteOnly)) {
+        return fail(m_zip.errorString());
+    }
+
+    bool deflate = compression == PassWriter::DeflateCompression;
+    if (compression == PassWriter::AutoCompression) {
+        deflate = isCompressible(path, sample);
+    }
+    m_zip.setCompression(deflate ? KZip::DeflateCompression : KZip::NoCompression);
+
+    if (!m_zip.prepareWriting(path, QString(), QString(), 0, 0100644, m_timestamp, m_timestamp, m_timestamp)) {
+        return fail(m_zip.errorString());
+    }
+    m_currentPath = path;
+    m_currentSize = 0;
+    m_hash.reset();
+    return true;
+}
+
+bool PassWriterPrivate::writeChunk(QByteArrayView data)
+{
+    m_hash.addData(data);
+    m_currentSize += data.size();
+    if (!m_zip.writeData(data.data(), data.size())) {
+        return fail(m_zip.errorString());
+    }
+    return true;
+}
+
+bool PassWriterPrivate::endEntry()
+{
+    if (!m_zip.finishWriting(m_currentSize)) {
+        return fail(m_zip.errorString());
+    }
+    m_manifest.insert(m_currentPath, QString::fromLatin1(m_hash.result().toHex()));
+    m_currentPath.clear();
+    return true;
+}
+
+bool PassWriterPrivate::fail(const QString &error)
+{
+    qCWarning(Log) << error;
+    m_error = error;
+    return false;
+}
+
+PassWriter::PassWriter(QIODevice *device)
+    : d(std::make_unique<PassWriterPrivate>(device))
+{
+}
+
+PassWriter::~PassWriter() = default;
+
+bool PassWriter::writePassJson(const QJsonObject &pass)
+{
+    return writeFile(u"pass.json"_s, QJsonDocument(pass).toJson(QJsonDocument::Compact));
+}
+
+static QString quote(QStringView str)
+{
+    QString res;
+    res.reserve(str.size() + 2);
+    res.push_back(QLatin1Char('"'));
+    for (const auto c : str) {
+        if (c == QLatin1Char('"') || c == QLatin1Char('\\')) {
+            res.push_back(QLatin1Char('\\'));
+            res.push_back(c);
+        } else if (c == QLatin1Char('\n')) {
+            res += "\\n"_L1;
+        } else if (c == QLatin1Char('\r')) {
+            res += "\\r"_L1;
+        } else {
+            res.push_back(c);
+        }
+    }
+    res.push_back(QLatin1Char('"'));
+    return res;
+}
+
+bool PassWriter::writeCatalog(const QString &language, const QHash<QString, QString> &messages)
+{
+    auto keys = messages.keys();
+    std::sort(keys.begin(), keys.end());
+    QString catalog;
+    for (const auto &key : keys) {
+        catalog += quote(key) + " = "_L1 + quote(messages.value(key)) + ";\n"_L1;
+    }
+
+    // catalogs are supposed to be UTF-16
+    auto encoder = QStringEncoder(QStringEncoder::Utf16BE);
+    const QByteArray data = encoder(catalog);
+    return writeFile(language + ".lproj/pass.strings"_L1, data);
+}
+
+bool PassWriter::writeImage(const QString &baseName, const QImage &image, unsigned int devicePixelRatio)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, "PNG")) {
+        return d->fail(u"Failed to encode image %1."_s.arg(baseName));
+    }
+    const auto name = devicePixelRatio > 1 ? baseName + u'@' + QString::number(devicePixelRatio) + "x.png"_L1 : baseName + ".png"_L1;
+    return writeFile(name, data, NoCompression);
+}
+
+bool PassWriter::writeFile(const QString &path, const QByteArray &data, Compression compression)
+{
+    return d->beginEntry(path, compression, data) && d->writeChunk(data) && d->endEntry();
+}
+
+bool PassWriter::writeFile(const QString &path, QIODevice *source, Compression compression)
+{
+    if (!source || !source->isReadable()) {
+        return d->fail(u"Source device for %1 is not readable."_s.arg(path));
+    }
+    if (!d->beginEntry(path, compression, source->peek(CompressionSampleSize))) {
+        return false;
+    }
+
+    QByteArray buffer(ChunkSize, Qt::Uninitialized);
+    while (true) {
+        const auto size = source->read(buffer.data(), buffer.size());
+        if (size < 0) {
+            d->m_zip.finishWriting(d->m_currentSize);
+            return d->fail(source->errorString());
+        }
+        if (size == 0) {
+            break;
+        }
+        if (!d->writeChunk(QByteArrayView(buffer.constData(), size))) {
+            return false;
+        }
+    }
+    return d->endEntry();
+}
+
+bool PassWriter::finish()
+{
+    if (d->m_finished) {
+        return d->fail(u"Archive has already been finished."_s);
+    }
+    if (!d->m_manifest.contains("pass.json"_L1)) {
+        return d->fail(u"Archive has no pass.json."_s);
+    }
+
+    const auto manifest = QJsonDocument(d->m_manifest).toJson(QJsonDocument::Compact);
+    if (!d->m_zip.isOpen() || !d->m_zip.writeFile(u"manifest.json"_s, manifest)) {
+        return d->fail(d->m_zip.errorString());
+    }
+    d->m_finished = true;
+    if (!d->m_zip.close()) {
+        return d->fail(d->m_zip.errorString());
+    }
+    return true;
+}
+
+QString PassWriter::errorString() const
+{
+    return d->m_error;
+}
@@ -0,0 +1,90 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PASSWRITER_H
+#define KPKPASS_PASSWRITER_H
+
+#include "kpkpass_export.h"
+
+#include <QHash>
+#include <QString>
+
+#include <memory>
+
+class QIODevice;
+class QImage;
+class QJsonObject;
+
+namespace KPkPass
+{
+
+class PassWriterPrivate;
+
+/*!
+ * \brief Writes .pkpass archives.
+ *
+ * Entries are streamed into the archive as they are added, nothing but
+ * the manifest hashes is retained in memory. The SHA-1 hashes for
+ * manifest.json are computed from the same data that is fed to the
+ * compressor, and manifest.json is written by finish().
+ *
+ * The output device needs to be random-access, as the ZIP local headers
+ * are updated once an entry is complete.
+ *
+ * Signing passes is not supported, the resulting archive has no signature entry.
+ *
+ * \class KPkPass::PassWriter
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PassWriter
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PassWriter
+{
+public:
+    /*! Per-entry compression. */
+    enum Compression {
+        AutoCompression, ///< store data that is already compressed or doesn't compress well, deflate everything else
+        NoCompression, ///< always store
+        DeflateCompression, ///< always deflate
+    };
+
+    /*! Creates a writer for \a device.
+     *  \a device is opened for writing if it isn't open already. It is not owned by the writer.
+     */
+    explicit PassWriter(QIODevice *device);
+    ~PassWriter();
+
+    /*! Writes \a pass as pass.json. */
+    bool writePassJson(const QJsonObject &pass);
+    /*! Writes the translation catalog \a messages for \a language (e.g. "de")
+     *  as \c <language>.lproj/pass.strings.
+     */
+    bool writeCatalog(const QString &language, const QHash<QString, QString> &messages);
+    /*! Writes \a image as PNG file \a baseName (e.g. "icon"), with the
+     *  suffix for \a devicePixelRatio if that is larger than 1.
+     */
+    bool writeImage(const QString &baseName, const QImage &image, unsigned int devicePixelRatio = 1);
+    /*! Writes \a data as archive entry \a path. */
+    bool writeFile(const QString &path, const QByteArray &data, Compression compression = AutoCompression);
+    /*! Writes the remaining content of \a source as archive entry \a path.
+     *  \a source is read in chunks, it is not loaded into memory at once.
+     */
+    bool writeFile(const QString &path, QIODevice *source, Compression compression = AutoCompression);
+
+    /*! Writes manifest.json and finalizes the archive.
+     *  No further entries can be written afterwards.
+     */
+    bool finish();
+
+    /*! Human readable description of the last error. */
+    [[nodiscard]] QString errorString() const;
+
+private:
+    std::unique_ptr<PassWriterPrivate> d;
+};
+
+}
+
+#endif
@@ -0,0 +1,232 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "pathquery.h"
+#include "pass.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <algorithm>
+#include <vector>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+namespace KPkPass
+{
+class PathQueryPrivate
+{
+public:
+    struct Step {
+        enum Kind {
+            Key,
+            Index,
+            Wildcard,
+        };
+        Kind kind;
+        QString key;
+        qsizetype index = 0;
+    };
+
+    [[nodiscard]] bool compile(QStringView path);
+
+    /** Resolves the steps [@p begin, @p end), which must not contain wildcards. */
+    [[nodiscard]] QJsonValue resolve(QJsonValue value, std::size_t begin, std::size_t end) const;
+    /** Collects all matches starting at step @p i into @p result. */
+    void collect(const QJsonValue &value, std::size_t i, QJsonArray &result) const;
+    [[nodiscard]] QJsonValue evaluate(const QJsonValue &value, std::size_t i) const;
+
+    QString path;
+    std::vector<Step> steps;
+    bool hasWildcard = false;
+};
+}
+
+bool PathQueryPrivate::compile(QStringView path)
+{
+    qsizetype pos = 0;
+    while (true) {
+        const auto keyBegin = pos;
+        while (pos < path.size() && path[pos] != '.'_L1 && path[pos] != '['_L1 && path[pos] != ']'_L1) {
+            ++pos;
+        }
+        if (pos == keyBegin) {
+            return false;
+        }
+        steps.push_back({Step::Key, path.mid(keyBegin, pos - keyBegin).toString()});
+
+        while (pos < path.size() && path[pos] == '['_L1) {
+            const auto end = path.indexOf(']'_L1, pos);
+            if (end < 0) {
+                return false;
+            }
+            const auto subscript = path.mid(pos + 1, end - pos - 1);
+            if (subscript == "*"_L1) {
+                steps.push_back({Step::Wildcard, {}});
+                hasWildcard = true;
+            } else {
+                const auto isDigit = [](QChar c) {
+                    return c >= '0'_L1 && c <= '9'_L1;
+                };
+                if (subscript.isEmpty() || !std::all_of(subscript.begin(), subscript.end(), isDigit)) {
+                    return false;
+                }
+                bool ok = false;
+                const auto index = subscript.toLongLong(&ok);
+                if (!ok) {
+                    return false;
+                }
+                steps.push_back({Step::Index, {}, static_cast<qsizetype>(index)});
+            }
+            pos = end + 1;
+        }
+
+        if (pos == path.size()) {
+            return true;
+        }
+        if (path[pos] != '.'_L1) {
+            return false;
+        }
+        ++pos;
+    }
+}
+
+QJsonValue PathQueryPrivate::resolve(QJsonValue value, std::size_t begin, std::size_t end) const
+{
+    // QJsonObject/QJsonArray are implicitly shared, navigating them only adds references
+    for (auto i = begin; i < end; ++i) {
+        const auto &step = steps[i];
+        if (step.kind == Step::Key) {
+            if (!value.isObject()) {
+                return QJsonValue(QJsonValue::Undefined);
+            }
+            const auto obj = value.toObject();
+            const auto it = obj.constFind(step.key);
+            if (it == obj.constEnd()) {
+                return QJsonValue(QJsonValue::Undefined);
+            }
+            value = it.value();
+        } else {
+            if (!value.isArray()) {
+                return QJsonValue(QJsonValue::Undefined);
+            }
+            const auto array = value.toArray();
+            if (step.index >= array.size()) {
+                return QJsonValue(QJsonValue::Undefined);
+            }
+            value = array.at(step.index);
+        }
+    }
+    return value;
+}
+
+void PathQueryPrivate::collect(const QJsonValue &value, std::size_t i, QJsonArray &result) const
+{
+    if (i == steps.size()) {
+        result.append(value);
+        return;
+    }
+    const auto &step = steps[i];
+    if (step.kind != Step::Wildcard) {
+        // resolve everything up to the next wildcard in one go
+        auto next = i;
+        while (next < steps.size() && steps[next].kind != Step::Wildcard) {
+            ++next;
+        }
+        const auto v = resolve(value, i, next);
+        if (!v.isUndefined()) {
+            collect(v, next, result);
+        }
+        return;
+    }
+    if (!value.isArray()) {
+        return;
+    }
+    const auto array = value.toArray();
+    for (const auto &element : array) {
+        collect(element, i + 1, result);
+    }
+}
+
+QJsonValue PathQueryPrivate::evaluate(const QJsonValue &value, std::size_t i) const
+{
+    if (!hasWildcard) {
+        return resolve(value, i, steps.size());
+    }
+    QJsonArray result;
+    collect(value, i, result);
+    return result;
+}
+
+PathQuery::PathQuery() = default;
+
+PathQuery::PathQuery(QStringView path)
+{
+    auto query = std::make_shared<PathQueryPrivate>();
+    query->path = path.toString();
+    if (!query->compile(path)) {
+        query->steps.clear();
+    }
+    d = std::move(query);
+}
+
+PathQuery::PathQuery(const PathQuery &) = default;
+PathQuery::PathQuery(PathQuery &&) noexcept = default;
+PathQuery::~PathQuery() = default;
+PathQuery &PathQuery::operator=(const PathQuery &) = default;
+PathQuery &PathQuery::operator=(PathQuery &&) noexcept = default;
+
+bool PathQuery::isValid() const
+{
+    return d && !d->steps.empty();
+}
+
+QString PathQuery::path() const
+{
+    return d ? d->path : QString();
+}
+
+bool PathQuery::hasWildcard() const
+{
+    return isValid() && d->hasWildcard;
+}
+
+QJsonValue PathQuery::evaluate(const Pass *pass) const
+{
+    if (!isValid() || !pass) {
+        return QJsonValue(QJsonValue::Undefined);
+    }
+    // the first step is always a key, look that up directly instead of copying the root object
+    const auto value = pass->rawValue(d->steps.front().key);
+    if (value.isUndefined()) {
+        return d->hasWildcard ? QJsonValue(QJsonArray()) : value;
+    }
+    return d->evaluate(value, 1);
+}
+
+QJsonValue PathQuery::evaluate(const QJsonValue &root) const
+{
+    if (!isValid()) {
+        return QJsonValue(QJsonValue::Undefined);
+    }
+    return d->evaluate(root, 0);
+}
+
+QList<QList<QJsonValue>> PathQuery::evaluate(const QList<PathQuery> &queries, const QList<Pass *> &passes)
+{
+    QList<QList<QJsonValue>> columns;
+    columns.reserve(queries.size());
+    for (qsizetype i = 0; i < queries.size(); ++i) {
+        columns.emplace_back(passes.size(), QJsonValue(QJsonValue::Undefined));
+    }
+    // process one pass at a time, so its JSON data stays hot in the cache for all queries
+    for (qsizetype row = 0; row < passes.size(); ++row) {
+        for (qsizetype col = 0; col < queries.size(); ++col) {
+            columns[col][row] = queries[col].evaluate(passes[row]);
+        }
+    }
+    return columns;
+}
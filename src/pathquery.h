@@ -0,0 +1,86 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_PATHQUERY_H
+#define KPKPASS_PATHQUERY_H
+
+#include "kpkpass_export.h"
+
+#include <QJsonValue>
+#include <QList>
+#include <QString>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class Pass;
+class PathQueryPrivate;
+
+/*!
+ * \brief A compiled path expression for extracting values from pass.json.
+ *
+ * Paths consist of object keys separated by dots, each optionally followed
+ * by any number of array subscripts. A subscript is either a non-negative
+ * index or \c * to select all array elements, e.g.:
+ * \list
+ * \li \c boardingPass.primaryFields[*].value
+ * \li \c semantics.seats[0].seatNumber
+ * \endlist
+ *
+ * Parsing happens once on construction, so the same query can be evaluated
+ * efficiently against many passes. Evaluation only navigates the shared JSON
+ * data of the pass, and doesn't create any intermediate copies of it.
+ *
+ * \class KPkPass::PathQuery
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/PathQuery
+ * \since 26.08
+ */
+class KPKPASS_EXPORT PathQuery
+{
+public:
+    /*! Creates an invalid query. */
+    PathQuery();
+    /*! Compiles \a path, check isValid() for the result. */
+    explicit PathQuery(QStringView path);
+    PathQuery(const PathQuery &);
+    PathQuery(PathQuery &&) noexcept;
+    ~PathQuery();
+    PathQuery &operator=(const PathQuery &);
+    PathQuery &operator=(PathQuery &&) noexcept;
+
+    /*! Returns \c true if the path was compiled successfully. */
+    [[nodiscard]] bool isValid() const;
+    /*! The path expression this query was created from. */
+    [[nodiscard]] QString path() const;
+    /*! Returns \c true if the path contains a \c [*] subscript
+     *  and thus can produce more than one value.
+     */
+    [[nodiscard]] bool hasWildcard() const;
+
+    /*! Evaluates this query against the pass.json content of \a pass.
+     *  For paths with wildcards this returns an array of all matched values,
+     *  otherwise the matched value, or an undefined value if nothing matched.
+     */
+    [[nodiscard]] QJsonValue evaluate(const Pass *pass) const;
+    /*! Evaluates this query against the JSON value \a root. */
+    [[nodiscard]] QJsonValue evaluate(const QJsonValue &root) const;
+
+    /*! Evaluates all \a queries against all \a passes.
+     *  The result contains one column per query, each with one value per
+     *  pass, in the order of \a queries and \a passes respectively.
+     *  Invalid queries produce a column of undefined values.
+     */
+    [[nodiscard]] static QList<QList<QJsonValue>> evaluate(const QList<PathQuery> &queries, const QList<Pass *> &passes);
+
+private:
+    std::shared_ptr<const PathQueryPrivate> d;
+};
+
+}
+
+#endif
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+// SPDX-License-Identifier: LGPL-2.0-or-later
+
+#include "fieldmodel.h"
+
+using namespace Qt::Literals;
+
+FieldModel::FieldModel(QObject *parent)
+    : QAbstractListModel(parent)
+{
+}
+
+FieldModel::~FieldModel() = default;
+
+KPkPass::Pass *FieldModel::pass() const
+{
+    return m_pass;
+}
+
+void FieldModel::setPass(KPkPass::Pass *pass)
+{
+    if (m_pass == pass) {
+        return;
+    }
+    if (m_pass) {
+        disconnect(m_pass, nullptr, this, nullptr);
+    }
+    m_pass = pass;
+    if (m_pass) {
+        connect(m_pass, &QObject::destroyed, this, [this]() {
+            reset();
+            Q_EMIT passChanged();
+        });
+        connect(m_pass, &KPkPass::Pass::languageChanged, this, &FieldModel::reset);
+    }
+    reset();
+    Q_EMIT passChanged();
+}
+
+FieldModel::Section FieldModel::section() const
+{
+    return m_section;
+}
+
+void FieldModel::setSection(Section section)
+{
+    if (m_section == section) {
+        return;
+    }
+    m_section = section;
+    reset();
+    Q_EMIT sectionChanged();
+}
+
+void FieldModel::reset()
+{
+    beginResetModel();
+    m_fields.clear();
+    if (m_pass) {
+        switch (m_section) {
+        case AuxiliaryFields:
+            m_fields = m_pass->auxiliaryFields();
+            break;
+        case BackFields:
+            m_fields = m_pass->backFields();
+            break;
+        case HeaderFields:
+            m_fields = m_pass->headerFields();
+            break;
+        case PrimaryFields:
+            m_fields = m_pass->primaryFields();
+            break;
+        case SecondaryFields:
+            m_fields = m_pass->secondaryFields();
+            break;
+        case AllFields:
+            m_fields = m_pass->fields();
+            break;
+        }
+    }
+    m_rowData.clear();
+    m_rowData.resize(m_fields.size());
+    endResetModel();
+}
+
+const FieldModel::RowData &FieldModel::rowData(int row) const
+{
+    auto &data = m_rowData[row];
+    if (!data) {
+        const auto &field = m_fields.at(row);
+        data = RowData{field.label(), field.valueDisplayString(), field.textAlignment()};
+    }
+    return *data;
+}
+
+int FieldModel::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return 0;
+    }
+    return (int)m_fields.size();
+}
+
+QVariant FieldModel::data(const QModelIndex &index, int role) const
+{
+    if (!checkIndex(index, CheckIndexOption::IndexIsValid | CheckIndexOption::ParentIsInvalid)) {
+        return {};
+    }
+
+    const auto &field = m_fields.at(index.row());
+    switch (role) {
+    case Qt::DisplayRole:
+    case ValueDisplayStringRole:
+        return rowData(index.row()).valueDisplayString;
+    case KeyRole:
+        return field.key();
+    case LabelRole:
+        return rowData(index.row()).label;
+    case TextAlignmentRole:
+        return QVariant::fromValue(rowData(index.row()).textAlignment);
+    case RowRole:
+        return field.row();
+    case FieldRole:
+        return QVariant::fromValue(field);
+    }
+    return {};
+}
+
+QHash<int, QByteArray> FieldModel::roleNames() const
+{
+    auto r = QAbstractListModel::roleNames();
+    r.insert(KeyRole, "key");
+    r.insert(LabelRole, "label");
+    r.insert(ValueDisplayStringRole, "valueDisplayString");
+    r.insert(TextAlignmentRole, "textAlignment");
+    r.insert(RowRole, "row");
+    r.insert(FieldRole, "field");
+    return r;
+}
+
+#include "moc_fieldmodel.cpp"
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+// SPDX-License-Identifier: LGPL-2.0-or-later
+
+#ifndef KPKPASS_FIELDMODEL_H
+#define KPKPASS_FIELDMODEL_H
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <qqmlintegration.h>
+
+#include <field.h>
+#include <pass.h>
+
+#include <optional>
+#include <vector>
+
+/*!
+ * \brief List model of the fields of one section of a pass.
+ *
+ * Unlike the field list properties of Pass this doesn't need to be converted
+ * to a JS array on every binding evaluation, and the display data of a row
+ * is only computed once it is first requested.
+ */
+class FieldModel : public QAbstractListModel
+{
+    Q_OBJECT
+    QML_ELEMENT
+    Q_PROPERTY(KPkPass::Pass *pass READ pass WRITE setPass NOTIFY passChanged)
+    Q_PROPERTY(Section section READ section WRITE setSection NOTIFY sectionChanged)
+
+public:
+    enum Section {
+        AuxiliaryFields,
+        BackFields,
+        HeaderFields,
+        PrimaryFields,
+        SecondaryFields,
+        AllFields,
+    };
+    Q_ENUM(Section)
+
+    enum Role {
+        KeyRole = Qt::UserRole,
+        LabelRole,
+        ValueDisplayStringRole,
+        TextAlignmentRole,
+        RowRole,
+        FieldRole,
+    };
+    Q_ENUM(Role)
+
+    explicit FieldModel(QObject *parent = nullptr);
+    ~FieldModel() override;
+
+    [[nodiscard]] KPkPass::Pass *pass() const;
+    void setPass(KPkPass::Pass *pass);
+    [[nodiscard]] Section section() const;
+    void setSection(Section section);
+
+    [[nodiscard]] int rowCount(const QModelIndex &parent = {}) const override;
+    [[nodiscard]] QVariant data(const QModelIndex &index, int role) const override;
+    [[nodiscard]] QHash<int, QByteArray> roleNames() const override;
+
+    /*! Discards all cached display data.
+     *  This happens automatically when the language of the pass changes,
+     *  it's only needed after changing KPkPass::Pass::defaultLanguage().
+     */
+    Q_INVOKABLE void reset();
+
+Q_SIGNALS:
+    void passChanged();
+    void sectionChanged();
+
+private:
+    struct RowData {
+        QString label;
+        QString valueDisplayString;
+        Qt::Alignment textAlignment;
+    };
+
+    const RowData &rowData(int row) const;
+
+    QPointer<KPkPass::Pass> m_pass;
+    Section m_section = BackFields;
+    QList<KPkPass::Field> m_fields;
+    mutable std::vector<std::optional<RowData>> m_rowData;
+};
+
+#endif
@@ -0,0 +1,163 @@
+// SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+// SPDX-License-Identifier: LGPL-2.0-or-later
+
+#include "passimageprovider.h"
+
+#include <pass.h>
+
+#include <QImage>
+#include <QQmlEngine>
+#include <QRunnable>
+#include <QThreadPool>
+
+#include <atomic>
+#include <cmath>
+
+using namespace Qt::Literals;
+
+QString PassImageRegistry::insert(const KPkPass::Pass *pass, bool &inserted)
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_keys.constFind(pass);
+    inserted = it == m_keys.constEnd();
+    if (!inserted) {
+        return it.value();
+    }
+    const auto key = QString::number(m_nextKey++);
+    m_keys.insert(pass, key);
+    m_assets.insert(key, pass->assets());
+    return key;
+}
+
+void PassImageRegistry::remove(const KPkPass::Pass *pass)
+{
+    QMutexLocker locker(&m_mutex);
+    if (const auto key = m_keys.take(pass); !key.isEmpty()) {
+        m_assets.remove(key);
+    }
+}
+
+KPkPass::PassAssets PassImageRegistry::assets(const QString &key) const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_assets.value(key);
+}
+
+namespace
+{
+class PassImageResponse : public QQuickImageResponse, public QRunnable
+{
+public:
+    explicit PassImageResponse(KPkPass::PassAssets &&assets, QString &&name, unsigned int dpr, const QSize &requestedSize)
+        : m_assets(std::move(assets))
+        , m_name(std::move(name))
+        , m_requestedSize(requestedSize)
+        , m_dpr(dpr)
+    {
+        setAutoDelete(false);
+    }
+
+    void run() override
+    {
+        if (!m_cancelled) {
+            m_image = m_assets.image(m_name, m_dpr);
+            // requested sizes are in device-independent pixels
+            if (!m_image.isNull() && m_requestedSize.isValid()) {
+                const auto dpr = m_image.devicePixelRatio();
+                const QSize targetSize(std::lround(m_requestedSize.width() * dpr), std::lround(m_requestedSize.height() * dpr));
+                if (targetSize.width() < m_image.width() || targetSize.height() < m_image.height()) {
+                    m_image = m_image.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+                    m_image.setDevicePixelRatio(dpr);
+                }
+            }
+        }
+        Q_EMIT finished();
+    }
+
+    [[nodiscard]] QQuickTextureFactory *textureFactory() const override
+    {
+        return QQuickTextureFactory::textureFactoryForImage(m_image);
+    }
+
+    [[nodiscard]] QString errorString() const override
+    {
+        return m_image.isNull() && !m_cancelled ? u"Image asset %1 not found."_s.arg(m_name) : QString();
+    }
+
+    void cancel() override
+    {
+        m_cancelled = true;
+    }
+
+private:
+    KPkPass::PassAssets m_assets;
+    QString m_name;
+    QImage m_image;
+    QSize m_requestedSize;
+    unsigned int m_dpr;
+    std::atomic<bool> m_cancelled = false;
+};
+}
+
+PassImageProvider::PassImageProvider(const std::shared_ptr<PassImageRegistry> &registry)
+    : m_registry(registry)
+{
+}
+
+PassImageProvider::~PassImageProvider() = default;
+
+// id format: <key>/<asset name>@<dpr>x
+QQuickImageResponse *PassImageProvider::requestImageResponse(const QString &id, const QSize &requestedSize)
+{
+    const auto keyEnd = id.indexOf(u'/');
+    const auto dprBegin = id.lastIndexOf(u'@');
+    auto dpr = 1u;
+    if (dprBegin > keyEnd && id.endsWith(u'x')) {
+        dpr = std::max(1u, QStringView(id).mid(dprBegin + 1, id.size() - dprBegin - 2).toUInt());
+    }
+
+    auto assets = keyEnd > 0 ? m_registry->assets(id.left(keyEnd)) : KPkPass::PassAssets();
+    auto name = id.mid(keyEnd + 1, (dprBegin > keyEnd ? dprBegin : id.size()) - keyEnd - 1);
+    auto response = new PassImageResponse(std::move(assets), std::move(name), dpr, requestedSize);
+    QThreadPool::globalInstance()->start(response);
+    return response;
+}
+
+PassImage::PassImage(QObject *parent)
+    : QObject(parent)
+    , m_registry(std::make_shared<PassImageRegistry>())
+{
+}
+
+PassImage::~PassImage() = default;
+
+QUrl PassImage::url(KPkPass::Pass *pass, const QString &name, int devicePixelRatio)
+{
+    if (!pass || !pass->hasImage(name)) {
+        return {};
+    }
+
+    bool inserted = false;
+    const auto key = m_registry->insert(pass, inserted);
+    if (inserted) {
+        connect(pass, &QObject::destroyed, this, [this, pass]() {
+            m_registry->remove(pass);
+        });
+    }
+
+    QUrl url;
+    url.setScheme(u"image"_s);
+    url.setHost(u"pkpass"_s);
+    url.setPath(u'/' + key + u'/' + name + u'@' + QString::number(std::max(1, devicePixelRatio)) + u'x');
+    return url;
+}
+
+PassImage *PassImage::create(QQmlEngine *qmlEngine, [[maybe_unused]] QJSEngine *jsEngine)
+{
+    auto provider = new PassImage;
+    // the image provider is owned by the engine, the registry is shared with it
+    if (!qmlEngine->imageProvider(u"pkpass"_s)) {
+        qmlEngine->addImageProvider(u"pkpass"_s, new PassImageProvider(provider->m_registry));
+    }
+    return provider;
+}
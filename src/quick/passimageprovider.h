@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+// SPDX-License-Identifier: LGPL-2.0-or-later
+
+#ifndef KPKPASS_PASSIMAGEPROVIDER_H
+#define KPKPASS_PASSIMAGEPROVIDER_H
+
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QQuickAsyncImageProvider>
+#include <QUrl>
+#include <qqmlintegration.h>
+
+#include <passassets.h>
+
+#include <memory>
+
+class QJSEngine;
+class QQmlEngine;
+
+namespace KPkPass
+{
+class Pass;
+}
+
+/** Passes whose images can be requested from the image provider.
+ *  Accessed from the GUI thread for registration and from the image loader threads for lookup.
+ */
+class PassImageRegistry
+{
+public:
+    /** Returns the URL key for @p pass, @p inserted is set if it wasn't registered yet. */
+    [[nodiscard]] QString insert(const KPkPass::Pass *pass, bool &inserted);
+    void remove(const KPkPass::Pass *pass);
+    [[nodiscard]] KPkPass::PassAssets assets(const QString &key) const;
+
+private:
+    mutable QMutex m_mutex;
+    QHash<const KPkPass::Pass *, QString> m_keys;
+    QHash<QString, KPkPass::PassAssets> m_assets;
+    quint64 m_nextKey = 0;
+};
+
+/** Asynchronous image provider for image://pkpass/ URLs.
+ *  Images are decoded and scaled on a thread pool, using the image cache of the pass.
+ */
+class PassImageProvider : public QQuickAsyncImageProvider
+{
+public:
+    explicit PassImageProvider(const std::shared_ptr<PassImageRegistry> &registry);
+    ~PassImageProvider() override;
+
+    QQuickImageResponse *requestImageResponse(const QString &id, const QSize &requestedSize) override;
+
+private:
+    std::shared_ptr<PassImageRegistry> m_registry;
+};
+
+/*!
+ * \brief Creates image://pkpass/ URLs for pass image assets.
+ *
+ * Images loaded via those URLs are decoded asynchronously, so they
+ * should be preferred over Pass::logo() etc. in views showing many passes.
+ *
+ * \code
+ * Image {
+ *     source: PassImage.url(pass, "logo", Screen.devicePixelRatio)
+ *     asynchronous: true
+ * }
+ * \endcode
+ */
+class PassImage : public QObject
+{
+    Q_OBJECT
+    QML_ELEMENT
+    QML_SINGLETON
+
+public:
+    ~PassImage() override;
+
+    /*! Returns the URL of the image asset \a name of \a pass, or an empty URL if there is no such image. */
+    Q_INVOKABLE [[nodiscard]] QUrl url(KPkPass::Pass *pass, const QString &name, int devicePixelRatio = 1);
+
+    static PassImage *create(QQmlEngine *qmlEngine, QJSEngine *jsEngine);
+
+private:
+    explicit PassImage(QObject *parent = nullptr);
+    std::shared_ptr<PassImageRegistry> m_registry;
+};
+
+#endif
@@ -7,7 +7,10 @@
 #include <barcode.h>
 #include <boardingpass.h>
 #include <field.h>
+#include <passstyle.h>
 #include <seat.h>
+#include <semanticplace.h>
+#include <semantictags.h>
 
 #define FOREIGN_ENUM_GADGET(Class)                                                                                                                             \
     class Class##Derived : public KPkPass::Class                                                                                                               \
@@ -56,3 +59,25 @@ class SeatForeign
     QML_VALUE_TYPE(seat)
     QML_FOREIGN(KPkPass::Seat)
 };
+
+class PassStyleForeign
+{
+    Q_GADGET
+    QML_VALUE_TYPE(passStyle)
+    QML_FOREIGN(KPkPass::PassStyle)
+};
+FOREIGN_ENUM_GADGET(PassStyle)
+
+class SemanticTagsForeign
+{
+    Q_GADGET
+    QML_VALUE_TYPE(semanticTags)
+    QML_FOREIGN(KPkPass::SemanticTags)
+};
+
+class SemanticPlaceForeign
+{
+    Q_GADGET
+    QML_VALUE_TYPE(semanticPlace)
+    QML_FOREIGN(KPkPass::SemanticPlace)
+};
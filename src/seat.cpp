@@ -6,24 +6,17 @@
 #include "seat.h"
 #include "pass.h"
 #include "pass_p.h"
+#include "passstorage_p.h"
 
 #include <QJsonObject>
 
 using namespace Qt::Literals;
 using namespace KPkPass;
 
-namespace KPkPass
-{
-class SeatPrivate
-{
-public:
-    const Pass *pass = nullptr;
-    QJsonObject obj;
-};
-}
+static const SeatPrivate s_emptySeat;
 
 Seat::Seat()
-    : d(new SeatPrivate)
+    : d(std::shared_ptr<const SeatPrivate>(), &s_emptySeat)
 {
 }
 
@@ -33,11 +26,9 @@ Seat::~Seat() = default;
 Seat &Seat::operator=(const Seat &) = default;
 Seat &Seat::operator=(Seat &&) noexcept = default;
 
-Seat::Seat(const QJsonObject &obj, const Pass *pass)
-    : d(new SeatPrivate)
+Seat::Seat(std::shared_ptr<const SeatPrivate> &&dd)
+    : d(std::move(dd))
 {
-    d->pass = pass;
-    d->obj = obj;
 }
 
 bool Seat::hasSeatAisle() const
@@ -10,8 +10,6 @@
 
 #include <qobjectdefs.h>
 
-class QJsonObject;
-
 namespace KPkPass
 {
 
@@ -67,10 +65,10 @@ public:
     Q_INVOKABLE [[nodiscard]] QString asAirplaneSeat() const;
 
 private:
-    friend class Pass;
-    explicit Seat(const QJsonObject &obj, const Pass *pass);
+    friend class PassElements;
+    explicit Seat(std::shared_ptr<const SeatPrivate> &&dd);
 
-    std::shared_ptr<SeatPrivate> d;
+    std::shared_ptr<const SeatPrivate> d;
 };
 
 }
@@ -0,0 +1,80 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_SEMANTICPLACE_H
+#define KPKPASS_SEMANTICPLACE_H
+
+#include "kpkpass_export.h"
+
+#include <QMetaType>
+#include <QString>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class SemanticPlacePrivate;
+
+/*!
+ * \brief Departure or arrival location in the semantic tags of a pass.
+ *
+ * \sa SemanticTags
+ * \class KPkPass::SemanticPlace
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/SemanticPlace
+ * \since 26.08
+ */
+class KPKPASS_EXPORT SemanticPlace
+{
+    Q_GADGET
+    Q_PROPERTY(QString airportCode READ airportCode CONSTANT)
+    Q_PROPERTY(QString airportName READ airportName CONSTANT)
+    Q_PROPERTY(QString stationName READ stationName CONSTANT)
+    Q_PROPERTY(QString platform READ platform CONSTANT)
+    Q_PROPERTY(QString gate READ gate CONSTANT)
+    Q_PROPERTY(QString terminal READ terminal CONSTANT)
+    Q_PROPERTY(QString locationDescription READ locationDescription CONSTANT)
+    Q_PROPERTY(bool hasCoordinate READ hasCoordinate CONSTANT)
+    Q_PROPERTY(double latitude READ latitude CONSTANT)
+    Q_PROPERTY(double longitude READ longitude CONSTANT)
+
+public:
+    SemanticPlace();
+    ~SemanticPlace();
+
+    /*! Returns \c true if none of the location properties is set. */
+    [[nodiscard]] bool isEmpty() const;
+
+    /*! IATA airport code. */
+    [[nodiscard]] QString airportCode() const;
+    /*! Airport name. */
+    [[nodiscard]] QString airportName() const;
+    /*! Train or bus station name. */
+    [[nodiscard]] QString stationName() const;
+    /*! Platform. */
+    [[nodiscard]] QString platform() const;
+    /*! Gate. */
+    [[nodiscard]] QString gate() const;
+    /*! Terminal. */
+    [[nodiscard]] QString terminal() const;
+    /*! Free-form description of the location. */
+    [[nodiscard]] QString locationDescription() const;
+    /*! Returns \c true if latitude and longitude are set. */
+    [[nodiscard]] bool hasCoordinate() const;
+    /*! Latitude in degree, NaN if not set. */
+    [[nodiscard]] double latitude() const;
+    /*! Longitude in degree, NaN if not set. */
+    [[nodiscard]] double longitude() const;
+
+private:
+    friend class SemanticTagsPrivate;
+    explicit SemanticPlace(std::shared_ptr<const SemanticPlacePrivate> &&dd);
+    std::shared_ptr<const SemanticPlacePrivate> d;
+};
+
+}
+
+#endif
@@ -0,0 +1,360 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "semantictags.h"
+#include "pass_p.h"
+#include "semantictags_p.h"
+
+#include <QJsonArray>
+#include <QJsonObject>
+
+#include <cmath>
+
+using namespace Qt::Literals;
+using namespace KPkPass;
+
+static QDateTime parseDate(const QJsonValue &value)
+{
+    return value.isString() ? QDateTime::fromString(value.toString(), Qt::ISODate) : QDateTime();
+}
+
+static void parseCoordinate(const QJsonValue &value, double &latitude, double &longitude)
+{
+    const auto obj = value.toObject();
+    latitude = obj.value("latitude"_L1).toDouble(NAN);
+    longitude = obj.value("longitude"_L1).toDouble(NAN);
+}
+
+static QString localizedValue(const PassPrivate *pass, const QJsonValue &value)
+{
+    return value.isString() ? pass->message(value.toString()) : QString();
+}
+
+SemanticPlace SemanticTagsPrivate::parsePlace(const PassPrivate *pass, const QJsonObject &semantics, QLatin1StringView prefix)
+{
+    const auto localized = [pass, &semantics, prefix](QLatin1StringView key) {
+        return localizedValue(pass, semantics.value(QString(prefix) + key));
+    };
+
+    auto place = std::make_shared<SemanticPlacePrivate>();
+    place->airportCode = localized("AirportCode"_L1);
+    place->airportName = localized("AirportName"_L1);
+    place->stationName = localized("StationName"_L1);
+    place->platform = localized("Platform"_L1);
+    place->gate = localized("Gate"_L1);
+    place->terminal = localized("Terminal"_L1);
+    place->locationDescription = localized("LocationDescription"_L1);
+    parseCoordinate(semantics.value(QString(prefix) + "Location"_L1), place->latitude, place->longitude);
+    return SemanticPlace(std::move(place));
+}
+
+SemanticTags SemanticTagsPrivate::create(const PassPrivate *pass, const QJsonObject &semantics, const QList<Seat> &seats)
+{
+    const auto localized = [pass, &semantics](QLatin1StringView key) {
+        return localizedValue(pass, semantics.value(key));
+    };
+
+    auto tags = std::make_shared<SemanticTagsPrivate>();
+    tags->isEmpty = semantics.isEmpty();
+    tags->airlineCode = localized("airlineCode"_L1);
+    tags->flightCode = localized("flightCode"_L1);
+    tags->transitProvider = localized("transitProvider"_L1);
+    tags->vehicleName = localized("vehicleName"_L1);
+    tags->vehicleNumber = localized("vehicleNumber"_L1);
+    tags->vehicleType = localized("vehicleType"_L1);
+    tags->carNumber = localized("carNumber"_L1);
+    tags->boardingGroup = localized("boardingGroup"_L1);
+    tags->boardingSequenceNumber = localized("boardingSequenceNumber"_L1);
+    tags->confirmationNumber = localized("confirmationNumber"_L1);
+    tags->eventName = localized("eventName"_L1);
+    tags->eventType = localized("eventType"_L1);
+    tags->venueName = localized("venueName"_L1);
+    tags->venueEntrance = localized("venueEntrance"_L1);
+    tags->venueRoom = localized("venueRoom"_L1);
+    tags->venuePhoneNumber = localized("venuePhoneNumber"_L1);
+    tags->flightNumber = semantics.value("flightNumber"_L1).toInt();
+    tags->originalDepartureDate = parseDate(semantics.value("originalDepartureDate"_L1));
+    tags->currentDepartureDate = parseDate(semantics.value("currentDepartureDate"_L1));
+    tags->originalArrivalDate = parseDate(semantics.value("originalArrivalDate"_L1));
+    tags->currentArrivalDate = parseDate(semantics.value("currentArrivalDate"_L1));
+    tags->originalBoardingDate = parseDate(semantics.value("originalBoardingDate"_L1));
+    tags->currentBoardingDate = parseDate(semantics.value("currentBoardingDate"_L1));
+    tags->eventStartDate = parseDate(semantics.value("eventStartDate"_L1));
+    tags->eventEndDate = parseDate(semantics.value("eventEndDate"_L1));
+
+    const auto passengerName = semantics.value("passengerName"_L1).toObject();
+    QStringList nameParts;
+    for (const auto key : {"namePrefix"_L1, "givenName"_L1, "middleName"_L1, "familyName"_L1, "nameSuffix"_L1}) {
+        if (const auto part = passengerName.value(key).toString(); !part.isEmpty()) {
+            nameParts.push_back(part);
+        }
+    }
+    tags->passengerName = nameParts.join(u' ');
+
+    const auto performers = semantics.value("performerNames"_L1).toArray();
+    tags->performerNames.reserve(performers.size());
+    for (const auto &performer : performers) {
+        tags->performerNames.push_back(pass->message(performer.toString()));
+    }
+    parseCoordinate(semantics.value("venueLocation"_L1), tags->venueLatitude, tags->venueLongitude);
+
+    tags->departure = parsePlace(pass, semantics, "departure"_L1);
+    tags->destination = parsePlace(pass, semantics, "destination"_L1);
+
+    tags->seats = seats;
+    return SemanticTags(std::move(tags));
+}
+
+static const SemanticPlacePrivate s_emptyPlace;
+
+SemanticPlace::SemanticPlace()
+    : d(std::shared_ptr<const SemanticPlacePrivate>(), &s_emptyPlace)
+{
+}
+
+SemanticPlace::SemanticPlace(std::shared_ptr<const SemanticPlacePrivate> &&dd)
+    : d(std::move(dd))
+{
+}
+
+SemanticPlace::~SemanticPlace() = default;
+
+bool SemanticPlace::isEmpty() const
+{
+    return d->airportCode.isEmpty() && d->airportName.isEmpty() && d->stationName.isEmpty() && d->platform.isEmpty() && d->gate.isEmpty()
+        && d->terminal.isEmpty() && d->locationDescription.isEmpty() && !hasCoordinate();
+}
+
+QString SemanticPlace::airportCode() const
+{
+    return d->airportCode;
+}
+
+QString SemanticPlace::airportName() const
+{
+    return d->airportName;
+}
+
+QString SemanticPlace::stationName() const
+{
+    return d->stationName;
+}
+
+QString SemanticPlace::platform() const
+{
+    return d->platform;
+}
+
+QString SemanticPlace::gate() const
+{
+    return d->gate;
+}
+
+QString SemanticPlace::terminal() const
+{
+    return d->terminal;
+}
+
+QString SemanticPlace::locationDescription() const
+{
+    return d->locationDescription;
+}
+
+bool SemanticPlace::hasCoordinate() const
+{
+    return !std::isnan(d->latitude) && !std::isnan(d->longitude);
+}
+
+double SemanticPlace::latitude() const
+{
+    return d->latitude;
+}
+
+double SemanticPlace::longitude() const
+{
+    return d->longitude;
+}
+
+static const SemanticTagsPrivate s_emptyTags;
+
+SemanticTags::SemanticTags()
+    : d(std::shared_ptr<const SemanticTagsPrivate>(), &s_emptyTags)
+{
+}
+
+SemanticTags::SemanticTags(std::shared_ptr<const SemanticTagsPrivate> &&dd)
+    : d(std::move(dd))
+{
+}
+
+SemanticTags::~SemanticTags() = default;
+
+bool SemanticTags::isEmpty() const
+{
+    return d->isEmpty;
+}
+
+QString SemanticTags::airlineCode() const
+{
+    return d->airlineCode;
+}
+
+QString SemanticTags::flightCode() const
+{
+    return d->flightCode;
+}
+
+int SemanticTags::flightNumber() const
+{
+    return d->flightNumber;
+}
+
+QString SemanticTags::transitProvider() const
+{
+    return d->transitProvider;
+}
+
+QString SemanticTags::vehicleName() const
+{
+    return d->vehicleName;
+}
+
+QString SemanticTags::vehicleNumber() const
+{
+    return d->vehicleNumber;
+}
+
+QString SemanticTags::vehicleType() const
+{
+    return d->vehicleType;
+}
+
+QString SemanticTags::carNumber() const
+{
+    return d->carNumber;
+}
+
+SemanticPlace SemanticTags::departure() const
+{
+    return d->departure;
+}
+
+SemanticPlace SemanticTags::destination() const
+{
+    return d->destination;
+}
+
+QDateTime SemanticTags::originalDepartureDate() const
+{
+    return d->originalDepartureDate;
+}
+
+QDateTime SemanticTags::currentDepartureDate() const
+{
+    return d->currentDepartureDate;
+}
+
+QDateTime SemanticTags::originalArrivalDate() const
+{
+    return d->originalArrivalDate;
+}
+
+QDateTime SemanticTags::currentArrivalDate() const
+{
+    return d->currentArrivalDate;
+}
+
+QDateTime SemanticTags::originalBoardingDate() const
+{
+    return d->originalBoardingDate;
+}
+
+QDateTime SemanticTags::currentBoardingDate() const
+{
+    return d->currentBoardingDate;
+}
+
+QString SemanticTags::boardingGroup() const
+{
+    return d->boardingGroup;
+}
+
+QString SemanticTags::boardingSequenceNumber() const
+{
+    return d->boardingSequenceNumber;
+}
+
+QString SemanticTags::confirmationNumber() const
+{
+    return d->confirmationNumber;
+}
+
+QString SemanticTags::passengerName() const
+{
+    return d->passengerName;
+}
+
+QString SemanticTags::eventName() const
+{
+    return d->eventName;
+}
+
+QString SemanticTags::eventType() const
+{
+    return d->eventType;
+}
+
+QDateTime SemanticTags::eventStartDate() const
+{
+    return d->eventStartDate;
+}
+
+QDateTime SemanticTags::eventEndDate() const
+{
+    return d->eventEndDate;
+}
+
+QStringList SemanticTags::performerNames() const
+{
+    return d->performerNames;
+}
+
+QString SemanticTags::venueName() const
+{
+    return d->venueName;
+}
+
+QString SemanticTags::venueEntrance() const
+{
+    return d->venueEntrance;
+}
+
+QString SemanticTags::venueRoom() const
+{
+    return d->venueRoom;
+}
+
+QString SemanticTags::venuePhoneNumber() const
+{
+    return d->venuePhoneNumber;
+}
+
+double SemanticTags::venueLatitude() const
+{
+    return d->venueLatitude;
+}
+
+double SemanticTags::venueLongitude() const
+{
+    return d->venueLongitude;
+}
+
+QList<Seat> SemanticTags::seats() const
+{
+    return d->seats;
+}
+
+#include "moc_semanticplace.cpp"
+#include "moc_semantictags.cpp"
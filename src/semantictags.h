@@ -0,0 +1,165 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_SEMANTICTAGS_H
+#define KPKPASS_SEMANTICTAGS_H
+
+#include "kpkpass_export.h"
+#include "seat.h"
+#include "semanticplace.h"
+
+#include <QDateTime>
+#include <QList>
+#include <QStringList>
+
+#include <memory>
+
+namespace KPkPass
+{
+
+class SemanticTagsPrivate;
+
+/*!
+ * \brief Typed access to the semantic tags of a pass.
+ *
+ * This is parsed once per pass and language, with localized values
+ * already resolved, so repeated access is cheap. Copies share the same data.
+ *
+ * \sa Pass::semantics(), https://developer.apple.com/documentation/walletpasses/semantictags
+ * \class KPkPass::SemanticTags
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/SemanticTags
+ * \since 26.08
+ */
+class KPKPASS_EXPORT SemanticTags
+{
+    Q_GADGET
+    Q_PROPERTY(bool isEmpty READ isEmpty CONSTANT)
+    Q_PROPERTY(QString airlineCode READ airlineCode CONSTANT)
+    Q_PROPERTY(QString flightCode READ flightCode CONSTANT)
+    Q_PROPERTY(int flightNumber READ flightNumber CONSTANT)
+    Q_PROPERTY(QString transitProvider READ transitProvider CONSTANT)
+    Q_PROPERTY(QString vehicleName READ vehicleName CONSTANT)
+    Q_PROPERTY(QString vehicleNumber READ vehicleNumber CONSTANT)
+    Q_PROPERTY(QString vehicleType READ vehicleType CONSTANT)
+    Q_PROPERTY(QString carNumber READ carNumber CONSTANT)
+    Q_PROPERTY(KPkPass::SemanticPlace departure READ departure CONSTANT)
+    Q_PROPERTY(KPkPass::SemanticPlace destination READ destination CONSTANT)
+    Q_PROPERTY(QDateTime originalDepartureDate READ originalDepartureDate CONSTANT)
+    Q_PROPERTY(QDateTime currentDepartureDate READ currentDepartureDate CONSTANT)
+    Q_PROPERTY(QDateTime originalArrivalDate READ originalArrivalDate CONSTANT)
+    Q_PROPERTY(QDateTime currentArrivalDate READ currentArrivalDate CONSTANT)
+    Q_PROPERTY(QDateTime originalBoardingDate READ originalBoardingDate CONSTANT)
+    Q_PROPERTY(QDateTime currentBoardingDate READ currentBoardingDate CONSTANT)
+    Q_PROPERTY(QString boardingGroup READ boardingGroup CONSTANT)
+    Q_PROPERTY(QString boardingSequenceNumber READ boardingSequenceNumber CONSTANT)
+    Q_PROPERTY(QString confirmationNumber READ confirmationNumber CONSTANT)
+    Q_PROPERTY(QString passengerName READ passengerName CONSTANT)
+    Q_PROPERTY(QString eventName READ eventName CONSTANT)
+    Q_PROPERTY(QString eventType READ eventType CONSTANT)
+    Q_PROPERTY(QDateTime eventStartDate READ eventStartDate CONSTANT)
+    Q_PROPERTY(QDateTime eventEndDate READ eventEndDate CONSTANT)
+    Q_PROPERTY(QStringList performerNames READ performerNames CONSTANT)
+    Q_PROPERTY(QString venueName READ venueName CONSTANT)
+    Q_PROPERTY(QString venueEntrance READ venueEntrance CONSTANT)
+    Q_PROPERTY(QString venueRoom READ venueRoom CONSTANT)
+    Q_PROPERTY(QString venuePhoneNumber READ venuePhoneNumber CONSTANT)
+    Q_PROPERTY(double venueLatitude READ venueLatitude CONSTANT)
+    Q_PROPERTY(double venueLongitude READ venueLongitude CONSTANT)
+    Q_PROPERTY(QList<KPkPass::Seat> seats READ seats CONSTANT)
+
+public:
+    SemanticTags();
+    ~SemanticTags();
+
+    /*! Returns \c true if the pass has no semantic tags. */
+    [[nodiscard]] bool isEmpty() const;
+
+    // flights
+    /*! IATA airline code. */
+    [[nodiscard]] QString airlineCode() const;
+    /*! Flight code, consisting of the airline code and the flight number. */
+    [[nodiscard]] QString flightCode() const;
+    /*! Flight number, \c 0 if not set. */
+    [[nodiscard]] int flightNumber() const;
+
+    // trains and other transit
+    /*! Name of the transit company. */
+    [[nodiscard]] QString transitProvider() const;
+    /*! Name of the vehicle, e.g. the train name. */
+    [[nodiscard]] QString vehicleName() const;
+    /*! Vehicle number, e.g. the train number. */
+    [[nodiscard]] QString vehicleNumber() const;
+    /*! Type of the vehicle. */
+    [[nodiscard]] QString vehicleType() const;
+    /*! Car number of a train. */
+    [[nodiscard]] QString carNumber() const;
+
+    // departure and arrival
+    /*! Departure airport or station. */
+    [[nodiscard]] SemanticPlace departure() const;
+    /*! Arrival airport or station. */
+    [[nodiscard]] SemanticPlace destination() const;
+    /*! Originally scheduled departure time. */
+    [[nodiscard]] QDateTime originalDepartureDate() const;
+    /*! Updated departure time, if different from the original one. */
+    [[nodiscard]] QDateTime currentDepartureDate() const;
+    /*! Originally scheduled arrival time. */
+    [[nodiscard]] QDateTime originalArrivalDate() const;
+    /*! Updated arrival time, if different from the original one. */
+    [[nodiscard]] QDateTime currentArrivalDate() const;
+    /*! Originally scheduled boarding time. */
+    [[nodiscard]] QDateTime originalBoardingDate() const;
+    /*! Updated boarding time, if different from the original one. */
+    [[nodiscard]] QDateTime currentBoardingDate() const;
+
+    // booking
+    /*! Boarding group or zone. */
+    [[nodiscard]] QString boardingGroup() const;
+    /*! Boarding sequence number. */
+    [[nodiscard]] QString boardingSequenceNumber() const;
+    /*! Booking or confirmation number. */
+    [[nodiscard]] QString confirmationNumber() const;
+    /*! Passenger name, formatted from its name components. */
+    [[nodiscard]] QString passengerName() const;
+
+    // events
+    /*! Name of the event. */
+    [[nodiscard]] QString eventName() const;
+    /*! Type of the event, e.g. \c PKEventTypeSports. */
+    [[nodiscard]] QString eventType() const;
+    /*! Start time of the event. */
+    [[nodiscard]] QDateTime eventStartDate() const;
+    /*! End time of the event. */
+    [[nodiscard]] QDateTime eventEndDate() const;
+    /*! Names of the performers at the event. */
+    [[nodiscard]] QStringList performerNames() const;
+
+    // venue
+    /*! Name of the venue. */
+    [[nodiscard]] QString venueName() const;
+    /*! Entrance to use at the venue. */
+    [[nodiscard]] QString venueEntrance() const;
+    /*! Room at the venue. */
+    [[nodiscard]] QString venueRoom() const;
+    /*! Phone number of the venue. */
+    [[nodiscard]] QString venuePhoneNumber() const;
+    /*! Latitude of the venue in degree, NaN if not set. */
+    [[nodiscard]] double venueLatitude() const;
+    /*! Longitude of the venue in degree, NaN if not set. */
+    [[nodiscard]] double venueLongitude() const;
+
+    /*! Seat information, same as Pass::seats(). */
+    [[nodiscard]] QList<Seat> seats() const;
+
+private:
+    friend class SemanticTagsPrivate;
+    explicit SemanticTags(std::shared_ptr<const SemanticTagsPrivate> &&dd);
+    std::shared_ptr<const SemanticTagsPrivate> d;
+};
+
+}
+
+#endif
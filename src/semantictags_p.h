@@ -0,0 +1,78 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_SEMANTICTAGS_P_H
+#define KPKPASS_SEMANTICTAGS_P_H
+
+#include "semantictags.h"
+
+#include <cmath>
+#include <memory>
+
+class QJsonObject;
+
+namespace KPkPass
+{
+
+class PassPrivate;
+
+class SemanticPlacePrivate
+{
+public:
+    QString airportCode;
+    QString airportName;
+    QString stationName;
+    QString platform;
+    QString gate;
+    QString terminal;
+    QString locationDescription;
+    double latitude = NAN;
+    double longitude = NAN;
+};
+
+class SemanticTagsPrivate
+{
+public:
+    /** Parses the semantic tags in @p semantics, resolving localized values via @p pass. */
+    [[nodiscard]] static SemanticTags create(const PassPrivate *pass, const QJsonObject &semantics, const QList<Seat> &seats);
+    [[nodiscard]] static SemanticPlace parsePlace(const PassPrivate *pass, const QJsonObject &semantics, QLatin1StringView prefix);
+
+    QString airlineCode;
+    QString flightCode;
+    QString transitProvider;
+    QString vehicleName;
+    QString vehicleNumber;
+    QString vehicleType;
+    QString carNumber;
+    QString boardingGroup;
+    QString boardingSequenceNumber;
+    QString confirmationNumber;
+    QString passengerName;
+    QString eventName;
+    QString eventType;
+    QString venueName;
+    QString venueEntrance;
+    QString venueRoom;
+    QString venuePhoneNumber;
+    QDateTime originalDepartureDate;
+    QDateTime currentDepartureDate;
+    QDateTime originalArrivalDate;
+    QDateTime currentArrivalDate;
+    QDateTime originalBoardingDate;
+    QDateTime currentBoardingDate;
+    QDateTime eventStartDate;
+    QDateTime eventEndDate;
+    QStringList performerNames;
+    QList<Seat> seats;
+    SemanticPlace departure;
+    SemanticPlace destination;
+    double venueLatitude = NAN;
+    double venueLongitude = NAN;
+    int flightNumber = 0;
+    bool isEmpty = true;
+};
+}
+
+#endif
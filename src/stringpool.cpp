@@ -0,0 +1,121 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "stringpool_p.h"
+
+#include <QHashFunctions>
+#include <QMutex>
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace KPkPass;
+
+namespace
+{
+// transparent hashing so lookups with a QStringView don't need to allocate
+struct StringHash {
+    using is_transparent = void;
+    std::size_t operator()(QStringView str) const noexcept
+    {
+        return qHash(str);
+    }
+};
+
+struct StringEqual {
+    using is_transparent = void;
+    bool operator()(QStringView lhs, QStringView rhs) const noexcept
+    {
+        return lhs == rhs;
+    }
+};
+
+// never purge smaller pools automatically, that would mostly be wasted effort
+constexpr std::size_t MinimumPurgeThreshold = 4096;
+
+struct Pool {
+    /** Removes unreferenced strings, the caller needs to hold mutex. */
+    void purge();
+    /** Adds @p str, purging first if the pool has grown enough. The caller needs to hold mutex. */
+    QString insert(QString &&str);
+
+    QMutex mutex;
+    std::unordered_set<QString, StringHash, StringEqual> strings;
+    qsizetype dataSize = 0;
+    std::size_t purgeThreshold = MinimumPurgeThreshold;
+};
+}
+
+void Pool::purge()
+{
+    for (auto it = strings.begin(); it != strings.end();) {
+        // only referenced by us
+        if ((*it).isDetached()) {
+            dataSize -= (*it).size() * sizeof(QChar);
+            it = strings.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    purgeThreshold = std::max(MinimumPurgeThreshold, 2 * strings.size());
+}
+
+QString Pool::insert(QString &&str)
+{
+    if (strings.size() >= purgeThreshold) {
+        purge();
+    }
+    dataSize += str.size() * sizeof(QChar);
+    return *strings.insert(std::move(str)).first;
+}
+
+Q_GLOBAL_STATIC(Pool, s_pool)
+
+QString StringPool::intern(QStringView str)
+{
+    if (str.isEmpty()) {
+        return {};
+    }
+
+    QMutexLocker locker(&s_pool->mutex);
+    const auto it = s_pool->strings.find(str);
+    if (it != s_pool->strings.end()) {
+        return *it;
+    }
+    return s_pool->insert(str.toString());
+}
+
+QString StringPool::intern(const QString &str)
+{
+    if (str.isEmpty()) {
+        return {};
+    }
+
+    QMutexLocker locker(&s_pool->mutex);
+    const auto it = s_pool->strings.find(QStringView(str));
+    if (it != s_pool->strings.end()) {
+        return *it;
+    }
+    // don't hold on to spare capacity or to raw data we don't own
+    return s_pool->insert(str.capacity() != str.size() ? QString(str.constData(), str.size()) : QString(str));
+}
+
+qsizetype StringPool::size()
+{
+    QMutexLocker locker(&s_pool->mutex);
+    return (qsizetype)s_pool->strings.size();
+}
+
+qsizetype StringPool::dataSize()
+{
+    QMutexLocker locker(&s_pool->mutex);
+    return s_pool->dataSize;
+}
+
+void StringPool::purge()
+{
+    QMutexLocker locker(&s_pool->mutex);
+    s_pool->purge();
+}
@@ -0,0 +1,51 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_STRINGPOOL_P_H
+#define KPKPASS_STRINGPOOL_P_H
+
+#include "kpkpass_export.h"
+
+#include <QString>
+
+namespace KPkPass
+{
+
+/** Process-wide interning table for strings that are very likely to be
+ *  repeated across many passes, such as translation catalog content,
+ *  field keys or pass type identifiers.
+ *
+ *  Interned strings share their data with all other interned copies of
+ *  the same content. All methods are thread-safe.
+ *
+ *  Strings no longer referenced outside of the pool are evicted automatically
+ *  once the pool has doubled in size since the last purge, so the pool
+ *  doesn't keep growing with the content of passes that have long been destroyed.
+ *
+ *  @internal only exported for unit tests
+ */
+class KPKPASS_EXPORT StringPool
+{
+public:
+    /** Returns the shared instance of @p str, adding it if necessary. */
+    [[nodiscard]] static QString intern(QStringView str);
+    /** Same as the above, but can adopt @p str if it isn't in the pool yet. */
+    [[nodiscard]] static QString intern(const QString &str);
+
+    /** Number of strings currently in the pool. */
+    [[nodiscard]] static qsizetype size();
+    /** Total size of the string data in the pool, in bytes. */
+    [[nodiscard]] static qsizetype dataSize();
+
+    /** Removes all strings no longer referenced outside of the pool.
+     *  This happens automatically as the pool grows, calling this explicitly is only
+     *  needed for releasing memory immediately.
+     */
+    static void purge();
+};
+
+}
+
+#endif
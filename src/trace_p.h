@@ -0,0 +1,80 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_TRACE_P_H
+#define KPKPASS_TRACE_P_H
+
+// Trace point macros, these expand to nothing unless built with KPKPASS_TRACING.
+//
+// KPKPASS_TRACE_SCOPE(name, event, pass) measures the remainder of the enclosing scope,
+// KPKPASS_TRACE_SIZE(name, size) sets the size reported for that, and
+// KPKPASS_TRACE_INSTANT(event, pass, size) reports an event without duration.
+
+#ifdef KPKPASS_TRACING
+
+#include "tracer.h"
+
+#include <QElapsedTimer>
+
+namespace KPkPass
+{
+/** Reports the duration of its lifetime to the installed tracer, if any. */
+class TraceScope
+{
+public:
+    explicit TraceScope(Tracer::Event event, const void *pass)
+        : m_tracer(Tracer::installed())
+        , m_pass(reinterpret_cast<quintptr>(pass))
+        , m_event(event)
+    {
+        if (m_tracer) {
+            m_timer.start();
+        }
+    }
+    ~TraceScope()
+    {
+        if (m_tracer) {
+            m_tracer->trace(m_event, m_pass, m_size, m_timer.nsecsElapsed());
+        }
+    }
+    void setSize(qint64 size)
+    {
+        m_size = size;
+    }
+
+    static void instant(Tracer::Event event, const void *pass, qint64 size)
+    {
+        if (const auto tracer = Tracer::installed()) {
+            tracer->trace(event, reinterpret_cast<quintptr>(pass), size, 0);
+        }
+    }
+
+private:
+    Q_DISABLE_COPY_MOVE(TraceScope)
+    Tracer *m_tracer;
+    quintptr m_pass;
+    qint64 m_size = -1;
+    QElapsedTimer m_timer;
+    Tracer::Event m_event;
+};
+}
+
+#define KPKPASS_TRACE_SCOPE(name, event, pass) KPkPass::TraceScope name(KPkPass::Tracer::event, pass)
+#define KPKPASS_TRACE_SIZE(name, size) name.setSize(size)
+#define KPKPASS_TRACE_INSTANT(event, pass, size) KPkPass::TraceScope::instant(KPkPass::Tracer::event, pass, size)
+
+#else
+
+#define KPKPASS_TRACE_SCOPE(name, event, pass)
+#define KPKPASS_TRACE_SIZE(name, size)                                                                                                                         \
+    do {                                                                                                                                                       \
+    } while (false)
+#define KPKPASS_TRACE_INSTANT(event, pass, size)                                                                                                               \
+    do {                                                                                                                                                       \
+    } while (false)
+
+#endif
+
+#endif
@@ -0,0 +1,34 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "tracer.h"
+
+#include <atomic>
+
+using namespace KPkPass;
+
+static std::atomic<Tracer *> s_tracer = nullptr;
+
+Tracer::Tracer() = default;
+Tracer::~Tracer() = default;
+
+void Tracer::install(Tracer *tracer)
+{
+    s_tracer.store(tracer, std::memory_order_release);
+}
+
+Tracer *Tracer::installed()
+{
+    return s_tracer.load(std::memory_order_acquire);
+}
+
+bool Tracer::isAvailable()
+{
+#ifdef KPKPASS_TRACING
+    return true;
+#else
+    return false;
+#endif
+}
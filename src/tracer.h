@@ -0,0 +1,89 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_TRACER_H
+#define KPKPASS_TRACER_H
+
+#include "kpkpass_export.h"
+
+#include <QtGlobal>
+
+namespace KPkPass
+{
+
+/*!
+ * \brief Receiver for trace points in the pass loading pipeline.
+ *
+ * Trace points are only compiled in when the library is built with the
+ * \c KPKPASS_TRACING CMake option, otherwise they cost nothing and an
+ * installed tracer never receives any events. isAvailable() tells which
+ * case applies.
+ *
+ * Events are reported from whichever thread performs the traced operation,
+ * implementations of trace() therefore need to be thread-safe. A typical
+ * implementation forwards events to LTTng, Perfetto or a similar system-wide
+ * tracing facility.
+ *
+ * \class KPkPass::Tracer
+ * \inmodule KPkPass
+ * \inheaderfile KPkPass/Tracer
+ * \since 26.08
+ */
+class KPKPASS_EXPORT Tracer
+{
+public:
+    /*!
+     * \value PassLoad Loading a pass from a file or from data, including all steps below. The size is that of the archive.
+     * \value ArchiveOpen Opening the ZIP archive and reading its directory. The size is that of the archive.
+     * \value PassJsonExtract Decompressing pass.json. The size is the decompressed size.
+     * \value JsonParse Parsing pass.json. The size is that of the JSON data.
+     * \value JsonRepair Parsing pass.json again after applying syntax error workarounds. The size is that of the JSON data.
+     * \value CatalogLookup Selecting the translation catalog for the current language. The size is the number of messages in the selected catalog.
+     * \value CatalogParse Reading and parsing a translation catalog. The size is that of the raw catalog data.
+     * \value ImageDecode Reading and decoding an image asset. The size is that of the encoded image data.
+     * \value ImageCacheHit An image asset was served from the image cache. The size is that of the decoded image.
+     * \value CacheLoad Restoring a pass from a cache file written by Pass::writeCache(). The size is that of the cache file.
+     */
+    enum Event {
+        PassLoad,
+        ArchiveOpen,
+        PassJsonExtract,
+        JsonParse,
+        JsonRepair,
+        CatalogLookup,
+        CatalogParse,
+        ImageDecode,
+        ImageCacheHit,
+        CacheLoad,
+    };
+
+    Tracer();
+    virtual ~Tracer();
+
+    /*! Called after a traced operation \a event finished.
+     *  \a pass is an opaque identifier of the pass the operation belongs to,
+     *  identical for all events of the same pass during its lifetime.
+     *  \a size is described for each Event, \a duration is in nanoseconds
+     *  and \c 0 for events that mark a point in time.
+     */
+    virtual void trace(Event event, quintptr pass, qint64 size, qint64 duration) = 0;
+
+    /*! Installs \a tracer, replacing any previously installed one.
+     *  Pass \c nullptr to remove the current tracer. The tracer is not owned,
+     *  and has to outlive all operations that might report to it.
+     */
+    static void install(Tracer *tracer);
+    /*! The currently installed tracer, if any. */
+    [[nodiscard]] static Tracer *installed();
+    /*! Returns \c true if the library was built with trace points. */
+    [[nodiscard]] static bool isAvailable();
+
+private:
+    Q_DISABLE_COPY_MOVE(Tracer)
+};
+
+}
+
+#endif
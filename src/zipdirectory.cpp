@@ -0,0 +1,220 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "zipdirectory_p.h"
+
+#include <QIODevice>
+#include <QtEndian>
+
+#include <zlib.h>
+
+#include <algorithm>
+
+using namespace KPkPass;
+
+enum {
+    EndOfCentralDirectorySize = 22,
+    CentralDirectoryHeaderSize = 46,
+    MaximumCentralDirectorySize = 4 * 1024 * 1024,
+};
+
+template<typename T>
+static T readLittleEndian(const QByteArray &data, qsizetype offset)
+{
+    return qFromLittleEndian<T>(data.constData() + offset);
+}
+
+std::optional<ZipDirectory::EndOfCentralDirectory> ZipDirectory::findEndOfCentralDirectory(QIODevice *device)
+{
+    const auto size = device->size();
+    // the record is followed by a comment of up to 64k
+    const auto tailSize = std::min<qint64>(size, EndOfCentralDirectorySize + 0xffff);
+    if (tailSize < EndOfCentralDirectorySize || !device->seek(size - tailSize)) {
+        return {};
+    }
+    const auto tail = device->read(tailSize);
+    const auto idx = tail.lastIndexOf("PK\x05\x06");
+    if (idx < 0 || idx + EndOfCentralDirectorySize > tail.size()) {
+        return {};
+    }
+
+    EndOfCentralDirectory eocd;
+    eocd.entryCount = readLittleEndian<quint16>(tail, idx + 10);
+    eocd.size = readLittleEndian<quint32>(tail, idx + 12);
+    eocd.offset = readLittleEndian<quint32>(tail, idx + 16);
+    if (eocd.entryCount == 0xffff || eocd.offset == 0xffffffff || eocd.offset + eocd.size > size) {
+        return {}; // ZIP64 or broken
+    }
+    return eocd;
+}
+
+// calls @p func for each central directory record with the record offset and the name, until it returns false
+template<typename Func>
+static bool forEachRecord(QIODevice *device, const ZipDirectory::EndOfCentralDirectory &eocd, QByteArray &dir, Func func)
+{
+    if (eocd.size > MaximumCentralDirectorySize || !device->seek(eocd.offset)) {
+        return false;
+    }
+    dir = device->read(eocd.size);
+
+    qsizetype idx = 0;
+    for (qint64 i = 0; i < eocd.entryCount; ++i) {
+        if (idx + CentralDirectoryHeaderSize > dir.size() || readLittleEndian<quint32>(dir, idx) != 0x02014b50) {
+            return false;
+        }
+        const auto nameLength = readLittleEndian<quint16>(dir, idx + 28);
+        const auto extraLength = readLittleEndian<quint16>(dir, idx + 30);
+        const auto commentLength = readLittleEndian<quint16>(dir, idx + 32);
+        if (idx + CentralDirectoryHeaderSize + nameLength > dir.size()) {
+            return false;
+        }
+        if (!func(idx, QByteArrayView(dir.constData() + idx + CentralDirectoryHeaderSize, nameLength))) {
+            return true;
+        }
+        idx += CentralDirectoryHeaderSize + nameLength + extraLength + commentLength;
+    }
+    return true;
+}
+
+static ZipDirectory::Entry makeEntry(const QByteArray &dir, qsizetype idx, QByteArrayView name)
+{
+    ZipDirectory::Entry entry;
+    entry.name = name.toByteArray();
+    entry.flags = readLittleEndian<quint16>(dir, idx + 8);
+    entry.compressionMethod = readLittleEndian<quint16>(dir, idx + 10);
+    entry.crc32 = readLittleEndian<quint32>(dir, idx + 16);
+    entry.compressedSize = readLittleEndian<quint32>(dir, idx + 20);
+    entry.size = readLittleEndian<quint32>(dir, idx + 24);
+    entry.localHeaderOffset = readLittleEndian<quint32>(dir, idx + 42);
+    return entry;
+}
+
+std::optional<ZipDirectory::Entry> ZipDirectory::findEntry(QIODevice *device, const EndOfCentralDirectory &eocd, QByteArrayView name)
+{
+    QByteArray dir;
+    std::optional<Entry> result;
+    forEachRecord(device, eocd, dir, [&](qsizetype idx, QByteArrayView entryName) {
+        if (entryName != name) {
+            return true;
+        }
+        result = makeEntry(dir, idx, entryName);
+        return false;
+    });
+    return result;
+}
+
+std::vector<ZipDirectory::Entry> ZipDirectory::entries(QIODevice *device, const EndOfCentralDirectory &eocd)
+{
+    QByteArray dir;
+    std::vector<Entry> result;
+    result.reserve(eocd.entryCount);
+    const auto valid = forEachRecord(device, eocd, dir, [&](qsizetype idx, QByteArrayView name) {
+        result.push_back(makeEntry(dir, idx, name));
+        return true;
+    });
+    if (!valid) {
+        result.clear();
+    }
+    return result;
+}
+
+qint64 ZipDirectory::dataOffset(QByteArrayView header, const Entry &entry)
+{
+    if (header.size() < LocalFileHeaderSize || qFromLittleEndian<quint32>(header.data()) != 0x04034b50) {
+        return -1;
+    }
+    // name and extra field length can differ from the central directory
+    return entry.localHeaderOffset + LocalFileHeaderSize + qFromLittleEndian<quint16>(header.data() + 26) + qFromLittleEndian<quint16>(header.data() + 28);
+}
+
+bool ZipDirectory::hasPlausibleSize(const Entry &entry)
+{
+    // in either direction, as stored or incompressible data also only grows by a small margin
+    return entry.size <= std::max<qint64>(entry.compressedSize, 1) * MaximumDeflateRatio && entry.compressedSize <= entry.size + entry.size / 1000 + 64;
+}
+
+bool ZipDirectory::verifyChecksum(const Entry &entry, QByteArrayView data)
+{
+    return ::crc32(0, reinterpret_cast<const Bytef *>(data.data()), static_cast<uInt>(data.size())) == entry.crc32;
+}
+
+static qint64 readDataOffset(QIODevice *device, const ZipDirectory::Entry &entry)
+{
+    if (!device->seek(entry.localHeaderOffset)) {
+        return -1;
+    }
+    return ZipDirectory::dataOffset(device->read(ZipDirectory::LocalFileHeaderSize), entry);
+}
+
+static bool readStored(QIODevice *device, qint64 size, const std::function<bool(QByteArrayView)> &consumer)
+{
+    char chunk[16384];
+    while (size > 0) {
+        const auto n = device->read(chunk, std::min<qint64>(size, sizeof(chunk)));
+        if (n <= 0) {
+            return false;
+        }
+        if (!consumer(QByteArrayView(chunk, n))) {
+            return true;
+        }
+        size -= n;
+    }
+    return true;
+}
+
+static bool readDeflated(QIODevice *device, qint64 size, const std::function<bool(QByteArrayView)> &consumer)
+{
+    z_stream stream = {};
+    if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) { // raw deflate data, without zlib header
+        return false;
+    }
+
+    char in[16384];
+    char out[16384];
+    bool success = false;
+    bool needMore = true;
+    while (needMore && size > 0) {
+        const auto n = device->read(in, std::min<qint64>(size, sizeof(in)));
+        if (n <= 0) {
+            break;
+        }
+        size -= n;
+        stream.next_in = reinterpret_cast<Bytef *>(in);
+        stream.avail_in = static_cast<uInt>(n);
+        while (needMore && stream.avail_in > 0) {
+            stream.next_out = reinterpret_cast<Bytef *>(out);
+            stream.avail_out = sizeof(out);
+            const auto res = inflate(&stream, Z_NO_FLUSH);
+            if (res != Z_OK && res != Z_STREAM_END) {
+                needMore = false;
+                break;
+            }
+            if (!consumer(QByteArrayView(out, sizeof(out) - stream.avail_out))) {
+                success = true;
+                needMore = false;
+            } else if (res == Z_STREAM_END) {
+                success = true;
+                needMore = false;
+            }
+        }
+    }
+    inflateEnd(&stream);
+    return success;
+}
+
+bool ZipDirectory::readData(QIODevice *device, const Entry &entry, const std::function<bool(QByteArrayView)> &consumer)
+{
+    const auto offset = readDataOffset(device, entry);
+    if (offset < 0 || !device->seek(offset)) {
+        return false;
+    }
+    switch (entry.compressionMethod) {
+    case Stored:
+        return readStored(device, entry.compressedSize, consumer);
+    case Deflated:
+        return readDeflated(device, entry.compressedSize, consumer);
+    }
+    return false;
+}
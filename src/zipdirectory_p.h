@@ -0,0 +1,89 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#ifndef KPKPASS_ZIPDIRECTORY_P_H
+#define KPKPASS_ZIPDIRECTORY_P_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+#include <functional>
+#include <optional>
+#include <vector>
+
+class QIODevice;
+
+namespace KPkPass
+{
+
+/** Minimal access to the ZIP central directory, for the cases where
+ *  we only need to look at the archive structure or a single entry
+ *  and parsing the full archive with KZip would be too expensive.
+ *  ZIP64 archives are not supported.
+ */
+namespace ZipDirectory
+{
+
+struct EndOfCentralDirectory {
+    qint64 offset = 0;
+    qint64 size = 0;
+    qint64 entryCount = 0;
+};
+
+/** Locates and reads the end of central directory record. */
+[[nodiscard]] std::optional<EndOfCentralDirectory> findEndOfCentralDirectory(QIODevice *device);
+
+struct Entry {
+    QByteArray name;
+    quint16 flags = 0;
+    quint16 compressionMethod = 0;
+    quint32 crc32 = 0;
+    qint64 compressedSize = 0;
+    qint64 size = 0;
+    qint64 localHeaderOffset = 0;
+};
+
+enum CompressionMethod : quint16 {
+    Stored = 0,
+    Deflated = 8,
+};
+
+enum Flag : quint16 {
+    Encrypted = 0x0001,
+};
+
+/** Size of the fixed part of a local file header. */
+constexpr qint64 LocalFileHeaderSize = 30;
+/** Maximum compression ratio deflate can achieve, larger declared sizes are bogus. */
+constexpr qint64 MaximumDeflateRatio = 1032;
+
+/** Offset of the data of @p entry in the archive, based on its local header in @p header.
+ *  @p header needs to contain at least the fixed-size part of the local header.
+ *  @return @c -1 if @p header isn't a valid local header.
+ */
+[[nodiscard]] qint64 dataOffset(QByteArrayView header, const Entry &entry);
+
+/** Checks whether the declared sizes of @p entry are something deflate can actually produce.
+ *  The declared size determines what we allocate, so anything else has to be rejected before reading.
+ */
+[[nodiscard]] bool hasPlausibleSize(const Entry &entry);
+/** Checks @p data against the CRC-32 of @p entry. */
+[[nodiscard]] bool verifyChecksum(const Entry &entry, QByteArrayView data);
+
+/** Finds the entry @p name in the central directory. */
+[[nodiscard]] std::optional<Entry> findEntry(QIODevice *device, const EndOfCentralDirectory &eocd, QByteArrayView name);
+/** All entries in the central directory, empty on error. */
+[[nodiscard]] std::vector<Entry> entries(QIODevice *device, const EndOfCentralDirectory &eocd);
+
+/** Decompresses the data of @p entry in chunks, passing them to @p consumer.
+ *  Reading stops early when @p consumer returns @c false.
+ *  @return @c false on read or decompression errors.
+ */
+bool readData(QIODevice *device, const Entry &entry, const std::function<bool(QByteArrayView)> &consumer);
+
+}
+}
+
+#endif
@@ -0,0 +1,146 @@
+/*
+   SPDX-FileCopyrightText: 2026 Volker Krause <vkrause@kde.org>
+   SPDX-License-Identifier: LGPL-2.0-or-later
+*/
+
+#include "archivereader_p.h"
+#include "logging.h"
+
+#include <QBuffer>
+#include <QIODevice>
+
+#include <zlib.h>
+
+#include <algorithm>
+
+using namespace KPkPass;
+
+bool ZipReader::open(QIODevice *device)
+{
+    const auto eocd = ZipDirectory::findEndOfCentralDirectory(device);
+    if (!eocd) {
+        return false;
+    }
+    m_entries = ZipDirectory::entries(device, *eocd);
+    if (m_entries.empty() && eocd->entryCount > 0) {
+        return false;
+    }
+    m_entryCount = eocd->entryCount;
+
+    // in-memory archives are inflated from without copying, otherwise we only read the entries we need
+    m_device = device;
+    if (const auto buffer = qobject_cast<QBuffer *>(device)) {
+        m_data = buffer->data();
+    }
+
+    m_files.reserve(m_entries.size());
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if ((*it).name.endsWith('/')) {
+            it = m_entries.erase(it);
+            continue;
+        }
+        m_files.push_back({QString::fromUtf8((*it).name), (*it).size});
+        ++it;
+    }
+    return true;
+}
+
+qsizetype ZipReader::entryCount() const
+{
+    return m_entryCount;
+}
+
+std::optional<QByteArrayView> ZipReader::compressedData(const ZipDirectory::Entry &entry, QByteArray &storage) const
+{
+    const auto archiveSize = m_device->size();
+    if (entry.localHeaderOffset + ZipDirectory::LocalFileHeaderSize > archiveSize) {
+        return {};
+    }
+    if (!m_data.isNull()) {
+        const auto offset = ZipDirectory::dataOffset(QByteArrayView(m_data).mid(entry.localHeaderOffset), entry);
+        if (offset < 0 || offset + entry.compressedSize > m_data.size()) {
+            return {};
+        }
+        return QByteArrayView(m_data).mid(offset, entry.compressedSize);
+    }
+
+    if (!m_device->seek(entry.localHeaderOffset)) {
+        return {};
+    }
+    const auto offset = ZipDirectory::dataOffset(m_device->read(ZipDirectory::LocalFileHeaderSize), entry);
+    if (offset < 0 || offset + entry.compressedSize > archiveSize || !m_device->seek(offset)) {
+        return {};
+    }
+    storage = m_device->read(entry.compressedSize);
+    if (storage.size() != entry.compressedSize) {
+        return {};
+    }
+    return QByteArrayView(storage);
+}
+
+LoadOptions::Error ZipReader::read(qsizetype index, QByteArray &data, qint64 maximumSize)
+{
+    data.clear();
+    const auto &entry = m_entries[index];
+    // unlike with streaming decompression we never inflate more than the declared size,
+    // so checking that against the limit is sufficient here
+    if (maximumSize >= 0 && entry.size > maximumSize) {
+        return LoadOptions::ResourceLimitExceeded;
+    }
+    // the declared sizes determine what we allocate, also for the compressed data of files
+    if (!ZipDirectory::hasPlausibleSize(entry)) {
+        qCWarning(Log) << "Implausible size of archive entry" << entry.name << entry.size << entry.compressedSize;
+        return LoadOptions::InvalidArchive;
+    }
+    if (entry.flags & ZipDirectory::Encrypted) {
+        return LoadOptions::InvalidArchive;
+    }
+    QByteArray storage;
+    const auto compressed = compressedData(entry, storage);
+    if (!compressed) {
+        return LoadOptions::InvalidArchive;
+    }
+
+    switch (entry.compressionMethod) {
+    case ZipDirectory::Stored:
+        if (entry.compressedSize != entry.size) {
+            return LoadOptions::InvalidArchive;
+        }
+        data = compressed->toByteArray();
+        break;
+    case ZipDirectory::Deflated: {
+        if (entry.size == 0) {
+            break;
+        }
+        data.resize(entry.size);
+        z_stream stream = {};
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) { // raw deflate data, without zlib header
+            data.clear();
+            return LoadOptions::InvalidArchive;
+        }
+        stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed->data()));
+        stream.avail_in = static_cast<uInt>(compressed->size());
+        stream.next_out = reinterpret_cast<Bytef *>(data.data());
+        stream.avail_out = static_cast<uInt>(data.size());
+        const auto res = inflate(&stream, Z_FINISH);
+        inflateEnd(&stream);
+        // anything but exactly the declared size is an error, as the declared size is what the limits were checked against
+        if (res != Z_STREAM_END || stream.avail_out != 0) {
+            qCWarning(Log) << "Failed to decompress" << entry.name << res << stream.avail_out;
+            data.clear();
+            return LoadOptions::InvalidArchive;
+        }
+        break;
+    }
+    default:
+        qCWarning(Log) << "Unsupported compression method" << entry.compressionMethod << entry.name;
+        return LoadOptions::InvalidArchive;
+    }
+
+    if (!ZipDirectory::verifyChecksum(entry, data)) {
+        qCWarning(Log) << "Checksum mismatch for" << entry.name;
+        data.clear();
+        return LoadOptions::InvalidArchive;
+    }
+    return LoadOptions::NoError;
+}